@@ -0,0 +1,624 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// Mat.hpp
+//
+// Overview:
+//  Fixed size matrix.  The dimensions and element type are template
+//  parameters, the element type defaulting to double.  The elements are
+//  stored in the object, so temporaries live on the stack and never touch
+//  the heap.  The interface follows
+//  Matrix: element access by (idx), (row,col) and [row][col], scalar
+//  assignment, + - * with matrices and scalars, Transpose(), Inv() and
+//  Chol_LLt(), with CholSolve() to solve against a Cholesky factor.
+//  Dimension mismatches are compile errors rather than DIMERR exceptions,
+//  and element access is not range checked.
+//
+//  Constructors:
+//    Mat<3,3> mat;
+//    Mat<3,3> mat(1.0);
+//    Mat<3,3,float> mat;
+//  The first form creates a 3x3 matrix initialized to zero.
+//  The second form overides the default initialization to zero.
+//  The third form creates a single precision matrix.
+//
+//  Products are summed in the same order as Matrix, so results are bit for
+//  bit the same as the heap matrix.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAT_HPP
+#define MAT_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+#include "Matrix.hpp"
+
+namespace MAT_KERNEL
+{
+
+//
+// One element of a matrix product, a row of lhs times a column of rhs.  The
+// dot product is expanded at compile time into a straight line sum with no
+// loop.
+//
+template <int RHS_COLS, class T, std::size_t... kk>
+inline T RowCol(const T *pLhsRow,
+                const T *pRhsCol,
+                std::index_sequence<kk...>)
+{
+  T sum(0.0);
+
+  ((sum += pLhsRow[kk] * pRhsCol[kk * RHS_COLS]), ...);
+
+  return sum;
+}
+
+} // end namespace MAT_KERNEL
+
+
+template <int R, int C, class T = double>
+class Mat
+{
+
+public:
+
+  //
+  // Default constructor
+  //
+  Mat()
+  {
+    Set(0.0);
+  }
+
+  explicit Mat(T initVal)
+  {
+    Set(initVal);
+  }
+
+  void Print(const char *pFormat) const
+  {
+    for (int row = 0; row < R; ++row)
+    {
+      for (int col = 0; col < C; ++col)
+      {
+        printf(pFormat, data[row * C + col]);
+      }
+      printf("\n");
+    }
+  }
+
+  void Set(T val)
+  {
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      data[idx] = val;
+    }
+  }
+
+  int NumRows() const
+  {
+    return R;
+  }
+
+  int NumCols() const
+  {
+    return C;
+  }
+
+  T *GetPtr(int idx)
+  {
+    return data + idx;
+  }
+
+  //
+  // Element access.  (idx) indexes the elements in row major order.
+  //
+  T & operator()(int idx)
+  {
+    return data[idx];
+  }
+
+  T operator()(int idx) const
+  {
+    return data[idx];
+  }
+
+  T & operator()(int row, int col)
+  {
+    return data[row * C + col];
+  }
+
+  T operator()(int row, int col) const
+  {
+    return data[row * C + col];
+  }
+
+  T * operator[](int row)
+  {
+    return data + row * C;
+  }
+
+  const T * operator[](int row) const
+  {
+    return data + row * C;
+  }
+
+  Mat & operator= (T scalar)
+  {
+    Set(scalar);
+
+    return *this;
+  }
+
+  Mat operator+ (const Mat &rhs) const
+  {
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] + rhs.data[idx];
+    }
+    return result;
+  }
+
+  Mat operator- (const Mat &rhs) const
+  {
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] - rhs.data[idx];
+    }
+    return result;
+  }
+
+  //
+  // Binary matrix multiplication
+  //
+  template <int RHS_COLS>
+  Mat<R, RHS_COLS, T> operator* (const Mat<C, RHS_COLS, T> &rhs) const
+  {
+    Mat<R, RHS_COLS, T> result;
+
+    T       *pResElem(result.GetPtr(0));
+    const T *pRhsData(rhs[0]);
+
+    for (int lhsRow = 0; lhsRow < R; ++lhsRow)
+    {
+      for (int rhsCol = 0; rhsCol < RHS_COLS; ++rhsCol)
+      {
+        *pResElem++ = MAT_KERNEL::RowCol<RHS_COLS>(data + lhsRow * C,
+                                                   pRhsData + rhsCol,
+                                                   std::make_index_sequence<C>());
+      }
+    }
+    return result;
+  }
+
+  Mat operator+ (T rhs) const
+  {
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] + rhs;
+    }
+    return result;
+  }
+
+  Mat operator- (T rhs) const
+  {
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] - rhs;
+    }
+    return result;
+  }
+
+  Mat operator* (T rhs) const
+  {
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] * rhs;
+    }
+    return result;
+  }
+
+  Mat operator/ (T rhs) const
+  {
+    if (rhs == 0.0)
+    {
+      throw(Matrix::DIVBYZERO());
+    }
+
+    Mat result;
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      result.data[idx] = data[idx] / rhs;
+    }
+    return result;
+  }
+
+  void operator+= (const Mat &rhs)
+  {
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      data[idx] += rhs.data[idx];
+    }
+  }
+
+  void operator-= (const Mat &rhs)
+  {
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      data[idx] -= rhs.data[idx];
+    }
+  }
+
+  void operator*= (T rhs)
+  {
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      data[idx] *= rhs;
+    }
+  }
+
+  void operator/= (T rhs)
+  {
+    if (rhs == 0.0)
+    {
+      throw(Matrix::DIVBYZERO());
+    }
+
+    for (int idx = 0; idx < R * C; ++idx)
+    {
+      data[idx] /= rhs;
+    }
+  }
+
+  Mat<C, R, T> Transpose() const
+  {
+    Mat<C, R, T> result;
+
+    for (int row = 0; row < R; ++row)
+    {
+      for (int col = 0; col < C; ++col)
+      {
+        result[col][row] = data[row * C + col];
+      }
+    }
+    return result;
+  }
+
+  void Eye()
+  {
+    static_assert(R == C, "Eye() needs a square matrix");
+
+    for (int idx = 0; idx < R; ++idx)
+    {
+      data[idx * C + idx] = 1.0;
+    }
+  }
+
+  Mat Inv() const;
+
+  Mat Chol_LLt(bool &posDef) const;
+
+  template <int RHS_COLS>
+  Mat<R, RHS_COLS, T> CholSolve(const Mat<R, RHS_COLS, T> &rhs) const;
+
+private:
+
+  T data[R * C];
+
+};  // end class Mat
+
+//
+//  Return the inverse of the matrix.  Gaussian elimination with scaled
+//  pivoting, step for step the algorithm of Matrix::Inv().  The bookkeeping
+//  arrays are on the stack.
+//
+//  ref:  Cheney, W. and Kincaid, D. "Numerical Mathemeatics and Computing,
+//        4th ed.", Brooks/Cole Publishing Co., pp 240-293
+//
+template <int R, int C, class T>
+Mat<R, C, T> Mat<R, C, T>::Inv() const
+{
+  static_assert(R == C, "Inv() needs a square matrix");
+
+  using std::abs;
+
+  int    col(0);
+  T      factor(0.0);
+  int    identElem(0);
+  int    pivotRow(0);
+  int    pivotRowTrial(0);
+  T      rhs[R];
+  T      rowMaxes[R];
+  int    rowOrder[R];
+  T      ratio(0.0);
+  T      ratioMax(0.0);
+  int    row(0);
+  T      rowMax(0.0);
+  T      sum(0.0);
+  int    temp(0);
+  Mat    result;
+  int    rowIdx;
+  int    rowRatioMax(0);
+  int    scaleRow;
+  int    zeroColIdx(0);
+
+  Mat upTriang(*this);
+
+  //
+  // Find the largest coefficient in each row.
+  //
+  for (row = 0; row < R; ++row)
+  {
+    rowOrder[row] = row;
+
+    rowMax = 0.0;
+    for (col = 0; col < C; ++col)
+    {
+      if (rowMax < abs(upTriang[row][col]))
+      {
+        rowMax = abs(upTriang[row][col]);
+      }
+    }
+    rowMaxes[row] = rowMax;
+  }
+
+  //
+  // Forward elimination, selecting the pivot row with the largest scale
+  // ratio for each column.
+  //
+  for (zeroColIdx = 0; zeroColIdx < C - 1; ++zeroColIdx)
+  {
+    ratioMax = 0.0;
+
+    for (rowIdx = zeroColIdx; rowIdx < R; ++rowIdx)
+    {
+      pivotRowTrial = rowOrder[rowIdx];
+
+      if (rowMaxes[pivotRowTrial] == 0.0)
+      {
+        throw(Matrix::SINGERR());
+      }
+
+      ratio = abs(upTriang[pivotRowTrial][zeroColIdx] /
+                                                  rowMaxes[pivotRowTrial]);
+
+      if (ratio > ratioMax)
+      {
+        ratioMax = ratio;
+
+        rowRatioMax = rowIdx;
+      }
+    }
+
+    temp = rowOrder[zeroColIdx];
+    rowOrder[zeroColIdx] = rowOrder[rowRatioMax];
+    rowOrder[rowRatioMax] = temp;
+
+    pivotRow = rowOrder[zeroColIdx];
+
+    for (rowIdx = zeroColIdx + 1; rowIdx < R; ++rowIdx)
+    {
+      scaleRow = rowOrder[rowIdx];
+
+      if (upTriang[pivotRow][zeroColIdx] == 0.0)
+      {
+        throw(Matrix::SINGERR());
+      }
+      factor = upTriang[scaleRow][zeroColIdx] / upTriang[pivotRow][zeroColIdx];
+
+      upTriang[scaleRow][zeroColIdx] = factor;
+
+      for (col = zeroColIdx + 1; col < C; ++col)
+      {
+        upTriang[scaleRow][col] -= factor * upTriang[pivotRow][col];
+      }
+    }
+  }
+
+  //
+  // Solve for each column of the inverse against the matching column of the
+  // identity matrix.
+  //
+  for (identElem = 0; identElem < R; ++identElem)
+  {
+    for (row = 0; row < R; ++row)
+    {
+      rhs[row] = 0.0;
+    }
+    rhs[identElem] = 1.0;
+
+    for (zeroColIdx = 0; zeroColIdx < R - 1; ++zeroColIdx)
+    {
+      pivotRow = rowOrder[zeroColIdx];
+
+      for (rowIdx = zeroColIdx + 1; rowIdx < R; ++rowIdx)
+      {
+        row = rowOrder[rowIdx];
+
+        factor = upTriang[row][zeroColIdx];
+
+        rhs[row] -= factor * rhs[pivotRow];
+      }
+    }
+
+    //
+    // Back substitution starting a the bottom of the triangular matrix.
+    //
+    row = rowOrder[R - 1];
+
+    if (upTriang[row][R - 1] == 0.0)
+    {
+      throw(Matrix::SINGERR());
+    }
+
+    result[R - 1][identElem] = rhs[row] / upTriang[row][R - 1];
+
+    for (rowIdx = R - 2; rowIdx >= 0; --rowIdx)
+    {
+      row = rowOrder[rowIdx];
+      sum = rhs[row];
+
+      for (col = rowIdx + 1; col < C; ++col)
+      {
+        sum = sum - upTriang[row][col] * result[col][identElem];
+      }
+
+      if (upTriang[row][rowIdx] == 0.0)
+      {
+        throw(Matrix::SINGERR());
+      }
+      result[rowIdx][identElem] = sum / upTriang[row][rowIdx];
+    }
+  }
+
+  return result;
+}
+
+//
+//  Cholesky square root factorization.  Returns the lower triangular matrix
+//  L such that A = L * L'.  Only the diagonal and lower triangle of A are
+//  read, so a covariance that is symmetric only to rounding is factored as
+//  if it were exactly symmetric.  posDef is false, and the result zero, if
+//  a pivot is not positive.
+//
+//  Same recurrence as Matrix::Chol_LLt(), with the elements on the stack.
+//
+template <int R, int C, class T>
+Mat<R, C, T> Mat<R, C, T>::Chol_LLt(bool &posDef) const
+{
+  static_assert(R == C, "Chol_LLt() needs a square matrix");
+
+  using std::sqrt;
+
+  int    col;
+  int    idx;
+  Mat    lower;
+  int    row;
+  T      sum;
+
+  posDef = true;
+
+  for (row = 0; row < R; ++row)
+  {
+    for (col = 0; col <= row; ++col)
+    {
+      sum = data[row * C + col];
+      for (idx = 0; idx < col; ++idx)
+      {
+        sum -= lower[row][idx] * lower[col][idx];
+      }
+
+      if (row == col)
+      {
+        //
+        // Written so a NaN also fails the test.
+        //
+        if (!(sum > 0.0))
+        {
+          posDef = false;
+          lower = 0.0;
+          return lower;
+        }
+        lower[row][col] = sqrt(sum);
+      }
+      else
+      {
+        lower[row][col] = sum / lower[col][col];
+      }
+    }
+  }
+
+  return lower;
+}
+
+//
+//  Solve A * X = B for X, where this matrix is the Cholesky factor L of A
+//  returned by Chol_LLt().  Forward substitution through L then back
+//  substitution through L', one column of B at a time.  No inverse is
+//  formed.
+//
+template <int R, int C, class T>
+template <int RHS_COLS>
+Mat<R, RHS_COLS, T> Mat<R, C, T>::CholSolve(const Mat<R, RHS_COLS, T> &rhs) const
+{
+  static_assert(R == C, "CholSolve() needs a square factor");
+
+  int                 col;
+  int                 idx;
+  Mat<R, RHS_COLS, T> result;
+  int                 row;
+  T                   sum;
+
+  for (col = 0; col < RHS_COLS; ++col)
+  {
+    //
+    // L * y = b
+    //
+    for (row = 0; row < R; ++row)
+    {
+      sum = rhs[row][col];
+      for (idx = 0; idx < row; ++idx)
+      {
+        sum -= data[row * C + idx] * result[idx][col];
+      }
+      result[row][col] = sum / data[row * C + row];
+    }
+
+    //
+    // L' * x = y
+    //
+    for (row = R - 1; row >= 0; --row)
+    {
+      sum = result[row][col];
+      for (idx = row + 1; idx < R; ++idx)
+      {
+        sum -= data[idx * C + row] * result[idx][col];
+      }
+      result[row][col] = sum / data[row * C + row];
+    }
+  }
+
+  return result;
+}
+
+namespace MATRIX
+{
+
+template <int R, int C, class T>
+inline Mat<R, C, T> operator* (T lhs, const Mat<R, C, T> &rhs)
+{
+  return rhs * lhs;
+}
+
+template <int R, int C, class T>
+inline Mat<C, R, T> Transpose(const Mat<R, C, T> &arg)
+{
+  return arg.Transpose();
+}
+
+template <int R, int C, class T>
+inline Mat<R, C, T> Invert(const Mat<R, C, T> &MM)
+{
+  return MM.Inv();
+}
+
+} // end namespace MATRIX
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
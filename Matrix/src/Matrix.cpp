@@ -5,7 +5,8 @@
 //
 // Overview:
 //  Double precision matrix class.  Unaray and binary arithemtic, inverse,
-//  transpose, determinate, Cholesky square root are supported.
+//  transpose, determinate, LU factorization and linear solve, Cholesky square
+//  root are supported.
 //  Constructors:
 //    Matrix mat;
 //    Matrix mat(3,3);
@@ -24,6 +25,8 @@
 #include <iomanip>
 #include <exception>
 #include <string>
+#include <utility>
+#include <vector>
 using std::string;
 
 
@@ -62,7 +65,23 @@ Matrix::Matrix(const Matrix &mat)
 }
 
 //
-// Create a new Matrix and initialize all elements.
+// Move constructor
+//
+Matrix::Matrix(Matrix &&mat) noexcept
+  : cols(mat.cols),
+    nElem(mat.nElem),
+    rows(mat.rows),
+    pData(mat.pData)
+{
+  mat.cols = 0;
+  mat.nElem = 0;
+  mat.rows = 0;
+  mat.pData = NULL;
+}
+
+//
+// Create a new Matrix and initialize all elements.  Construct() allocates a
+// new buffer, so any buffer already held must be released first.
 //
 void Matrix::Construct(int    _rows,
                        int    _cols,
@@ -100,13 +119,24 @@ void Matrix::Construct(int _rows,
   }
 }
 
+//
+// Free the element buffer.
+//
+void Matrix::Release()
+{
+  if (pData != NULL)
+  {
+    delete [] pData;
+    pData = NULL;
+  }
+}
+
 //
 // Destructor
 //
 Matrix::~Matrix()
 {
-  delete[] pData;
-  pData = NULL;
+  Release();
 }
 
 //
@@ -114,16 +144,20 @@ Matrix::~Matrix()
 //
 void Matrix::Resize(int _rows, int _cols, double initVal)
 {
-  if (pData != NULL)
+  //
+  // Reuse the buffer when the element count is unchanged.
+  //
+  if ((pData != NULL) &&
+      (_rows * _cols == nElem))
   {
-    delete [] pData;
+    rows = _rows;
+    cols = _cols;
+    Set(initVal);
   }
-
-  rows = _rows;
-  cols = _cols;
-  nElem = _rows * _cols;
+  else
   {
-    Construct(rows, cols, initVal);
+    Release();
+    Construct(_rows, _cols, initVal);
   }
 }
 
@@ -138,10 +172,21 @@ void Matrix::Set(double val)
   }
 }
 
+//
+// Exchange contents with mat.  No elements are copied.
+//
+void Matrix::Swap(Matrix &mat) noexcept
+{
+  std::swap(cols, mat.cols);
+  std::swap(nElem, mat.nElem);
+  std::swap(rows, mat.rows);
+  std::swap(pData, mat.pData);
+}
+
 //
 // Check that the row and col indices are in bounds of the Matrix
 //
-bool Matrix::CheckDim(int row, int col)
+bool Matrix::CheckDim(int row, int col) const
 {
   bool pass(false);
 
@@ -160,7 +205,7 @@ bool Matrix::CheckDim(int row, int col)
 // Check that the vector index is in bounds and the Matrix is a 1d vector,
 // either row or column.
 //
-bool Matrix::CheckDim(int idx)
+bool Matrix::CheckDim(int idx) const
 {
   bool pass(false);
 
@@ -361,91 +406,98 @@ double* Matrix::operator[](int row)
 }
 
 //
-// Assignment operator
+// Operator to read an element of a 1d matrix
 //
-//Matrix& Matrix::operator= (const Matrix& mat)  // Didn't work
-//Matrix& Matrix::operator= (Matrix& mat)        // Didn't work
-Matrix Matrix::operator= (Matrix mat)
+double Matrix::operator()(int idx) const
 {
-  double *ptr1 = mat.pData;
-  double *ptr2(NULL);
-  int    _rows = mat.NumRows();
-  int    _cols = mat.NumCols();
-
-  Construct(_rows, _cols);
-  ptr2 = pData;
-
-  for (int idx = 0; idx < nElem; ++idx)
+  if (!CheckDim(idx))
   {
-    *ptr2++ = *ptr1++;
+    throw(DIMERR());
   }
-  return *this;
+
+  return pData[idx];
 }
 
 //
-// Scalar ssignment operator                        // Didn't work
+// Operator to read an element of a 2d matrix
 //
-// Matrix Matrix::operator= (const double scalar)
-// {
-//   Matrix result(rows, cols, scalar);
-//
-//   return result;
-// }
+double Matrix::operator()(int row, int col) const
+{
+  if (!CheckDim(row, col))
+  {
+    throw(DIMERR());
+  }
+
+  return pData[row * cols + col];
+}
 
 //
-// Scalar assignment operator
+// Operator to read a row of a const matrix
 //
-Matrix Matrix::operator= (double scalar)
+const double* Matrix::operator[](int row) const
 {
-  Construct(rows, cols, scalar);
+  if ((row < 0) || (row > rows - 1))
+  {
+    throw(DIMERR());
+  }
 
-  return *this;
+  return pData + row * cols;
 }
 
 //
-// Binary addition
+// Copy assignment operator.  The elements are copied in place when the
+// dimensions match, otherwise a copy is made and swapped in so the matrix
+// is unchanged if the allocation throws.
 //
-Matrix Matrix::operator+ (const Matrix rhs) const
+Matrix& Matrix::operator= (const Matrix &mat)
 {
-  if ((rows != rhs.rows) ||
-      (cols != rhs.cols))
+  if (this == &mat)
   {
-    throw(DIMERR()); 
+    return *this;
   }
 
-  Matrix result(rows, cols);
-
-  for (int idx = 0; idx < nElem; ++idx)
+  if ((pData != NULL) &&
+      (rows == mat.rows) &&
+      (cols == mat.cols))
   {
-    result.pData[idx] = pData[idx] + rhs.pData[idx];
+    for (int idx = 0; idx < nElem; ++idx)
+    {
+      pData[idx] = mat.pData[idx];
+    }
   }
-  return result;
+  else
+  {
+    Matrix temp(mat);
+
+    Swap(temp);
+  }
+  return *this;
 }
 
 //
-// Binary subtraction
+// Move assignment operator.  The old buffer goes out with mat.
 //
-Matrix Matrix::operator- (const Matrix rhs) const
+Matrix& Matrix::operator= (Matrix &&mat) noexcept
 {
-  if ((rows != rhs.rows) ||
-      (cols != rhs.cols))
-  {
-    throw(DIMERR()); 
-  }
+  Swap(mat);
 
-  Matrix result(rows, cols);
+  return *this;
+}
 
-  for (int idx = 0; idx < nElem; ++idx)
-  {
-    result.pData[idx] = pData[idx] - rhs.pData[idx];
-  }
-  return result;
+//
+// Scalar assignment operator
+//
+Matrix& Matrix::operator= (double scalar)
+{
+  Set(scalar);
+
+  return *this;
 }
 
 //
 // Binary element X element division
 //
-Matrix Matrix::operator/ (const Matrix rhs) const
+Matrix Matrix::operator/ (const Matrix &rhs) const
 {
   if ((rows != rhs.rows) ||
       (cols != rhs.cols))
@@ -467,39 +519,6 @@ Matrix Matrix::operator/ (const Matrix rhs) const
   return result;
 }
 
-//
-// Binary matrix multiplication
-//
-Matrix Matrix::operator* (const Matrix rhs) const
-{
-  if (cols != rhs.rows)
-  {
-    throw(DIMERR()); 
-  }
-
-  Matrix result(rows, rhs.cols);
-
-  double *pResElem(result.pData);
-  double *pRhsCol(rhs.pData);
-  double *pLhsRow(pData);
-
-  for (int lhsRow = 0; lhsRow < rows; ++lhsRow)
-  {
-    for (int rhsCol = 0; rhsCol < rhs.cols; ++rhsCol)
-    {
-      pLhsRow = pData + lhsRow * cols;
-      pRhsCol = rhs.pData + rhsCol;
-      for (int resIdx = 0; resIdx < cols; ++resIdx)
-      {
-        *pResElem += *pLhsRow++ * *pRhsCol;
-        pRhsCol += rhs.cols; 
-      }
-      ++pResElem;
-    }
-  }
-  return result;
-}
-
 //
 // Binary matrix addition by a rhs scalar
 //
@@ -581,7 +600,7 @@ Matrix Matrix::operator/ (const double rhs) const
 //
 // Incremental binary matrix addition
 //
-void Matrix::operator+= (const Matrix rhs)
+void Matrix::operator+= (const Matrix &rhs)
 {
   if ((rows != rhs.rows) ||
       (cols != rhs.cols))
@@ -601,7 +620,7 @@ void Matrix::operator+= (const Matrix rhs)
 //
 // Incremental binary matrix subtraction
 //
-void Matrix::operator-= (const Matrix rhs)
+void Matrix::operator-= (const Matrix &rhs)
 {
   if ((rows != rhs.rows) ||
       (cols != rhs.cols))
@@ -621,7 +640,7 @@ void Matrix::operator-= (const Matrix rhs)
 //
 // Incremental binary matrix element X emelment multiplication
 //
-void Matrix::operator*= (const Matrix rhs)
+void Matrix::operator*= (const Matrix &rhs)
 {
   if ((rows != rhs.rows) ||
       (cols != rhs.cols))
@@ -645,7 +664,7 @@ void Matrix::operator*= (const Matrix rhs)
 //
 // Incremental binary matrix element X emelment division
 //
-void Matrix::operator/= (const Matrix rhs)
+void Matrix::operator/= (const Matrix &rhs)
 {
   if ((rows != rhs.rows) ||
       (cols != rhs.cols))
@@ -724,14 +743,33 @@ void Matrix::operator/= (const double rhs)
 }
 
 //
-//  Return the inverse of the matrix.  Uses Gaussian elimination with 
-//  scaled pivoting.  More robust than simple Gaussian elimination or LU
-//  decomposition.
+//  LU factorization using Gaussian elimination with scaled pivoting.  More
+//  robust than simple Gaussian elimination or LU decomposition without
+//  pivoting.  The factorization is shared by Inv(), Solve(), Det() and
+//  IsPosDef().
+//
+//  On return lu holds the upper triangular factor U in the pivot rows and the
+//  multipliers of the unit lower triangular factor L below the diagonal.  Rows
+//  are not interchanged in lu; rowOrder lists the pivot row used for each
+//  column, so row rowOrder[k] of lu is row k of the factors:
+//
+//    P * A = L * U
+//
+//  sign is the sign of the permutation P, +1.0 or -1.0.
+//
+//  With pivot false the rows are eliminated in their natural order, which
+//  is the factorization used to test the leading principal minors.
+//
+//  Returns false if the matrix is singular, in which case lu is incomplete.
+//  The check is for exact zeros only, as Inv() has always done.
 //
 //  ref:  Cheney, W. and Kincaid, D. "Numerical Mathemeatics and Computing,
 //        4th ed.", Brooks/Cole Publishing Co., pp 240-293
 //
-Matrix Matrix::Inv()
+bool Matrix::LuFactor(Matrix           &lu,
+                      std::vector<int> &rowOrder,
+                      double           &sign,
+                      bool             pivot) const
 {
   //
   // Check to make sure the matrix is square.
@@ -743,34 +781,24 @@ Matrix Matrix::Inv()
 
   int    col(0);
   double factor(0.0);        // xmult
-  int    identElem(0);       //
   int    pivotRow(0);        // lSubk
   int    pivotRowTrial(0);   //
-  double *pRhs(NULL);        //
-  double *pRowMaxes(NULL);   // sSubi
-  int    *pRowOrder(NULL);   // l
   double ratio(0.0);         // r
   double ratioMax(0.0);      // rmax
   int    row(0);             // i1
   double rowMax(0.0);        //
-  double sum(0.0);           //
   int    temp(0);            //
-  Matrix result(rows, cols); //
   int    rowIdx;             //
-  int    rowRatioMax;        // 
-  int    rowMaxIdx;          //
+  int    rowRatioMax;        // j
   int    scaleRow;           // lSubi
   int    zeroColIdx(0);      // k
 
-  #ifdef debugEn
-  FILE*fp = fopen("Debug.txt", "w");
-  #endif
   //
   // Forward elimination with scaled pivoting.  This algorithm calculates an
-  // upper triangular matrix of coefficients called upTriang.  The resulting
+  // upper triangular matrix of coefficients called U.  The resulting
   // system is:
   //
-  //   upTriang * x = b'
+  //   U * x = b'
   //
   // The upper triangular system is easily solved for x by back substitution,
   // starting at the last row.
@@ -780,11 +808,6 @@ Matrix Matrix::Inv()
   //
   //   Ax = b
   //
-  // Later, sucessive columns of the identity matrix will be substituted for
-  // b, resulting in successive columns of the inv(A) matrix.
-  //
-  //   A*inv(A) = I
-  //
   // Gaussian elimination takes one equation of a system of linear equations
   // as a pivot row.  For each of the remaining rows a scaled version of the 
   // pivot row is subtracted, such that one element of the selected row is 
@@ -801,18 +824,19 @@ Matrix Matrix::Inv()
   // The order in which the pivot rows are selected is stored in the rowOrder
   // vector.
   //
-  pRowOrder = new int[rows];
+  rowOrder.resize(rows);
 
   //
-  // The abs(maximum) of each row is stored in pRowMaxws vector.
+  // The abs(maximum) of each row is stored in rowMaxes vector.
   //
-  pRowMaxes = new double[rows];
+  std::vector<double> rowMaxes(rows);
 
   //
-  // Create a copy of the matrix.  The algorithm will convert the new matrix
-  // into upper triangular form as it proceeds.
+  // Start from a copy of the matrix.  The algorithm will convert it into
+  // upper triangular form as it proceeds.
   //
-  Matrix upTriang(*this);
+  lu = *this;
+  sign = 1.0;
 
   //
   // Find the largest coefficient in each row.
@@ -823,22 +847,23 @@ Matrix Matrix::Inv()
     // Initialize the pivot row order as the initial matrix row order.  This
     // order will be modified as the algorithm progresses.
     //
-    pRowOrder[row] = row;
+    rowOrder[row] = row;
 
     rowMax = 0.0;
     for (col = 0; col < cols; ++col)
     {
-      rowMax = Max(rowMax, fabs(upTriang[row][col]));
+      rowMax = Max(rowMax, fabs(lu[row][col]));
     }
-    pRowMaxes[row] = rowMax;
-  }
 
-  #ifdef debugEn
-  fprintf(fp, "p05 pRowMaxes = %7.2f %7.2f %7.2f %7.2f \n", 
-               pRowMaxes[0], pRowMaxes[1], pRowMaxes[2], pRowMaxes[3]);
-  fprintf(fp, "pRowOrder = %d %d %d %d \n", pRowOrder[0], pRowOrder[1],
-                                    pRowOrder[2], pRowOrder[3]);
-  #endif
+    //
+    // A row of zeros can not be a pivot row.
+    //
+    if (rowMax == 0.0)
+    {
+      return false;
+    }
+    rowMaxes[row] = rowMax;
+  }
 
   //
   // Step through the system along the diagonal, selecting the appropriate pivot
@@ -846,35 +871,22 @@ Matrix Matrix::Inv()
   //
   for (zeroColIdx = 0; zeroColIdx < cols - 1; ++zeroColIdx)
   {
-    #ifdef debugEn
-    fprintf(fp, "p10 zeroColIdx (k) = %d \n", zeroColIdx);
-    #endif
-
     //
     // Find the row with the largest scale ratio for each column.  This will be
     // the pivot row for that column.
     //
     ratioMax = 0.0;
+    rowRatioMax = zeroColIdx;
 
-    for (rowIdx = zeroColIdx; rowIdx < rows; ++rowIdx)
+    for (rowIdx = zeroColIdx; pivot && (rowIdx < rows); ++rowIdx)
     {
       //
       // See if the next row should be the pivot row for this pivot index by
       // selecting the highest scale ratio.
       //
-      pivotRowTrial = pRowOrder[rowIdx];
+      pivotRowTrial = rowOrder[rowIdx];
 
-      //
-      // The denomiator in the ratio calculation below should never be zero
-      // since it was chosen to be the max relative to the row.
-      //
-      if (pRowMaxes[pivotRowTrial] == 0.0)
-      {
-        throw(SINGERR());
-      }
-
-      ratio = fabs(upTriang[pivotRowTrial][zeroColIdx] / 
-                                                  pRowMaxes[pivotRowTrial]);
+      ratio = fabs(lu[pivotRowTrial][zeroColIdx] / rowMaxes[pivotRowTrial]);
 
       if (ratio > ratioMax)
       {
@@ -884,56 +896,41 @@ Matrix Matrix::Inv()
       }
     } // end for (rowIdx = zeroColIdx; rowIdx < rows; ++rowIdx)
 
-    #ifdef debugEn
-    fprintf(fp, "p20 ratioMax = %7.2f \n", ratioMax);
-    fprintf(fp, "p30 rowRatioMax (j) = %d \n", rowRatioMax); 
-    #endif
-
     //
     // Sort the pivot row list by interchanging the newly found pivot row with
     // the current row pointed to by the pivot index.
     //
-    temp = pRowOrder[zeroColIdx];
-    pRowOrder[zeroColIdx] = pRowOrder[rowRatioMax];
-    pRowOrder[rowRatioMax] = temp;
-    
-    #ifdef debugEn
-    fprintf(fp, "p40: lSubj <--> lSubk \n");
-    fprintf(fp, "p50: pRowOrder = %d %d %d %d \n", pRowOrder[0], pRowOrder[1],
-                                    pRowOrder[2], pRowOrder[3]);
-    #endif
+    if (rowRatioMax != zeroColIdx)
+    {
+      temp = rowOrder[zeroColIdx];
+      rowOrder[zeroColIdx] = rowOrder[rowRatioMax];
+      rowOrder[rowRatioMax] = temp;
 
-    pivotRow = pRowOrder[zeroColIdx];
-    
-    #ifdef debugEn
-    fprintf(fp, "p30 pivotRow (j) = %d \n", pivotRow); 
-    #endif
+      sign = -sign;
+    }
+
+    pivotRow = rowOrder[zeroColIdx];
+
+    //
+    // A zero pivot means every candidate in this column is zero.
+    //
+    if (lu[pivotRow][zeroColIdx] == 0.0)
+    {
+      return false;
+    }
 
     for (rowIdx = zeroColIdx + 1; rowIdx < rows; ++rowIdx)
     {
-      scaleRow = pRowOrder[rowIdx];
-      
-      #ifdef debugEn
-      fprintf(fp, "p70 scaleRow = row being scaled %d \n", scaleRow);
-      #endif
-  
-      //
-      // The denomenator in the factor calculation should never be zero since it
-      // was chosen to be the max relative to the row max.
-      //
-      if (upTriang[pivotRow][zeroColIdx] == 0.0)
-      {
-        throw(SINGERR());
-      }
-      factor = upTriang[scaleRow][zeroColIdx] / upTriang[pivotRow][zeroColIdx];
+      scaleRow = rowOrder[rowIdx];
+
+      factor = lu[scaleRow][zeroColIdx] / lu[pivotRow][zeroColIdx];
     
       //
-      // Store the scaling factor in the upper triangular matrix for use later.
+      // Store the scaling factor in the lower part of lu for use later.
       // This makes the book keeping easy since it can be accessed using the 
-      // row and zeroColIdx indeces.  Of course the matrix is no linger strictly 
-      // upper traingular.
+      // row and zeroColIdx indeces.
       //
-      upTriang[scaleRow][zeroColIdx] = factor;
+      lu[scaleRow][zeroColIdx] = factor;
     
       //
       // Zero the elements in the pivot column in the remaining rows to create
@@ -941,47 +938,98 @@ Matrix Matrix::Inv()
       //
       for (col = zeroColIdx + 1; col < cols; ++col)
       {
-        upTriang[scaleRow][col] -= factor * upTriang[pivotRow][col];
-    
+        lu[scaleRow][col] -= factor * lu[pivotRow][col];
       }
-
-      #ifdef debugEn
-      fprintf(fp, "p80 row = %d; factor = %7.2f;", scaleRow, factor);
-      fprintf(fp, " upTriang(%d,:) = %7.2f %7.2f %7.2f %7.2f \n", row,
-                  upTriang[scaleRow][0], upTriang[scaleRow][1], 
-                  upTriang[scaleRow][2], upTriang[scaleRow][3]);
-      #endif
-    
     } // end for (rowIdx = zeroColIdx + 1; rowIdx < rows; ++rowIdx)
   }  // for (zeroColIdx = 0; zeroColIdx < cols - 1; ++zeroColIdx)
 
-  #ifdef debugEn
-  fprintf(fp, "p90 upTriang = \n");
-  for (int dbRow = 0; dbRow < 4; ++dbRow)
+  //
+  // The last pivot is not checked by the elimination.
+  //
+  if (lu[rowOrder[rows - 1]][rows - 1] == 0.0)
   {
-    for (int dbCol = 0; dbCol < 4; ++dbCol)
-    {
-      fprintf(fp, "%7.2f ", upTriang[dbRow][dbCol]); 
-    }
-    fprintf(fp, "\n");
+    return false;
   }
-  #endif
+
+  return true;
+}
+
+//
+//  Solve one column of the system, given the factorization from LuFactor().
+//  rhs holds b in the original row order and is overwritten.  The solution x
+//  is written to column resultCol of result.
+//
+void Matrix::LuSubst(const Matrix           &lu,
+                     const std::vector<int> &rowOrder,
+                     std::vector<double>    &rhs,
+                     Matrix                 &result,
+                     int                    resultCol)
+{
+  int    col(0);
+  int    n(lu.rows);
+  int    pivotRow(0);
+  int    row(0);
+  int    rowIdx(0);
+  double sum(0.0);
+  int    zeroColIdx(0);
 
   //
-  // We now have an upper triangular representation of A in 
-  //  A * X = b
-  // But we have not operated on b.  Furthermore, what we want is inv(A) as in
-  //  A * inv(A) = I
-  // We'll brek this problem up into columns of inv(A) and I
-  //  A * inv(A)(i) = I(i)
-  // So we need to apply forward elimination processing to the columns of I.
-  // Then proceed to back substitution
+  // Apply the same scaling used on the left hand side of the system
+  // to the right hand side.
   //
-  // The modified right hand side system of equations is stored in pRhs.
+  for (zeroColIdx = 0; zeroColIdx < n - 1; ++zeroColIdx)
+  {
+    pivotRow = rowOrder[zeroColIdx];
+    
+    for (rowIdx = zeroColIdx + 1; rowIdx < n; ++rowIdx)
+    {
+      row = rowOrder[rowIdx];
+
+      rhs[row] -= lu[row][zeroColIdx] * rhs[pivotRow];
+    }
+  }
+
   //
-  //   A * X = b (rhs)
+  // Back substitution starting a the bottome of the triangular matrix.
   //
-  pRhs = new double[rows];
+  row = rowOrder[n - 1];
+
+  result[n - 1][resultCol] = rhs[row] / lu[row][n - 1];
+
+  for (rowIdx = n - 2; rowIdx >= 0; --rowIdx)
+  {
+    row = rowOrder[rowIdx];
+    sum = rhs[row];
+    
+    for (col = rowIdx + 1; col < n; ++col)
+    {
+      sum = sum - lu[row][col] * result[col][resultCol];
+    }
+   
+    result[rowIdx][resultCol] = sum / lu[row][rowIdx];
+  }
+}
+
+//
+//  Return the inverse of the matrix.  The matrix is factored once by
+//  LuFactor(), then sucessive columns of the identity matrix are substituted
+//  for b, resulting in successive columns of the inv(A) matrix.
+//
+//    A * inv(A)(i) = I(i)
+//
+Matrix Matrix::Inv() const
+{
+  int                 identElem(0);
+  Matrix              lu(rows, cols);
+  Matrix              result(rows, cols);
+  std::vector<double> rhs(rows);
+  std::vector<int>    rowOrder;
+  double              sign(1.0);
+
+  if (!LuFactor(lu, rowOrder, sign))
+  {
+    throw(SINGERR());
+  }
 
   for (identElem = 0; identElem < rows; ++identElem)
   {
@@ -989,75 +1037,59 @@ Matrix Matrix::Inv()
     // Extract the appropriate column of the identify matrix for use as 
     // the right hand side of the system of equations.
     //
-    for (row = 0; row < rows; ++row)
+    for (int row = 0; row < rows; ++row)
     {
-      pRhs[row] = 0.0;
+      rhs[row] = 0.0;
     }
-    pRhs[identElem] = 1.0;
+    rhs[identElem] = 1.0;
 
-    //
-    // Apply the same scaling used on the left hand side of the system
-    // to the right hand side.
-    //
-    for (zeroColIdx = 0; zeroColIdx < rows-1; ++zeroColIdx)
-    {
-      pivotRow = pRowOrder[zeroColIdx];
-      
-      for (rowIdx = zeroColIdx + 1; rowIdx < rows; ++rowIdx)
-      {
-        row = pRowOrder[rowIdx];
-
-        factor = upTriang[row][zeroColIdx];
+    LuSubst(lu, rowOrder, rhs, result, identElem);
+  }
 
-        pRhs[row] -= factor * pRhs[pivotRow];
-      }
-    }
+  return(result);
+}
 
-    //
-    // Back substitution starting a the bottome of the triangular matrix.
-    //
-    row = pRowOrder[rows - 1];
+//
+//  Solve the linear system A * X = B for X, where A is this matrix.  B may
+//  have any number of columns; each is solved against the same
+//  factorization.  Cheaper and better conditioned than inv(A) * B.
+//
+Matrix Matrix::Solve(const Matrix &rhsMat) const
+{
+  if (rhsMat.rows != rows)
+  {
+    throw(DIMERR());
+  }
 
-    if (upTriang[row][rows-1] == 0.0)
-    {
-      throw(SINGERR());
-    }
+  int                 col(0);
+  Matrix              lu(rows, cols);
+  Matrix              result(rows, rhsMat.cols);
+  std::vector<double> rhs(rows);
+  std::vector<int>    rowOrder;
+  double              sign(1.0);
 
-    result[rows-1][identElem] = pRhs[row] / upTriang[row][rows-1];
+  if (!LuFactor(lu, rowOrder, sign))
+  {
+    throw(SINGERR());
+  }
 
-    for (rowIdx = rows-2; rowIdx >= 0; --rowIdx)
+  for (col = 0; col < rhsMat.cols; ++col)
+  {
+    for (int row = 0; row < rows; ++row)
     {
-      row = pRowOrder[rowIdx];
-      sum = pRhs[row];
-      
-      for (col = rowIdx + 1; col < cols; ++col)
-      {
-        sum = sum - upTriang[row][col] * result[col][identElem];
-      }
-     
-      if (upTriang[row][rowIdx] == 0.0)
-      {
-      throw(SINGERR());
-      }
-      result[rowIdx][identElem] = sum / upTriang[row][rowIdx];
+      rhs[row] = rhsMat[row][col];
     }
-  }  // end for (identElem = 0; identElem < rows; ++identElem)
-
-  delete [] pRhs;
-  delete [] pRowOrder;
-  delete [] pRowMaxes;
 
-  #ifdef debugEn
-  fclose(fp);
-  #endif
+    LuSubst(lu, rowOrder, rhs, result, col);
+  }
 
-  return(result);
+  return result;
 }
 
 //
 // DotProduct method.
 //
-double Matrix::DotProduct(Matrix arg)
+double Matrix::DotProduct(const Matrix &arg) const
 {
   double result(0.0);
 
@@ -1079,7 +1111,7 @@ double Matrix::DotProduct(Matrix arg)
 //
 // Transpose method
 //
-Matrix Matrix::Transpose()
+Matrix Matrix::Transpose() const
 {
   Matrix result(cols, rows);
 
@@ -1093,7 +1125,7 @@ Matrix Matrix::Transpose()
   return result;
 }
 
-bool Matrix::IsSymmetric(double tol)
+bool Matrix::IsSymmetric(double tol) const
 {
   int    col(0);
   bool   done(false);
@@ -1144,120 +1176,56 @@ bool Matrix::IsSymmetric(double tol)
 }
 
 //
-// Check whether a matrix is positive definite
+// Check whether a matrix is positive definite.
+//
+// A symmetric matrix is positive definite if all leading principal minors are
+// positive.  Eliminating without pivoting, the kth pivot is the ratio of the
+// kth and (k-1)th leading principal minors, so the minors are all positive
+// exactly when the pivots are.
 //
-bool Matrix::IsPosDef()
+bool Matrix::IsPosDef() const
 {
-  bool result;
+  Matrix           lu(rows, cols);
+  bool             result(false);
+  std::vector<int> rowOrder;
+  double           sign(1.0);
 
-  //
-  // A matrix is positive definite if all leading principal minors are positive.
-  //
+  if ((rows == cols) && IsSymmetric())
+  {
+    result = LuFactor(lu, rowOrder, sign, false);
 
+    for (int row = 0; result && (row < rows); ++row)
+    {
+      result = lu[row][row] > 0.0;
+    }
+  }
 
   return result;
 }
 
 //
-// Calculate the determinate of the matrix. The row with the most zero elements
-// is selected.  Then the minor, Mij, for each element aij of tha row is
-// calculated.  The cofactor of aij is Aij = (-1)^(i+j) * Mij.  The deternimte
-// is the sum across the selected row of aij * Aij
+// Calculate the determinate of the matrix.  The matrix is factored by
+// LuFactor(), P * A = L * U.  L has a unit diagonal, so the determinate is
+// the product of the pivots, the diagonal of U, times the sign of the
+// permutation P.  A singular matrix has a determinate of zero.
 //
-// Ref:  J.H. Mathews, K.D. Fink, "Numerical Methods Using MATLAB", 3rd ed.,
-//       Prentice Hall, 1999, p. 113
-//
-double Matrix::Det()
+double Matrix::Det() const
 {
-  if (rows != cols)
-  {
-    throw(DIMERR());
-  }
+  Matrix           lu(rows, cols);
+  double           result(0.0);
+  std::vector<int> rowOrder;
+  double           sign(1.0);
 
-  double cofactor;
-  int    col(0);
-  bool   done(false);
-  int    maxZeroRow(0);
-  double minor(0.0);
-  int    prevZeroCnt(0);
-  double result(0.0);
-  int    row(0);
-  double sign(0.0);
-  int    zeroCnt(0);
-
-  //
-  // Handle trivial cases.
-  //
-  if (rows == 1)
+  if (LuFactor(lu, rowOrder, sign))
   {
-    result = *pData;
-    done = true;
-  }
+    result = sign;
 
-  if (!done)
-  {
-    if (rows == 2)
+    for (int row = 0; row < rows; ++row)
     {
-      result = (*this)[0][0] * (*this)[1][1] - (*this)[0][1] * (*this)[1][0];
-      done = true;
+      result *= lu[rowOrder[row]][row];
     }
   }
 
-  if (!done)
-  {
-    //
-    // Find the row with the most zero elements.
-    //
-    for (row = 0; row < rows; ++row)
-    {
-      zeroCnt = 0.0;
-      for (col = 0; col < cols; ++col)
-      {
-        if (WithinTolerance((*this)[row][col],  0.0))
-        {
-          ++zeroCnt;
-        }
-      }
-      if (zeroCnt == cols)
-      {
-        result = 0.0;
-        done = true;
-        break;  // exit loop for (row = 0; row < rows; ++row)
-      }
-      else if (zeroCnt > prevZeroCnt)
-      {
-        maxZeroRow = row;
-        prevZeroCnt = zeroCnt;
-      }
-    }
-    
-    row = maxZeroRow;
-
-  } // end if (!done)
-
-  //
-  // Sum the products of the selected row elements and their cofactors.
-  //
-  if (!done)
-  {  
-    for (col = 0; col < cols; ++col)
-    {
-      if (!WithinTolerance(pData[row*cols+col], 0.0))
-      { 
-        //
-        // Odd powers of -1 are negative 1, even powers are positive 1.
-        //
-        sign = (row + col) % 2 == 0 ? 1.0 : -1.0;
-
-        minor = Minor(row, col);
-    
-        cofactor = sign * pData[row*cols+col] * minor;
-    
-        result += cofactor;
-      }
-    }
-  }  // end if (!done)
-
   return result;
 }
 
@@ -1266,7 +1234,7 @@ double Matrix::Det()
 // is the determinate of the submatrix matrix formed by deleting the ith row
 // and jth column of the parent matrix.
 //
-double Matrix::Minor(double row_, double col_)
+double Matrix::Minor(double row_, double col_) const
 {
   int    minCol(0);
   Matrix minMat(rows-1, cols-1);
@@ -1533,7 +1501,7 @@ namespace MATRIX
 //
 // Binary matrix addition by a lhs scalar
 //
-Matrix operator+ (const double lhs, Matrix rhs)
+Matrix operator+ (const double lhs, const Matrix &rhs)
 {
   Matrix result(rhs.NumRows(), rhs.NumCols());
 
@@ -1551,7 +1519,7 @@ Matrix operator+ (const double lhs, Matrix rhs)
 //
 // Binary matrix subtraction by a lhs scalar
 //
-Matrix operator- (const double lhs, Matrix rhs)
+Matrix operator- (const double lhs, const Matrix &rhs)
 {
   Matrix result(rhs.NumRows(), rhs.NumCols());
 
@@ -1569,7 +1537,7 @@ Matrix operator- (const double lhs, Matrix rhs)
 //
 // Binary matrix multiplication by a lhs scalar
 //
-Matrix operator* (const double lhs, Matrix rhs)
+Matrix operator* (const double lhs, const Matrix &rhs)
 {
   Matrix result(rhs.NumRows(), rhs.NumCols());
 
@@ -1587,7 +1555,7 @@ Matrix operator* (const double lhs, Matrix rhs)
 //
 // Binary matrix division by a lhs scalar
 //
-Matrix operator/ (const double lhs, Matrix rhs)
+Matrix operator/ (const double lhs, const Matrix &rhs)
 {
   Matrix result(rhs.NumRows(), rhs.NumCols());
 
@@ -1609,35 +1577,27 @@ Matrix operator/ (const double lhs, Matrix rhs)
 //
 // Return the inverse of a matrix
 //
-Matrix Invert(Matrix &MM)
+Matrix Invert(const Matrix &MM)
 {
-  Matrix result;
-
-  result = MM.Inv();
-
-  return result;
+  return MM.Inv();
 }
 
 //
-// Dot product function
+// Solve the linear system A * X = B
 //
-double DotProduct(Matrix arg1, Matrix arg2)
+Matrix Solve(const Matrix &AA, const Matrix &BB)
 {
-  double result(0.0);
-
-  result = arg1.DotProduct(arg2);
-
-  return result;
+  return AA.Solve(BB);
 }
 
 //
-// Transpose function
+// Dot product function
 //
-Matrix Transpose(Matrix arg)
+double DotProduct(const Matrix &arg1, const Matrix &arg2)
 {
-  Matrix result;
+  double result(0.0);
 
-  result = arg.Transpose();
+  result = arg1.DotProduct(arg2);
 
   return result;
 }
@@ -1645,7 +1605,7 @@ Matrix Transpose(Matrix arg)
 //
 // Symmetry test
 //
-bool IsSymmetric(Matrix arg)
+bool IsSymmetric(const Matrix &arg)
 {
   bool result(false);
 
@@ -15,7 +15,10 @@
 #include <sstream>
 #include <string>
 #include <limits>
+#include <vector>
 
+template <class E>
+class MatExpr;
 
 class Matrix
 {
@@ -34,6 +37,17 @@ public:
   //
   Matrix(const Matrix &mat);
 
+  //
+  // Move constructor.  Takes the buffer of mat, leaving it empty.
+  //
+  Matrix(Matrix &&mat) noexcept;
+
+  //
+  // Evaluate an expression, see MatrixExpr.hpp
+  //
+  template <class E>
+  Matrix(const MatExpr<E> &expr);
+
   //
   // Destructor
   //
@@ -50,25 +64,37 @@ void Resize(int rows, int cols, double initVal = 0.0);
 
 void Set(double val);
 
-bool CheckDim(int row, int col);
+void Swap(Matrix &mat) noexcept;
 
-bool CheckDim(int idx);
+bool CheckDim(int row, int col) const;
+
+bool CheckDim(int idx) const;
 
 double *GetPtr(int row, int col);
 
 double *GetPtr(int idx);
 
-int NumRows() 
+double *Data()
+{
+  return pData;
+}
+
+const double *Data() const
+{
+  return pData;
+}
+
+int NumRows() const
 {
   return rows;
 }
 
-int NumCols()
+int NumCols() const
 {
   return cols;
 }
 
-int NumEmems()
+int NumEmems() const
 {
   return nElem;
 }
@@ -81,23 +107,24 @@ double & operator()(int row, int col);
 
 double & operator()(int idx);
 
-double* operator[](int row);
+double operator()(int row, int col) const;
+
+double operator()(int idx) const;
 
-//Matrix& operator= (const Matrix& mat);
-//Matrix& operator= (Matrix& mat);
-Matrix operator= (Matrix mat);
+double* operator[](int row);
 
-Matrix operator= (double scalar);
+const double* operator[](int row) const;
 
-//Matrix operator= (const double scalar);        // Didn't work
+Matrix& operator= (const Matrix &mat);
 
-Matrix operator+ (const Matrix rhs) const;
+Matrix& operator= (Matrix &&mat) noexcept;
 
-Matrix operator- (const Matrix rhs) const;
+Matrix& operator= (double scalar);
 
-Matrix operator/ (const Matrix rhs) const;
+template <class E>
+Matrix& operator= (const MatExpr<E> &expr);
 
-Matrix operator* (const Matrix rhs) const;
+Matrix operator/ (const Matrix &rhs) const;
 
 Matrix operator+ (const double rhs) const;
 
@@ -107,13 +134,19 @@ Matrix operator* (const double rhs) const;
 
 Matrix operator/ (const double rhs) const;
 
-void operator+= (const Matrix rhs);
+void operator+= (const Matrix &rhs);
+
+void operator-= (const Matrix &rhs);
+
+void operator*= (const Matrix &rhs);
 
-void operator-= (const Matrix rhs);
+void operator/= (const Matrix &rhs);
 
-void operator*= (const Matrix rhs);
+template <class E>
+void operator+= (const MatExpr<E> &expr);
 
-void operator/= (const Matrix rhs);
+template <class E>
+void operator-= (const MatExpr<E> &expr);
 
 void operator+= (const double rhs);
 
@@ -123,19 +156,26 @@ void operator*= (const double rhs);
 
 void operator/= (const double rhs);
 
-Matrix Inv();
+Matrix Inv() const;
 
-double DotProduct(Matrix arg);
+Matrix Solve(const Matrix &rhs) const;
 
-Matrix Transpose();
+bool LuFactor(Matrix           &lu,
+              std::vector<int> &rowOrder,
+              double           &sign,
+              bool             pivot = true) const;
 
-bool IsSymmetric(double tol = 0.0);
+double DotProduct(const Matrix &arg) const;
 
-double Det();
+Matrix Transpose() const;
 
-double Minor(double row, double col);
+bool IsSymmetric(double tol = 0.0) const;
 
-bool IsPosDef();
+double Det() const;
+
+double Minor(double row, double col) const;
+
+bool IsPosDef() const;
 
 Matrix Chol_UtU(bool &posDef);
 
@@ -204,11 +244,19 @@ private:
   void Construct(int    rows,
                  int    cols);
 
-  bool WithinTolerance(double arg1,
-                       double arg2,
-                       double tol = 0.0);
+  void Release();
+
+  static void LuSubst(const Matrix           &lu,
+                      const std::vector<int> &rowOrder,
+                      std::vector<double>    &rhs,
+                      Matrix                 &result,
+                      int                    resultCol);
 
-  double Max(double arg1, double arg2);
+  static bool WithinTolerance(double arg1,
+                              double arg2,
+                              double tol = 0.0);
+
+  static double Max(double arg1, double arg2);
 
   int    cols;
   int    nElem;
@@ -220,24 +268,26 @@ private:
 namespace MATRIX
 {
 
-Matrix operator+ (const double lhs, Matrix rhs);
+Matrix operator+ (const double lhs, const Matrix &rhs);
 
-Matrix operator- (const double lhs, Matrix rhs);
+Matrix operator- (const double lhs, const Matrix &rhs);
 
-Matrix operator* (const double lhs, Matrix rhs);
+Matrix operator* (const double lhs, const Matrix &rhs);
 
-Matrix operator/ (const double lhs, Matrix rhs);
+Matrix operator/ (const double lhs, const Matrix &rhs);
 
-Matrix Invert(Matrix &MM);
+Matrix Invert(const Matrix &MM);
 
-double DotProduct(Matrix arg1, Matrix arg2);
+Matrix Solve(const Matrix &AA, const Matrix &BB);
 
-Matrix Transpose(Matrix arg);
+double DotProduct(const Matrix &arg1, const Matrix &arg2);
 
-bool IsSymmetric(Matrix arg);
+bool IsSymmetric(const Matrix &arg);
 
 } // end namespace MATRIX
 
+#include "MatrixExpr.hpp"
+
 #endif
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,760 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// MatrixExpr.hpp
+//
+// Overview:
+//  Lazy evaluation of Matrix arithmetic.  Included by Matrix.hpp.
+//
+//  Matrix + - * Matrix and MATRIX::Transpose() return small expression
+//  objects instead of Matrix temporaries.  The work is done when the
+//  expression is assigned to a Matrix:
+//
+//    - A transpose is a view of the operand with the strides swapped.
+//      No elements are copied.
+//    - A product of two matrices or views is written straight into the
+//      destination.  The inner product of a chain of three is evaluated
+//      into one temporary, in whichever order takes fewer multiplies.
+//      Ties keep the left to right order.
+//    - Sums write the first term into the destination and accumulate the
+//      rest into it, so A*B + C*D makes no temporaries at all.
+//
+//  Element sums run in the same order as the eager operators, so left to
+//  right expressions give bit identical results.
+//
+//  An expression holds references to its operands.  Assign it to a Matrix
+//  within the statement that builds it.  Don't keep it in an auto variable.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MATRIXEXPR_HPP
+#define MATRIXEXPR_HPP
+
+#include <type_traits>
+
+//
+// Base of all expression nodes.  E is the derived node type.
+//
+template <class E>
+class MatExpr
+{
+public:
+
+  const E &Self() const
+  {
+    return static_cast<const E &>(*this);
+  }
+};
+
+//
+// How an evaluated expression is combined with the destination.
+//
+enum MatEvalMode
+{
+  MAT_ASSIGN,
+  MAT_ADD,
+  MAT_SUB
+};
+
+//
+// Leaf node, a Matrix read in place.  A transposed view swaps the strides.
+//
+class MatView : public MatExpr<MatView>
+{
+public:
+
+  explicit MatView(const Matrix &mat)
+    : pMat(&mat),
+      pData(mat.Data()),
+      rows(mat.NumRows()),
+      cols(mat.NumCols()),
+      rowStride(mat.NumCols()),
+      colStride(1)
+  {}
+
+  MatView Transposed() const
+  {
+    MatView result(*this);
+
+    result.rows = cols;
+    result.cols = rows;
+    result.rowStride = colStride;
+    result.colStride = rowStride;
+
+    return result;
+  }
+
+  int NumRows() const
+  {
+    return rows;
+  }
+
+  int NumCols() const
+  {
+    return cols;
+  }
+
+  double operator()(int row, int col) const
+  {
+    return pData[row * rowStride + col * colStride];
+  }
+
+  bool Aliases(const Matrix &mat) const
+  {
+    return pMat == &mat;
+  }
+
+  bool AliasesDst(const Matrix &mat) const
+  {
+    return pMat == &mat;
+  }
+
+  void Apply(Matrix &dst, MatEvalMode mode) const
+  {
+    double *pDst(dst.Data());
+
+    for (int row = 0; row < rows; ++row)
+    {
+      for (int col = 0; col < cols; ++col)
+      {
+        switch (mode)
+        {
+          case MAT_ASSIGN: *pDst = (*this)(row, col);  break;
+          case MAT_ADD:    *pDst += (*this)(row, col); break;
+          case MAT_SUB:    *pDst -= (*this)(row, col); break;
+        }
+        ++pDst;
+      }
+    }
+  }
+
+private:
+
+  const Matrix *pMat;
+  const double *pData;
+  int           rows;
+  int           cols;
+  int           rowStride;
+  int           colStride;
+};
+
+//
+// An expression operand as a view.  Leaves are used in place, anything
+// else is evaluated into a temporary first.
+//
+template <class E>
+class MatOperand
+{
+public:
+
+  explicit MatOperand(const E &expr)
+    : temp(expr.NumRows(), expr.NumCols()),
+      view(temp)
+  {
+    expr.Apply(temp, MAT_ASSIGN);
+  }
+
+  const MatView &View() const
+  {
+    return view;
+  }
+
+private:
+
+  Matrix  temp;
+  MatView view;
+};
+
+template <>
+class MatOperand<MatView>
+{
+public:
+
+  explicit MatOperand(const MatView &view_)
+    : view(view_)
+  {}
+
+  const MatView &View() const
+  {
+    return view;
+  }
+
+private:
+
+  MatView view;
+};
+
+//
+// dst (mode) lhs * rhs.  Each element is summed from zero in ascending
+// inner index, the same as Matrix::operator*.
+//
+inline void MatGemm(Matrix        &dst,
+                    const MatView &lhs,
+                    const MatView &rhs,
+                    MatEvalMode   mode)
+{
+  double *pDst(dst.Data());
+  double sum;
+  int    inner(lhs.NumCols());
+
+  for (int row = 0; row < lhs.NumRows(); ++row)
+  {
+    for (int col = 0; col < rhs.NumCols(); ++col)
+    {
+      sum = 0.0;
+      for (int idx = 0; idx < inner; ++idx)
+      {
+        sum += lhs(row, idx) * rhs(idx, col);
+      }
+
+      switch (mode)
+      {
+        case MAT_ASSIGN: *pDst = sum;  break;
+        case MAT_ADD:    *pDst += sum; break;
+        case MAT_SUB:    *pDst -= sum; break;
+      }
+      ++pDst;
+    }
+  }
+}
+
+template <class L, class R>
+class MatProd;
+
+template <class E>
+struct IsMatProd : std::false_type
+{};
+
+template <class L, class R>
+struct IsMatProd< MatProd<L, R> > : std::true_type
+{};
+
+//
+// Whether mat is a leaf operand.  Any other operand is evaluated into a
+// temporary before the destination is written.
+//
+template <class E>
+inline bool MatLeafAliases(const E &expr, const Matrix &mat)
+{
+  if constexpr (std::is_same<E, MatView>::value)
+  {
+    return expr.Aliases(mat);
+  }
+  else
+  {
+    return false;
+  }
+}
+
+//
+// Matrix product node
+//
+template <class L, class R>
+class MatProd : public MatExpr< MatProd<L, R> >
+{
+public:
+
+  MatProd(const L &lhs_, const R &rhs_)
+    : lhs(lhs_),
+      rhs(rhs_)
+  {
+    if (lhs.NumCols() != rhs.NumRows())
+    {
+      throw(Matrix::DIMERR());
+    }
+  }
+
+  int NumRows() const
+  {
+    return lhs.NumRows();
+  }
+
+  int NumCols() const
+  {
+    return rhs.NumCols();
+  }
+
+  bool Aliases(const Matrix &mat) const
+  {
+    return lhs.Aliases(mat) || rhs.Aliases(mat);
+  }
+
+  //
+  // Only the operands of the final multiply are read while the
+  // destination is written.
+  //
+  bool AliasesDst(const Matrix &mat) const
+  {
+    if constexpr (IsMatProd<L>::value)
+    {
+      if (RightFirst())
+      {
+        return MatLeafAliases(lhs.Lhs(), mat);
+      }
+    }
+    else if constexpr (IsMatProd<R>::value)
+    {
+      if (LeftFirst())
+      {
+        return MatLeafAliases(rhs.Rhs(), mat);
+      }
+    }
+
+    return MatLeafAliases(lhs, mat) || MatLeafAliases(rhs, mat);
+  }
+
+  const L &Lhs() const
+  {
+    return lhs;
+  }
+
+  const R &Rhs() const
+  {
+    return rhs;
+  }
+
+  void Apply(Matrix &dst, MatEvalMode mode) const
+  {
+    if constexpr (IsMatProd<L>::value)
+    {
+      if (RightFirst())
+      {
+        auto inner(lhs.Rhs() * rhs);
+
+        MatOperand<typename std::decay<decltype(lhs.Lhs())>::type>
+                                                         outer(lhs.Lhs());
+        MatOperand<decltype(inner)> tail(inner);
+
+        MatGemm(dst, outer.View(), tail.View(), mode);
+        return;
+      }
+    }
+    else if constexpr (IsMatProd<R>::value)
+    {
+      if (LeftFirst())
+      {
+        auto inner(lhs * rhs.Lhs());
+
+        MatOperand<decltype(inner)> head(inner);
+        MatOperand<typename std::decay<decltype(rhs.Rhs())>::type>
+                                                         outer(rhs.Rhs());
+
+        MatGemm(dst, head.View(), outer.View(), mode);
+        return;
+      }
+    }
+
+    MatOperand<L> lhsOp(lhs);
+    MatOperand<R> rhsOp(rhs);
+
+    MatGemm(dst, lhsOp.View(), rhsOp.View(), mode);
+  }
+
+private:
+
+  //
+  // (A*B)*C costs m*k*n + m*n*p multiplies and A*(B*C) costs
+  // k*n*p + m*k*p, with A m x k, B k x n and C n x p.  Ties keep the
+  // order as written.
+  //
+  static bool Cheaper(long mm, long kk, long nn, long pp, bool rightFirst)
+  {
+    long costLeft(mm * kk * nn + mm * nn * pp);
+    long costRight(kk * nn * pp + mm * kk * pp);
+
+    return rightFirst ? (costRight < costLeft) : (costLeft < costRight);
+  }
+
+  //
+  // (A*B)*C as written, evaluate it as A*(B*C)
+  //
+  bool RightFirst() const
+  {
+    if constexpr (IsMatProd<L>::value)
+    {
+      return Cheaper(lhs.Lhs().NumRows(), lhs.Lhs().NumCols(),
+                     lhs.Rhs().NumCols(), rhs.NumCols(), true);
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  //
+  // A*(B*C) as written, evaluate it as (A*B)*C
+  //
+  bool LeftFirst() const
+  {
+    if constexpr (IsMatProd<R>::value)
+    {
+      return Cheaper(lhs.NumRows(), lhs.NumCols(),
+                     rhs.Lhs().NumCols(), rhs.Rhs().NumCols(), false);
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  L lhs;
+  R rhs;
+};
+
+//
+// Matrix sum or difference node
+//
+template <class L, class R>
+class MatSum : public MatExpr< MatSum<L, R> >
+{
+public:
+
+  MatSum(const L &lhs_, const R &rhs_, bool subtract_)
+    : lhs(lhs_),
+      rhs(rhs_),
+      subtract(subtract_)
+  {
+    if ((lhs.NumRows() != rhs.NumRows()) ||
+        (lhs.NumCols() != rhs.NumCols()))
+    {
+      throw(Matrix::DIMERR());
+    }
+  }
+
+  int NumRows() const
+  {
+    return lhs.NumRows();
+  }
+
+  int NumCols() const
+  {
+    return lhs.NumCols();
+  }
+
+  bool Aliases(const Matrix &mat) const
+  {
+    return lhs.Aliases(mat) || rhs.Aliases(mat);
+  }
+
+  //
+  // The right hand side is evaluated after the left hand side has been
+  // written, so any read of mat there counts.
+  //
+  bool AliasesDst(const Matrix &mat) const
+  {
+    return lhs.AliasesDst(mat) || rhs.Aliases(mat);
+  }
+
+  void Apply(Matrix &dst, MatEvalMode mode) const
+  {
+    MatEvalMode rhsMode(subtract ? MAT_SUB : MAT_ADD);
+
+    if (mode == MAT_SUB)
+    {
+      rhsMode = subtract ? MAT_ADD : MAT_SUB;
+    }
+
+    lhs.Apply(dst, mode);
+    rhs.Apply(dst, rhsMode);
+  }
+
+private:
+
+  L    lhs;
+  R    rhs;
+  bool subtract;
+};
+
+//
+// Expression times or divided by a scalar
+//
+template <class E>
+class MatScale : public MatExpr< MatScale<E> >
+{
+public:
+
+  MatScale(const E &expr_, double scalar_, bool divide_)
+    : expr(expr_),
+      scalar(scalar_),
+      divide(divide_)
+  {
+    if (divide && (scalar == 0.0))
+    {
+      throw(Matrix::DIVBYZERO());
+    }
+  }
+
+  int NumRows() const
+  {
+    return expr.NumRows();
+  }
+
+  int NumCols() const
+  {
+    return expr.NumCols();
+  }
+
+  bool Aliases(const Matrix &mat) const
+  {
+    return expr.Aliases(mat);
+  }
+
+  bool AliasesDst(const Matrix &mat) const
+  {
+    return expr.AliasesDst(mat);
+  }
+
+  void Apply(Matrix &dst, MatEvalMode mode) const
+  {
+    if (mode == MAT_ASSIGN)
+    {
+      expr.Apply(dst, MAT_ASSIGN);
+
+      if (divide)
+      {
+        dst /= scalar;
+      }
+      else
+      {
+        dst *= scalar;
+      }
+      return;
+    }
+
+    MatOperand<E> operand(expr);
+    const MatView &view(operand.View());
+    double *pDst(dst.Data());
+    double term;
+
+    for (int row = 0; row < view.NumRows(); ++row)
+    {
+      for (int col = 0; col < view.NumCols(); ++col)
+      {
+        term = divide ? view(row, col) / scalar : view(row, col) * scalar;
+
+        if (mode == MAT_ADD)
+        {
+          *pDst += term;
+        }
+        else
+        {
+          *pDst -= term;
+        }
+        ++pDst;
+      }
+    }
+  }
+
+private:
+
+  E      expr;
+  double scalar;
+  bool   divide;
+};
+
+//
+// Operand type mapping.  A Matrix enters an expression as a view.
+//
+template <class T>
+struct IsMatOperand
+  : std::integral_constant<bool, std::is_same<T, Matrix>::value ||
+                                 std::is_base_of<MatExpr<T>, T>::value>
+{};
+
+template <class T>
+struct MatExprOf
+{
+  typedef T type;
+};
+
+template <>
+struct MatExprOf<Matrix>
+{
+  typedef MatView type;
+};
+
+inline MatView AsMatExpr(const Matrix &mat)
+{
+  return MatView(mat);
+}
+
+template <class E>
+inline const E &AsMatExpr(const MatExpr<E> &expr)
+{
+  return expr.Self();
+}
+
+template <class L, class R>
+using MatBinaryOk = typename std::enable_if<IsMatOperand<L>::value &&
+                                            IsMatOperand<R>::value>::type;
+
+//
+// Binary matrix multiplication
+//
+template <class L, class R, class = MatBinaryOk<L, R> >
+inline MatProd<typename MatExprOf<L>::type, typename MatExprOf<R>::type>
+operator* (const L &lhs, const R &rhs)
+{
+  return MatProd<typename MatExprOf<L>::type,
+                 typename MatExprOf<R>::type>(AsMatExpr(lhs), AsMatExpr(rhs));
+}
+
+//
+// Binary addition
+//
+template <class L, class R, class = MatBinaryOk<L, R> >
+inline MatSum<typename MatExprOf<L>::type, typename MatExprOf<R>::type>
+operator+ (const L &lhs, const R &rhs)
+{
+  return MatSum<typename MatExprOf<L>::type,
+                typename MatExprOf<R>::type>(AsMatExpr(lhs), AsMatExpr(rhs),
+                                             false);
+}
+
+//
+// Binary subtraction
+//
+template <class L, class R, class = MatBinaryOk<L, R> >
+inline MatSum<typename MatExprOf<L>::type, typename MatExprOf<R>::type>
+operator- (const L &lhs, const R &rhs)
+{
+  return MatSum<typename MatExprOf<L>::type,
+                typename MatExprOf<R>::type>(AsMatExpr(lhs), AsMatExpr(rhs),
+                                             true);
+}
+
+//
+// Expression by a scalar.  Matrix by a scalar stays a Matrix member.
+//
+template <class E>
+inline MatScale<E> operator* (const MatExpr<E> &lhs, double rhs)
+{
+  return MatScale<E>(lhs.Self(), rhs, false);
+}
+
+template <class E>
+inline MatScale<E> operator* (double lhs, const MatExpr<E> &rhs)
+{
+  return MatScale<E>(rhs.Self(), lhs, false);
+}
+
+template <class E>
+inline MatScale<E> operator/ (const MatExpr<E> &lhs, double rhs)
+{
+  return MatScale<E>(lhs.Self(), rhs, true);
+}
+
+//
+// Matrix members that take an expression
+//
+template <class E>
+Matrix::Matrix(const MatExpr<E> &expr)
+  : pData(NULL)
+{
+  Construct(expr.Self().NumRows(), expr.Self().NumCols());
+
+  expr.Self().Apply(*this, MAT_ASSIGN);
+}
+
+template <class E>
+Matrix& Matrix::operator= (const MatExpr<E> &expr)
+{
+  const E &self(expr.Self());
+
+  if ((pData == NULL) || self.AliasesDst(*this))
+  {
+    Matrix temp(expr);
+
+    Swap(temp);
+  }
+  else
+  {
+    if ((rows != self.NumRows()) ||
+        (cols != self.NumCols()))
+    {
+      Resize(self.NumRows(), self.NumCols());
+    }
+    self.Apply(*this, MAT_ASSIGN);
+  }
+  return *this;
+}
+
+template <class E>
+void Matrix::operator+= (const MatExpr<E> &expr)
+{
+  const E &self(expr.Self());
+
+  if ((rows != self.NumRows()) ||
+      (cols != self.NumCols()))
+  {
+    throw(DIMERR());
+  }
+
+  if (self.AliasesDst(*this))
+  {
+    Matrix temp(expr);
+
+    *this += temp;
+  }
+  else
+  {
+    self.Apply(*this, MAT_ADD);
+  }
+}
+
+template <class E>
+void Matrix::operator-= (const MatExpr<E> &expr)
+{
+  const E &self(expr.Self());
+
+  if ((rows != self.NumRows()) ||
+      (cols != self.NumCols()))
+  {
+    throw(DIMERR());
+  }
+
+  if (self.AliasesDst(*this))
+  {
+    Matrix temp(expr);
+
+    *this -= temp;
+  }
+  else
+  {
+    self.Apply(*this, MAT_SUB);
+  }
+}
+
+namespace MATRIX
+{
+
+//
+// Transposed view of a matrix
+//
+inline MatView Transpose(const Matrix &arg)
+{
+  return MatView(arg).Transposed();
+}
+
+inline MatView Transpose(const MatView &arg)
+{
+  return arg.Transposed();
+}
+
+//
+// Transpose of any other expression, evaluated
+//
+template <class E>
+inline Matrix Transpose(const MatExpr<E> &arg)
+{
+  Matrix temp(arg);
+
+  return temp.Transpose();
+}
+
+} // end namespace MATRIX
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,365 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// BenchMat.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BenchMat.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace MATRIX;
+
+//
+// Heap allocation counter.  Every operator new in the program is counted so
+// the allocations made inside the timed loops can be reported.
+//
+static long allocCnt = 0;
+
+void *operator new( std::size_t size )
+{
+  void *ptr;
+
+  ++allocCnt;
+
+  ptr = malloc( size == 0 ? 1 : size );
+  if ( ptr == NULL )
+  {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void operator delete( void *ptr ) noexcept
+{
+  free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+  free( ptr );
+}
+
+BenchMat::BenchMat() :
+HH(3,6),
+KK(6,3),
+phi(6,6),
+PP(6,6),
+RR(3,3),
+temp1(6,6),
+KKs(6,3),
+PPs(6,6)
+{
+  Reset();
+}
+
+//
+// Set the inputs of all three evaluations to the same values.
+//
+void BenchMat::Reset()
+{
+  int    col;
+  double dt(1.0 / 64.0);
+  int    row;
+
+  HH = 0.0;
+  phi = 0.0;
+  PP = 0.0;
+  RR = 0.0;
+
+  for ( row = 0; row < 6; ++row )
+  {
+    phi[row][row] = 1.0 - 0.01 * row * dt;
+    if ( row < 5 )
+    {
+      phi[row][row+1] = dt;
+    }
+
+    for ( col = 0; col < 6; ++col )
+    {
+      PP[row][col] = 1.0 / ( 1.0 + row + col );
+    }
+    PP[row][row] += 1.0;
+
+    for ( col = 0; col < 3; ++col )
+    {
+      KK[row][col] = 0.1 * ( row + 1 ) / ( col + 2 );
+    }
+  }
+
+  HH[0][0] = 1.0;
+  HH[1][2] = 1.0;
+  HH[2][3] = 1.0;
+
+  RR[0][0] = 1.0e-4;
+  RR[1][1] = 4.0e-6;
+  RR[2][2] = 2.5e-5;
+  RR[1][2] = 1.0e-6;
+  RR[2][1] = RR[1][2];
+
+  temp1 = 0.0;
+  temp1.Eye();
+  temp1 -= KK * HH;
+
+  PPs = PP;
+  KKs = KK;
+
+  for ( row = 0; row < 6; ++row )
+  {
+    for ( col = 0; col < 6; ++col )
+    {
+      fixPhi[row][col] = phi[row][col];
+      fixPP[row][col] = PP[row][col];
+      fixTemp1[row][col] = temp1[row][col];
+    }
+
+    for ( col = 0; col < 3; ++col )
+    {
+      fixKK[row][col] = KK[row][col];
+      fixHH[col][row] = HH[col][row];
+    }
+  }
+
+  for ( row = 0; row < 3; ++row )
+  {
+    for ( col = 0; col < 3; ++col )
+    {
+      fixRR[row][col] = RR[row][col];
+    }
+  }
+}
+
+//
+// Evaluate one expression one way.
+//
+void BenchMat::Eval( BenchExpr expr, BenchEval eval )
+{
+  switch ( expr )
+  {
+    case PROP:
+    {
+      if ( eval == STEPWISE )
+      {
+        Matrix phiPP( phi * PPs );
+        Matrix phiT( phi.Transpose() );
+
+        PPs = phiPP * phiT;
+      }
+      else if ( eval == EXPRESSION )
+      {
+        PP = phi * PP * Transpose( phi );
+      }
+      else
+      {
+        fixPP = fixPhi * fixPP * Transpose( fixPhi );
+      }
+      break;
+    }
+
+    case GAIN:
+    {
+      if ( eval == STEPWISE )
+      {
+        Matrix HT( HH.Transpose() );
+        Matrix HP( HH * PPs );
+        Matrix HPHT( HP * HT );
+        Matrix temp0( HPHT + RR );
+        Matrix invTemp0( temp0.Inv() );
+        Matrix PHT( PPs * HT );
+
+        KKs = PHT * invTemp0;
+      }
+      else if ( eval == EXPRESSION )
+      {
+        Matrix temp0( HH * PP * Transpose( HH ) + RR );
+
+        KK = PP * Transpose( HH ) * temp0.Inv();
+      }
+      else
+      {
+        Mat<3,3> temp0( fixHH * fixPP * Transpose( fixHH ) + fixRR );
+
+        fixKK = fixPP * Transpose( fixHH ) * temp0.Inv();
+      }
+      break;
+    }
+
+    case JOSEPH:
+    {
+      if ( eval == STEPWISE )
+      {
+        Matrix AP( temp1 * PPs );
+        Matrix AT( temp1.Transpose() );
+        Matrix APAT( AP * AT );
+        Matrix KR( KKs * RR );
+        Matrix KT( KKs.Transpose() );
+        Matrix KRKT( KR * KT );
+
+        PPs = APAT + KRKT;
+      }
+      else if ( eval == EXPRESSION )
+      {
+        PP = temp1 * PP * Transpose( temp1 ) + KK * RR * Transpose( KK );
+      }
+      else
+      {
+        fixPP = fixTemp1 * fixPP * Transpose( fixTemp1 ) +
+                fixKK * fixRR * Transpose( fixKK );
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+//
+// Check the three evaluations agree bit for bit.
+//
+bool BenchMat::Same( BenchExpr expr )
+{
+  int  col;
+  int  row;
+  bool same(true);
+
+  for ( row = 0; row < 6; ++row )
+  {
+    if ( expr == GAIN )
+    {
+      for ( col = 0; col < 3; ++col )
+      {
+        same = same && ( KK[row][col] == KKs[row][col] ) &&
+                       ( KK[row][col] == fixKK[row][col] );
+      }
+    }
+    else
+    {
+      for ( col = 0; col < 6; ++col )
+      {
+        same = same && ( PP[row][col] == PPs[row][col] ) &&
+                       ( PP[row][col] == fixPP[row][col] );
+      }
+    }
+  }
+
+  return same;
+}
+
+void BenchMat::Execute(int argc, char *argv[])
+{
+  int    qtyEvals(100000);
+  int    expr;
+  int    eval;
+  int    idx;
+  long   allocStart;
+  double allocs;
+  double sec;
+  double secStep(0.0);
+  bool   match(true);
+  bool   same;
+
+  const char *exprName[QTY_EXPR] = { "P = phi*P*phi'",
+                                     "K = P*H'*inv(HPH'+R)",
+                                     "P = A*P*A' + K*R*K'" };
+  const char *evalName[QTY_EVAL] = { "step by step",
+                                     "expression",
+                                     "Mat<R,C>" };
+
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point finish;
+
+  if ( argc == 2 )
+  {
+    if ( strcmp("-h", argv[1]) == 0 )
+    {
+      Help();
+      return;
+    }
+
+    qtyEvals = atoi( argv[1] );
+  }
+  else if ( argc > 2 )
+  {
+    Help();
+    return;
+  }
+
+  printf("\n");
+  printf("Estimator expression benchmark, 6 states, 3 measurements, "
+         "%d evaluations\n\n", qtyEvals);
+  printf("%-22s %-14s %14s %12s %9s\n", "expression", "evaluation",
+         "evals/sec", "allocs/eval", "speedup");
+
+  for ( expr = 0; expr < QTY_EXPR; ++expr )
+  {
+    Reset();
+
+    for ( eval = 0; eval < QTY_EVAL; ++eval )
+    {
+      allocStart = allocCnt;
+      start = std::chrono::steady_clock::now();
+
+      for ( idx = 0; idx < qtyEvals; ++idx )
+      {
+        Eval( static_cast<BenchExpr>(expr), static_cast<BenchEval>(eval) );
+      }
+
+      finish = std::chrono::steady_clock::now();
+      allocs = static_cast<double>(allocCnt - allocStart) / qtyEvals;
+      sec = std::chrono::duration<double>( finish - start ).count();
+
+      if ( eval == STEPWISE )
+      {
+        secStep = sec;
+      }
+
+      printf("%-22s %-14s %14.0f %12.3f %9.2f\n",
+             eval == 0 ? exprName[expr] : "", evalName[eval],
+             qtyEvals / sec, allocs, secStep / sec);
+    }
+
+    same = Same( static_cast<BenchExpr>(expr) );
+    match = match && same;
+
+    printf("%-22s %-14s %s\n", "", "bit exact", same ? "yes" : "no");
+  }
+  printf("\n");
+
+  //
+  // A product of two matrices with a transposed operand writes straight
+  // into its destination.
+  //
+  allocStart = allocCnt;
+  for ( idx = 0; idx < qtyEvals; ++idx )
+  {
+    KKs = PP * Transpose( HH );
+  }
+  allocs = static_cast<double>(allocCnt - allocStart) / qtyEvals;
+
+  printf("K = P*H' allocs/eval %6.3f\n", allocs);
+  printf("\n");
+
+  if ( !match || (allocs != 0.0) )
+  {
+    exit(1);
+  }
+}
+
+void BenchMat::Help()
+{
+  printf("Usage: \n");
+  printf("'benchMat -h'           Returns this usage help. \n");
+  printf("'benchMat'              Runs the benchmark, 100000 evaluations. \n");
+  printf("'benchMat evals'        Runs the benchmark with the given evaluations. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
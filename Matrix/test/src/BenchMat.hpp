@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// BenchMat.hpp
+//
+// Overview:
+//  Benchmark of the six state estimator covariance expressions, as in
+//  FcTse6::PropStates() and FcTse6::UpdateStates().  Each expression is
+//  timed three ways: step by step with a named Matrix for every
+//  sub expression and physical transposes, as a single Matrix expression,
+//  and with the fixed size Mat<R,C>.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMAT_HPP
+#define BENCHMAT_HPP
+
+#include "Matrix.hpp"
+#include "Mat.hpp"
+
+class BenchMat
+{
+public:
+
+  BenchMat();
+
+  ~BenchMat()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  typedef enum _bench_expr_
+  {
+    PROP,       // PP = phi * PP * phi'
+    GAIN,       // KK = PP * H' * inv( H * PP * H' + RR )
+    JOSEPH,     // PP = A * PP * A' + KK * RR * KK'
+    QTY_EXPR
+  } BenchExpr;
+
+  typedef enum _bench_eval_
+  {
+    STEPWISE,   // Named temporaries, physical transposes
+    EXPRESSION, // Matrix expression templates
+    FIXED,      // Mat<R,C>
+    QTY_EVAL
+  } BenchEval;
+
+  void Reset();
+
+  void Eval(BenchExpr expr, BenchEval eval);
+
+  bool Same(BenchExpr expr);
+
+  //
+  // Heap matrices
+  //
+  Matrix HH;
+  Matrix KK;
+  Matrix phi;
+  Matrix PP;
+  Matrix RR;
+  Matrix temp1;
+
+  Matrix KKs;
+  Matrix PPs;
+
+  //
+  // Fixed size matrices
+  //
+  Mat<3,6> fixHH;
+  Mat<6,3> fixKK;
+  Mat<6,6> fixPhi;
+  Mat<6,6> fixPP;
+  Mat<3,3> fixRR;
+  Mat<6,6> fixTemp1;
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
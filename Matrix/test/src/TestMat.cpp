@@ -10,15 +10,57 @@
 
 #include<exception>
 
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 using namespace MATRIX;
 
+//
+// Live heap allocation counter.  Every operator new and delete in the program
+// is counted so a test can check that a sequence of operations releases all
+// of the buffers it allocates.
+//
+static long liveAllocs = 0;
+
+void *operator new( std::size_t size )
+{
+  void *ptr;
+
+  ++liveAllocs;
+
+  ptr = malloc( size == 0 ? 1 : size );
+  if ( ptr == NULL )
+  {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void operator delete( void *ptr ) noexcept
+{
+  if ( ptr != NULL )
+  {
+    --liveAllocs;
+    free( ptr );
+  }
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+  if ( ptr != NULL )
+  {
+    --liveAllocs;
+    free( ptr );
+  }
+}
+
 void TestMat::Execute(int argc, char *argv[])
 {
-  int qtyTests(44);
+  int qtyTests(51);
   int testNo(0);
   int start;
   int finish;
@@ -1560,6 +1602,458 @@ void TestMat::RunTest(int testNo)
         break;
       }
 
+      //
+      // Fixed size matrix product against the heap matrix product
+      //
+      case 44:
+      {
+        printf("Test 44: Mat<6,6> * Mat<6,3> \n");
+
+        Mat<6,6> fix1;
+        Mat<6,3> fix2;
+        Mat<6,3> fix3;
+        Matrix   mat2(6,3);
+        Matrix   mat3;
+        bool     same(true);
+
+        mat1.Resize(6,6);
+
+        for (row = 0; row < 6; ++row)
+        {
+          for (col = 0; col < 6; ++col)
+          {
+            fix1[row][col] = 1.0 / static_cast<double>(row + col + 1);
+            mat1[row][col] = fix1[row][col];
+          }
+
+          for (col = 0; col < 3; ++col)
+          {
+            fix2[row][col] = static_cast<double>(row - col) / 7.0;
+            mat2[row][col] = fix2[row][col];
+          }
+        }
+
+        fix3 = fix1 * fix2;
+        mat3 = mat1 * mat2;
+
+        for (row = 0; row < 6; ++row)
+        {
+          for (col = 0; col < 3; ++col)
+          {
+            same = same && (fix3[row][col] == mat3[row][col]);
+          }
+        }
+
+        printf("fix3 = fix1 * fix2 \n");
+        fix3.Print("%10.6f");
+        printf("\n");
+
+        printf("fix3 == mat1 * mat2 = %s \n", same ? "true" : "false");
+
+        break;
+      }
+
+      //
+      // Fixed size matrix inverse against the heap matrix inverse
+      //
+      case 45:
+      {
+        printf("Test 45: Mat<3,3>.Inv() \n");
+
+        Mat<3,3> fix1;
+        Mat<3,3> fix2;
+        Matrix   mat2;
+        bool     same(true);
+
+        mat1.Resize(3,3);
+
+        fix1[0][0] =  4.0;  fix1[0][1] = -2.0;  fix1[0][2] =  1.0;
+        fix1[1][0] = -2.0;  fix1[1][1] =  4.0;  fix1[1][2] = -2.0;
+        fix1[2][0] =  1.0;  fix1[2][1] = -2.0;  fix1[2][2] =  4.0;
+
+        for (row = 0; row < 3; ++row)
+        {
+          for (col = 0; col < 3; ++col)
+          {
+            mat1[row][col] = fix1[row][col];
+          }
+        }
+
+        fix2 = fix1.Inv();
+        mat2 = mat1.Inv();
+
+        for (row = 0; row < 3; ++row)
+        {
+          for (col = 0; col < 3; ++col)
+          {
+            same = same && (fix2[row][col] == mat2[row][col]);
+          }
+        }
+
+        printf("fix1 =  \n");
+        fix1.Print("%10.6f");
+        printf("\n");
+
+        printf("fix2 = fix1.Inv() \n");
+        fix2.Print("%10.6f");
+        printf("\n");
+
+        printf("fix2 == mat1.Inv() = %s \n", same ? "true" : "false");
+
+        break;
+      }
+
+      //
+      // No buffers leak across a Kalman filter cycle
+      //
+      case 46:
+      {
+        printf("Test 46: Live heap allocations across a filter cycle \n");
+
+        Matrix eye(3,3);
+        Matrix HH(1,3);
+        Matrix KK(3,1);
+        Matrix phi(3,3);
+        Matrix PP(3,3);
+        Matrix RR(1,1);
+        Matrix temp0(1,1);
+        Matrix temp1(3,3);
+        long   before(0);
+        long   after(0);
+
+        eye.Eye();
+        HH[0][0] = 1.0;
+        RR[0][0] = 0.25;
+        PP.Eye();
+        PP *= 10.0;
+
+        before = liveAllocs;
+
+        for (idx = 0; idx < 100; ++idx)
+        {
+          phi = 0.0;
+          phi[0][0] = 1.0;
+          phi[0][1] = 0.01;
+          phi[1][1] = 1.0;
+          phi[1][2] = 0.01;
+          phi[2][2] = 1.0;
+
+          PP = phi * PP * Transpose( phi );
+
+          temp0 = HH * PP * Transpose( HH ) + RR;
+
+          KK = PP * Transpose( HH ) * temp0.Inv();
+
+          temp1 = eye - KK * HH;
+
+          PP = temp1 * PP * Transpose( temp1 ) + KK * RR * Transpose( KK );
+        }
+
+        after = liveAllocs;
+
+        printf("PP after 100 cycles \n");
+        PP.Print("%10.6f");
+        printf("\n");
+
+        printf("net allocations = %ld \n", after - before);
+
+        break;
+      }
+
+      //
+      // Lazy expression evaluation against step by step evaluation
+      //
+      case 47:
+      {
+        printf("Test 47: Matrix expressions \n");
+
+        Matrix mat2(4,4);
+        Matrix mat3(4,4);
+        Matrix vec1(4,1);
+        Matrix ref1;
+        Matrix ref2;
+        Matrix res1;
+        bool   same(true);
+
+        mat1.Resize(4,4);
+
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            mat1[row][col] = 1.0 / static_cast<double>(row + col + 1);
+            mat2[row][col] = static_cast<double>(row - col) / 3.0;
+            mat3[row][col] = (row == col) ? 1.0 : 0.1;
+          }
+          vec1[row][0] = static_cast<double>(row + 1);
+        }
+
+        //
+        // Product assigned over one of its own operands
+        //
+        ref1 = mat2 * mat1;
+        ref2 = mat2.Transpose();
+        ref1 = ref1 * ref2;
+
+        res1 = mat1;
+        res1 = mat2 * res1 * Transpose( mat2 );
+
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            same = same && (res1[row][col] == ref1[row][col]);
+          }
+        }
+
+        printf("res1 = mat2 * res1 * Transpose( mat2 ) \n");
+        res1.Print("%10.6f");
+        printf("\n");
+
+        printf("same as step by step = %s \n", same ? "true" : "false");
+        printf("\n");
+
+        //
+        // Fused sum of products
+        //
+        ref1 = mat1 * mat2;
+        ref2 = mat3 * Transpose( mat1 );
+        ref1 = ref1 - ref2;
+
+        res1 = mat1 * mat2 - mat3 * Transpose( mat1 );
+
+        same = true;
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            same = same && (res1[row][col] == ref1[row][col]);
+          }
+        }
+
+        printf("res1 = mat1 * mat2 - mat3 * Transpose( mat1 ) \n");
+        res1.Print("%10.6f");
+        printf("\n");
+
+        printf("same as step by step = %s \n", same ? "true" : "false");
+        printf("\n");
+
+        //
+        // The destination read after the first term has been written
+        //
+        ref1 = mat1 * mat2;
+        ref2 = mat3 * ref1;
+        ref2 = mat1 + ref2;
+
+        res1 = mat1 * mat2;
+        res1 = mat1 + mat3 * res1;
+
+        same = true;
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            same = same && (res1[row][col] == ref2[row][col]);
+          }
+        }
+
+        printf("res1 = mat1 + mat3 * res1 \n");
+        res1.Print("%10.6f");
+        printf("\n");
+
+        printf("same as step by step = %s \n", same ? "true" : "false");
+        printf("\n");
+
+        //
+        // A matrix chain ending in a vector is evaluated right to left.
+        //
+        ref1 = mat1 * mat2;
+        ref1 = ref1 * vec1;
+
+        res1 = mat1 * mat2 * vec1;
+
+        same = true;
+        for (row = 0; row < 4; ++row)
+        {
+          same = same && (fabs(res1[row][0] - ref1[row][0]) < 1.0e-12);
+        }
+
+        printf("res1 = mat1 * mat2 * vec1 \n");
+        res1.Print("%10.6f");
+        printf("\n");
+
+        printf("same as step by step = %s \n", same ? "true" : "false");
+
+        break;
+      }
+
+      //
+      // Linear solve against the LU factorization
+      //
+      case 48:
+      {
+        printf("Test 48: mat1.Solve(rhs) \n");
+
+        Matrix rhs(4,2);
+        Matrix res1;
+        Matrix res2;
+        Matrix eye(4,4);
+        double maxErr(0.0);
+        bool   same(true);
+
+        mat1.Resize(4,4);
+
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            mat1[row][col] = 1.0 / static_cast<double>(row + col + 1);
+          }
+          rhs[row][0] = static_cast<double>(row + 1);
+          rhs[row][1] = (row % 2 == 0) ? 1.0 : -1.0;
+        }
+
+        //
+        // Solving against the identity must reproduce Inv() exactly.
+        //
+        eye.Eye();
+        res1 = mat1.Solve( eye );
+        res2 = mat1.Inv();
+
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 4; ++col)
+          {
+            same = same && (res1[row][col] == res2[row][col]);
+          }
+        }
+
+        res1 = Solve( mat1, rhs );
+        res2 = mat1 * res1 - rhs;
+
+        for (row = 0; row < 4; ++row)
+        {
+          for (col = 0; col < 2; ++col)
+          {
+            maxErr = fmax(maxErr, fabs(res2[row][col]));
+          }
+        }
+
+        printf("mat1 = hilb(4), rhs = [1:4; 1 -1 1 -1]' \n");
+        printf("res1 = Solve( mat1, rhs ) \n");
+        res1.Print("%12.4f");
+        printf("\n");
+
+        printf("|mat1 * res1 - rhs| < 1e-9 = %s \n",
+                                        maxErr < 1.0e-9 ? "true" : "false");
+        printf("mat1.Solve( eye ) == mat1.Inv() = %s \n",
+                                        same ? "true" : "false");
+
+        break;
+      }
+
+      //
+      // Determinant and positive definiteness of a larger matrix
+      //
+      case 49:
+      {
+        printf("Test 49: mat1.Det() and mat1.IsPosDef(), 12x12 \n");
+
+        Matrix mat2(2,2);
+
+        mat1.Resize(12,12);
+
+        for (row = 0; row < 12; ++row)
+        {
+          mat1[row][row] = 2.0;
+          if (row > 0)
+          {
+            mat1[row][row-1] = -1.0;
+            mat1[row-1][row] = -1.0;
+          }
+        }
+
+        printf("mat1 = tridiag(-1, 2, -1) \n");
+        printf("mat1.Det() = 13? %8.4f \n", mat1.Det());
+        printf("mat1.IsPosDef() = true? %s \n",
+                                    mat1.IsPosDef() ? "true" : "false");
+
+        mat1[11][11] = 0.5;
+        printf("mat1(11,11) = 0.5 \n");
+        printf("mat1.Det() = -5? %8.4f \n", mat1.Det());
+        printf("mat1.IsPosDef() = false? %s \n",
+                                    mat1.IsPosDef() ? "true" : "false");
+
+        mat2[0][1] = 1.0;
+        mat2[1][0] = 2.0;
+        printf("mat2 = [0 1; 2 0] \n");
+        printf("mat2.Det() = -2? %8.4f \n", mat2.Det());
+        printf("mat2.IsPosDef() = false? %s \n",
+                                    mat2.IsPosDef() ? "true" : "false");
+
+        break;
+      }
+
+      //
+      // Kalman gain by Cholesky factor and triangular substitution
+      //
+      case 50:
+      {
+        printf("Test 50: Mat<3,3>.Chol_LLt() and CholSolve() \n");
+
+        Mat<3,3> fix1;
+        Mat<3,3> lower;
+        Mat<6,3> PHT;
+        Mat<6,3> gain1;
+        Mat<6,3> gain2;
+        double   maxErr(0.0);
+        bool     posDef(false);
+
+        fix1[0][0] = 25.0;  fix1[0][1] = 15.0;  fix1[0][2] = -5.0;
+        fix1[1][0] = 15.0;  fix1[1][1] = 18.0;  fix1[1][2] =  0.0;
+        fix1[2][0] = -5.0;  fix1[2][1] =  0.0;  fix1[2][2] = 11.0;
+
+        for (row = 0; row < 6; ++row)
+        {
+          for (col = 0; col < 3; ++col)
+          {
+            PHT[row][col] = 1.0 / static_cast<double>(row + col + 1);
+          }
+        }
+
+        lower = fix1.Chol_LLt( posDef );
+
+        printf("fix1 = [25, 15, -5; 15, 18, 0; -5, 0, 11] \n");
+        printf("lower = fix1.Chol_LLt(posDef) = [5, 0, 0; 3, 3, 0; -1, 1, 3]? \n");
+        lower.Print("%10.6f");
+        printf("posDef = %s \n", posDef ? "true" : "false");
+        printf("\n");
+
+        //
+        // K = P*H'*inv(S) against K' = S \ (P*H')'
+        //
+        gain1 = PHT * fix1.Inv();
+        gain2 = Transpose( lower.CholSolve( Transpose( PHT ) ) );
+
+        for (row = 0; row < 6; ++row)
+        {
+          for (col = 0; col < 3; ++col)
+          {
+            maxErr = fmax(maxErr, fabs(gain1[row][col] - gain2[row][col]));
+          }
+        }
+
+        printf("|PHT * inv(fix1) - (lower.CholSolve(PHT'))'| < 1e-14 = %s \n",
+                                        maxErr < 1.0e-14 ? "true" : "false");
+
+        fix1[2][2] = -11.0;
+        lower = fix1.Chol_LLt( posDef );
+        printf("fix1(2,2) = -11, posDef = false? %s \n",
+                                        posDef ? "true" : "false");
+
+        break;
+      }
+
       default:
       {
         printf("Test %d does not exist. \n", testNo);
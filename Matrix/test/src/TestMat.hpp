@@ -10,6 +10,7 @@
 #define TESTMAT_HPP
 
 #include "Matrix.hpp"
+#include "Mat.hpp"
 
 
 class TestMat
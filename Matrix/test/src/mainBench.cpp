@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// mainBench.cpp
+//
+// Overview:
+//  Entry point for the matrix expression benchmark.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BenchMat.hpp"
+
+int main(int argc, char *argv[])
+{
+  BenchMat bench;
+
+  bench.Execute(argc, argv);
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
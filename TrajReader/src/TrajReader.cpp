@@ -0,0 +1,509 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajReader.cpp
+
+    \author     David Bruce
+
+    \brief      Memory mapped reader of run set trajectory containers.
+
+*/
+//############################################################################//
+
+#include "TrajReader.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//############################################################################//
+//
+// Function: TrajReader()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+TrajReader::TrajReader()
+{
+  pMap      = NULL;
+  mapBytes  = 0;
+  elemBytes = 0;
+
+}  // end TrajReader()
+
+//############################################################################//
+//
+// Function: ~TrajReader()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+TrajReader::~TrajReader()
+{
+  Close();
+
+}  // end ~TrajReader()
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Map the file, then read the header, channel table and run index
+//
+//############################################################################//
+bool TrajReader::Open( const char *filename )
+{
+  int               fd;
+  uint8_t           len;
+  uint32_t          idx;
+  uint32_t          qtyChannels;
+  uint32_t          qtyRuns;
+  uint64_t          pos;
+  uint64_t          end;
+  struct stat       info;
+  void             *pAddr;
+  TrajFile::Channel chan;
+  TrajSet::RunEntry entry;
+
+  Close();
+
+  if ( !TrajFile::HostLittleEndian() )
+  {
+    return false;
+  }
+
+  fd = open( filename, O_RDONLY );
+
+  if ( fd < 0 )
+  {
+    return false;
+  }
+
+  if ( (fstat( fd, &info ) != 0) || (info.st_size < TRAJ_SET_HEADER_BYTES) )
+  {
+    close( fd );
+
+    return false;
+  }
+
+  pAddr = mmap( NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+
+  close( fd );
+
+  if ( pAddr == MAP_FAILED )
+  {
+    return false;
+  }
+
+  pMap     = static_cast<const unsigned char *>( pAddr );
+  mapBytes = info.st_size;
+
+  //
+  // Header.  An index offset of zero is a set that never closed.
+  //
+  elemBytes   = Get<uint32_t>( 12 );
+  qtyRuns     = Get<uint32_t>( 16 );
+  qtyChannels = Get<uint32_t>( 20 );
+  pos         = Get<uint64_t>( 24 );
+
+  if ( (memcmp( pMap, TRAJ_SET_MAGIC, sizeof(TRAJ_SET_MAGIC) ) != 0) ||
+       (Get<uint32_t>( 8 ) != TRAJ_VERSION) ||
+       ((elemBytes != 4) && (elemBytes != 8)) ||
+       (pos < TRAJ_SET_HEADER_BYTES) || (pos > mapBytes) )
+  {
+    Close();
+
+    return false;
+  }
+
+  //
+  // Channel table
+  //
+  for ( idx = 0; idx < qtyChannels; ++idx )
+  {
+    if ( pos + 2 > mapBytes )
+    {
+      Close();
+
+      return false;
+    }
+
+    chan.flags = pMap[pos++];
+    len        = pMap[pos++];
+
+    if ( pos + len + 1 > mapBytes )
+    {
+      Close();
+
+      return false;
+    }
+
+    chan.name.assign( reinterpret_cast<const char *>( pMap + pos ), len );
+    pos += len;
+
+    len  = pMap[pos++];
+
+    if ( pos + len > mapBytes )
+    {
+      Close();
+
+      return false;
+    }
+
+    chan.units.assign( reinterpret_cast<const char *>( pMap + pos ), len );
+    pos += len;
+
+    channels.push_back( chan );
+  }
+
+  //
+  // Run index.  Every run must lie inside the data.
+  //
+  if ( pos + static_cast<uint64_t>( qtyRuns ) * 24 > mapBytes )
+  {
+    Close();
+
+    return false;
+  }
+
+  for ( idx = 0; idx < qtyRuns; ++idx, pos += 24 )
+  {
+    entry.run    = Get<int32_t>( pos );
+    entry.rows   = Get<uint32_t>( pos + 4 );
+    entry.offset = Get<uint64_t>( pos + 8 );
+    entry.bytes  = Get<uint64_t>( pos + 16 );
+
+    end = entry.offset;
+
+    for ( uint32_t jdx = 0; jdx < qtyChannels; ++jdx )
+    {
+      end += TrajSet::ColumnBytes( channels[jdx], entry.rows, elemBytes );
+    }
+
+    if ( (entry.offset % 8 != 0) || (end != entry.offset + entry.bytes) ||
+         (end > Get<uint64_t>( 24 )) )
+    {
+      Close();
+
+      return false;
+    }
+
+    runs.push_back( entry );
+  }
+
+  return true;
+
+}  // end Open()
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Unmap the file
+//
+//############################################################################//
+void TrajReader::Close()
+{
+  if ( pMap != NULL )
+  {
+    munmap( const_cast<unsigned char *>( pMap ), mapBytes );
+  }
+
+  pMap      = NULL;
+  mapBytes  = 0;
+  elemBytes = 0;
+
+  channels.clear();
+  runs.clear();
+
+}  // end Close()
+
+//############################################################################//
+//
+// Function: FindChannel()
+//
+// Purpose:  Index of the named channel
+//
+//############################################################################//
+int TrajReader::FindChannel( const char *name ) const
+{
+  int chan;
+
+  for ( chan = 0; chan < channels.size(); ++chan )
+  {
+    if ( channels[chan].name == name )
+    {
+      return chan;
+    }
+  }
+
+  return -1;
+
+}  // end FindChannel()
+
+//############################################################################//
+//
+// Function: FindRun()
+//
+// Purpose:  Index of a run number
+//
+//############################################################################//
+int TrajReader::FindRun( int run ) const
+{
+  int lo(0);
+  int hi( static_cast<int>( runs.size() ) - 1 );
+  int mid;
+
+  while ( lo <= hi )
+  {
+    mid = ( lo + hi ) / 2;
+
+    if ( runs[mid].run == run )
+    {
+      return mid;
+    }
+    else if ( runs[mid].run < run )
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+
+  return -1;
+
+}  // end FindRun()
+
+//############################################################################//
+//
+// Function: Column()
+//
+// Purpose:  Span of a channel column of a run
+//
+//############################################################################//
+TrajReader::ColumnSpan TrajReader::Column( int runIdx,
+                                           int chan ) const
+{
+  int        idx;
+  uint64_t   offset;
+  ColumnSpan span;
+
+  const TrajSet::RunEntry &entry = runs[runIdx];
+
+  offset = entry.offset;
+
+  for ( idx = 0; idx < chan; ++idx )
+  {
+    offset += TrajSet::ColumnBytes( channels[idx], entry.rows, elemBytes );
+  }
+
+  span.pData = pMap + offset;
+  span.rows  = entry.rows;
+
+  if ( channels[chan].flags & TRAJ_INTEGER )
+  {
+    span.type = I32_COL;
+  }
+  else
+  {
+    span.type = ( elemBytes == 4 ) ? F32_COL : F64_COL;
+  }
+
+  return span;
+
+}  // end Column()
+
+//############################################################################//
+//
+// Function: Envelopes()
+//
+// Purpose:  Mean and standard deviation of channels across the runs
+//
+//############################################################################//
+bool TrajReader::Envelopes( const vector<int> &chans,
+                            int                timeChan,
+                            double            &timeStep,
+                            double            &time0,
+                            int                qtyThreads,
+                            vector<Envelope>  &envs ) const
+{
+  int                                   bin;
+  int                                   chan;
+  int                                   qtyBins(0);
+  int                                   runIdx;
+  int                                   thread;
+  ColumnSpan                            time;
+  vector<std::thread>                   pool;
+  vector< vector< vector<Welford> > >   accum;
+
+  if ( runs.empty() || (timeChan < 0) || (timeChan >= channels.size()) )
+  {
+    return false;
+  }
+
+  //
+  // The time grid starts at the first run's first time, and steps by its
+  // first step unless one is given
+  //
+  time  = Column( 0, timeChan );
+
+  if ( time.rows == 0 )
+  {
+    return false;
+  }
+
+  time0 = time[0];
+
+  if ( (timeStep <= 0.0) && (time.rows > 1) )
+  {
+    timeStep = time[1] - time[0];
+  }
+
+  if ( timeStep <= 0.0 )
+  {
+    return false;
+  }
+
+  for ( runIdx = 0; runIdx < runs.size(); ++runIdx )
+  {
+    time = Column( runIdx, timeChan );
+
+    if ( time.rows > 0 )
+    {
+      bin = static_cast<int>( lround( ( time[time.rows - 1] - time0 ) /
+                                      timeStep ) );
+      qtyBins = std::max( qtyBins, bin + 1 );
+    }
+  }
+
+  //
+  // Each thread takes every qtyThreads'th run into its own accumulators
+  //
+  qtyThreads = std::max( 1, std::min( qtyThreads, QtyRuns() ) );
+
+  accum.assign( qtyThreads, vector< vector<Welford> >( chans.size(),
+                                     vector<Welford>( qtyBins ) ) );
+
+  for ( thread = 1; thread < qtyThreads; ++thread )
+  {
+    pool.push_back( std::thread( &TrajReader::EnvelopeRuns, this,
+                                 std::cref( chans ), timeChan, timeStep,
+                                 time0, thread, qtyThreads,
+                                 std::ref( accum[thread] ) ) );
+  }
+
+  EnvelopeRuns( chans, timeChan, timeStep, time0, 0, qtyThreads, accum[0] );
+
+  for ( thread = 1; thread < qtyThreads; ++thread )
+  {
+    pool[thread - 1].join();
+
+    for ( chan = 0; chan < chans.size(); ++chan )
+    {
+      for ( bin = 0; bin < qtyBins; ++bin )
+      {
+        accum[0][chan][bin].Merge( accum[thread][chan][bin] );
+      }
+    }
+  }
+
+  envs.assign( chans.size(), Envelope() );
+
+  for ( chan = 0; chan < chans.size(); ++chan )
+  {
+    envs[chan].mean.resize( qtyBins );
+    envs[chan].stdDev.resize( qtyBins );
+    envs[chan].count.resize( qtyBins );
+
+    for ( bin = 0; bin < qtyBins; ++bin )
+    {
+      envs[chan].mean[bin]   = accum[0][chan][bin].Mean();
+      envs[chan].stdDev[bin] = accum[0][chan][bin].StdDev();
+      envs[chan].count[bin]  = accum[0][chan][bin].Count();
+    }
+  }
+
+  return true;
+
+}  // end Envelopes()
+
+//############################################################################//
+//
+// Function: EnvelopeRuns()
+//
+// Purpose:  Accumulate a share of the runs, a run at a time so each column
+//           is read once, in order
+//
+//############################################################################//
+void TrajReader::EnvelopeRuns( const vector<int>         &chans,
+                               int                        timeChan,
+                               double                     timeStep,
+                               double                     time0,
+                               int                        firstRun,
+                               int                        stride,
+                               vector< vector<Welford> > &accum ) const
+{
+  int            bin;
+  int            chan;
+  int            lastBin;
+  int            runIdx;
+  uint32_t       row;
+  double         grid;
+  ColumnSpan     time;
+  ColumnSpan     col;
+  vector<int>    rowBin;
+
+  for ( runIdx = firstRun; runIdx < runs.size(); runIdx += stride )
+  {
+    time = Column( runIdx, timeChan );
+
+    //
+    // Output time of each row, -1 off the grid or repeating a time
+    //
+    rowBin.assign( time.rows, -1 );
+
+    lastBin = -1;
+
+    for ( row = 0; row < time.rows; ++row )
+    {
+      bin  = static_cast<int>( lround( ( time[row] - time0 ) / timeStep ) );
+      grid = time0 + bin * timeStep;
+
+      if ( (bin > lastBin) && (bin < accum[0].size()) &&
+           (fabs( time[row] - grid ) <= 0.01 * timeStep) )
+      {
+        rowBin[row] = bin;
+        lastBin     = bin;
+      }
+    }
+
+    for ( chan = 0; chan < chans.size(); ++chan )
+    {
+      col = Column( runIdx, chans[chan] );
+
+      for ( row = 0; row < col.rows; ++row )
+      {
+        if ( rowBin[row] >= 0 )
+        {
+          accum[chan][rowBin[row]].Add( col[row] );
+        }
+      }
+    }
+  }
+
+}  // end EnvelopeRuns()
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,230 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajReader.hpp
+
+    \author     David Bruce
+
+    \brief      Memory mapped reader of run set trajectory containers.
+
+    A run set container, see TrajSet.hpp, is mapped read only and the
+    column of any channel of any run is handed out as a span straight into
+    the mapping.  Nothing is parsed or copied, so opening a set costs the
+    index only and the pages of a column are read when it is first used.
+    The file is little endian, so the reader opens nothing on big endian
+    hosts.
+
+    Envelopes() reduces channels across the runs of the set: the mean and
+    standard deviation of each channel at each output time, in one pass
+    over the runs shared by a pool of threads.
+
+*/
+//############################################################################//
+
+#ifndef TRAJREADER_HPP
+#define TRAJREADER_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <cstdint>
+#include <cstring>
+#include <vector>
+using std::vector;
+
+//
+// Sim includes
+//
+#include "RunStats.hpp"
+#include "TrajFile.hpp"
+#include "TrajSet.hpp"
+
+class TrajReader
+{
+public:
+
+  //
+  // Storage of a column
+  //
+  typedef enum _col_type_
+  {
+    F64_COL,        // 0 = float64
+    F32_COL,        // 1 = float32
+    I32_COL         // 2 = int32
+  } ColType;
+
+  //
+  // A channel column of one run, pointing into the mapping
+  //
+  typedef struct _column_span_
+  {
+    const void *pData;      // na  First value of the column
+    uint32_t    rows;       // na  Quantity of values
+    ColType     type;       // na  Storage of the values
+
+    double operator[]( uint32_t row ) const
+    {
+      switch ( type )
+      {
+        case F64_COL: return static_cast<const double *>( pData )[row];
+        case F32_COL: return static_cast<const float *>( pData )[row];
+        default:      return static_cast<const int32_t *>( pData )[row];
+      }
+    }
+  } ColumnSpan;
+
+  //
+  // Envelope of a channel across the runs, one entry per output time
+  //
+  typedef struct _envelope_
+  {
+    vector<double> mean;    // na  Mean across the runs
+    vector<double> stdDev;  // na  Sample standard deviation across the runs
+    vector<long>   count;   // na  Quantity of runs with a value
+  } Envelope;
+
+//############################################################################//
+//
+// Function: TrajReader()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+  TrajReader();
+
+//############################################################################//
+//
+// Function: ~TrajReader()
+//
+// Purpose:  Destructor.  Unmaps the file if open.
+//
+//############################################################################//
+  ~TrajReader();
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Map a run set container and read its index.  Returns false if
+//           the file cannot be mapped, is not a closed run set or does not
+//           fit its index.
+//
+//############################################################################//
+  bool Open( const char *filename );
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Unmap the file
+//
+//############################################################################//
+  void Close();
+
+  bool IsOpen() const { return pMap != NULL; }
+
+  int QtyRuns() const { return static_cast<int>( runs.size() ); }
+
+  int QtyChannels() const { return static_cast<int>( channels.size() ); }
+
+  int ElemBytes() const { return static_cast<int>( elemBytes ); }
+
+  const TrajFile::Channel &GetChannel( int chan ) const
+  {
+    return channels[chan];
+  }
+
+  const TrajSet::RunEntry &GetRun( int runIdx ) const
+  {
+    return runs[runIdx];
+  }
+
+//############################################################################//
+//
+// Function: FindChannel()
+//
+// Purpose:  Index of the named channel, -1 if there is none
+//
+//############################################################################//
+  int FindChannel( const char *name ) const;
+
+//############################################################################//
+//
+// Function: FindRun()
+//
+// Purpose:  Index of a run number by a binary search of the run ordered
+//           index, -1 if the run is not in the set
+//
+//############################################################################//
+  int FindRun( int run ) const;
+
+//############################################################################//
+//
+// Function: Column()
+//
+// Purpose:  Span of a channel column of a run, by run index
+//
+//############################################################################//
+  ColumnSpan Column( int runIdx, int chan ) const;
+
+//############################################################################//
+//
+// Function: Envelopes()
+//
+// Purpose:  Mean and standard deviation of channels across the runs at each
+//           output time.  A value belongs to output time
+//           time0 + k * timeStep when its time channel value is within a
+//           hundredth of a step of it, so the off grid final row of a run
+//           is left out.  A timeStep of zero takes the step of the first
+//           run.  The runs are shared by qtyThreads threads, each
+//           accumulating its own envelopes, merged at the end.
+//
+//############################################################################//
+  bool Envelopes( const vector<int> &chans,
+                  int                timeChan,
+                  double            &timeStep,
+                  double            &time0,
+                  int                qtyThreads,
+                  vector<Envelope>  &envs ) const;
+
+private:
+
+//############################################################################//
+//
+// Function: EnvelopeRuns()
+//
+// Purpose:  Accumulate the runs firstRun, firstRun + stride, ... of an
+//           envelope
+//
+//############################################################################//
+  void EnvelopeRuns( const vector<int>         &chans,
+                     int                        timeChan,
+                     double                     timeStep,
+                     double                     time0,
+                     int                        firstRun,
+                     int                        stride,
+                     vector< vector<Welford> > &accum ) const;
+
+  template <class T>
+  T Get( uint64_t offset ) const
+  {
+    T value;
+
+    memcpy( &value, pMap + offset, sizeof(T) );
+
+    return value;
+  }
+
+  const unsigned char      *pMap;      // na  Mapping of the file
+  uint64_t                  mapBytes;  // na  Size of the mapping
+  uint32_t                  elemBytes; // na  Bytes per real value
+  vector<TrajFile::Channel> channels;  // na  Channel table
+  vector<TrajSet::RunEntry> runs;      // na  Run index, in run order
+};
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
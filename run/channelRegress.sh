@@ -0,0 +1,40 @@
+#! /bin/bash
+#
+# channelRegress.sh
+#
+# Overview:
+#  Regression of the output channel selection.  Selects channels with
+#  ex.channels from an input file, with Unix and with DOS line ends, and on
+#  the command line.  Fails unless each run writes the same header of the
+#  selected channels.
+#
+#  Usage:  channelRegress.sh
+#
+################################################################################
+
+pattern='msl.p?f'
+expect='simTime seed msl.pxf msl.pyf'
+stub=chanRegress
+status=0
+
+printf 'ex.channels=%s\n' "$pattern"   > $stub.inp
+printf 'ex.channels=%s\r\n' "$pattern" > $stub-dos.inp
+
+for input in "ex.file=$stub.inp" "ex.file=$stub-dos.inp" "ex.channels=$pattern"
+do
+  ./p3dof ex.runs=1 ex.outputRate=10 ex.fileStub=$stub $input > /dev/null
+
+  header=`head -1 $stub-00001.dat | tr -s ' \r' ' ' | sed 's/^ //;s/ $//'`
+
+  if [ "$header" == "$expect" ]
+  then
+    echo "PASS  $input"
+  else
+    echo "FAIL  $input  header: $header"
+    status=1
+  fi
+done
+
+rm -f $stub.inp $stub-dos.inp $stub-00001.dat
+
+exit $status
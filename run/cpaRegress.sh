@@ -0,0 +1,38 @@
+#! /bin/bash
+#
+# cpaRegress.sh
+#
+# Overview:
+#  Regression of the closest point of approach solve.  Compares the run set
+#  miss statistics of the legacy intercept test at ex.dt=1e-3 against the
+#  closest point of approach solve at ex.dt=1e-2.  Fails when the average
+#  miss differs by more than missTol or pHit by more than pHitTol.
+#
+#  Usage:  cpaRegress.sh [runs]
+#
+################################################################################
+
+runs=${1:-100}
+missTol=0.01
+pHitTol=0.02
+
+ref=`./p3dof ex.runs=$runs ex.dt=1e-3 | tail -2 | head -1`
+cpa=`./p3dof ex.runs=$runs ex.dt=1e-2 ex.cpa=true | tail -2 | head -1`
+
+./p3dof ex.runs=1 | tail -3 | head -1
+echo "$ref  ex.dt=1e-3"
+echo "$cpa  ex.dt=1e-2 ex.cpa=true"
+
+echo "$ref $cpa" | awk -v missTol=$missTol -v pHitTol=$pHitTol '
+{
+  dPhit = $2 - $18;  if ( dPhit < 0 ) dPhit = -dPhit;
+  dMiss = $8 - $24;  if ( dMiss < 0 ) dMiss = -dMiss;
+
+  if ( dPhit > pHitTol || dMiss > missTol )
+  {
+    printf("FAIL  pHit diff %.3f  avgMissMag diff %.3f\n", dPhit, dMiss);
+    exit 1;
+  }
+
+  printf("PASS  pHit diff %.3f  avgMissMag diff %.3f\n", dPhit, dMiss);
+}'
@@ -69,6 +69,14 @@ MdlBase()
   RegisterState( x1, x1d );
   RegisterState( x2, x2d );
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "ap.accLim", "m/sec^2", accLim );
+  RegisterChannel( "ap.aCmdYbLim", "m/sec^2", aCmdYbLim );
+  RegisterChannel( "ap.ayb", "m/sec^2", ayb );
+  RegisterChannel( "ap.tau", "sec", tau );
+
 }  // end Autopilot()
 
 //############################################################################//
@@ -170,35 +178,6 @@ void Autopilot::Finalize()
   simTime = GetSimTime();
 } 
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void Autopilot::Output( bool printHeader,
-                        FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "ap.accLim" );
-    fprintf( pOutFile, "%20s", "ap.aCmdYbLim");
-    fprintf( pOutFile, "%20s", "ap.ayb" );
-    fprintf( pOutFile, "%20s", "ap.tau" );
-  }
-  else
-  {
-    fprintf(pOutFile, "%20.6e", accLim );
-    fprintf(pOutFile, "%20.6e", aCmdYbLim );
-    fprintf(pOutFile, "%20.6e", ayb );
-    fprintf(pOutFile, "%20.6e", tau );
-
-  } // end if ( printHeader ) else
-}  // end Output()
-
 //############################################################################//
 //
 // Function: ResetAll()
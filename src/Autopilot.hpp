@@ -121,13 +121,15 @@ public:
 
 //############################################################################//
 //
-// Function: Output()
+// Function: GetStateAyb()
 //
-// Purpose:  Print selected variables
+// Purpose:  Achieved lateral acceleration from the current integration
+//           state.  Unlike ayb, which is set in Update(), this follows the
+//           intermediate states inside an integration step.
 //
 //############################################################################//
-  void Output( bool printHeader,
-               FILE *outfile );
+  double GetStateAyb()
+  { return x0; }
 
 //############################################################################//
 //
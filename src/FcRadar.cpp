@@ -24,6 +24,7 @@
 //
 // Reference includes
 //
+#include "Random.hpp"
 #include "SimExec.hpp"
 #include "Target.hpp"
 
@@ -63,6 +64,25 @@ FcRadar::FcRadar()
   // Other variable initialization
   //
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "fcRdr.measAng", "rad", measAng );
+  RegisterChannel( "fcRdr.measRdot", "m/sec", measRdot );
+  RegisterChannel( "fcRdr.measRng", "m", measRng );
+  RegisterChannel( "fcRdr.timeStamp", "sec", timeStamp );
+  RegisterChannel( "fcRdr.pxf", "m", pxf );
+  RegisterChannel( "fcRdr.pyf", "m", pyf );
+  RegisterChannel( "fcRdr.rinAng", "rad", rinAng );
+  RegisterChannel( "fcRdr.rinRdot", "m/sec", rinRdot );
+  RegisterChannel( "fcRdr.rinRng", "m", rinRng );
+  RegisterChannel( "fcRdr.truAng", "rad", truAng );
+  RegisterChannel( "fcRdr.truPosY", "m", truPosY );
+  RegisterChannel( "fcRdr.truRdot", "m/sec", truRdot );
+  RegisterChannel( "fcRdr.truRng", "m", truRng );
+  RegisterChannel( "fcRdr.vxf", "m/sec", vxf );
+  RegisterChannel( "fcRdr.vyf", "m/sec", vyf );
+
 }
 
 //############################################################################//
@@ -126,11 +146,11 @@ void FcRadar::FrameUpdate()
 
   truRdot = ( relVelX * relPosX + relVelY * relPosY ) / truRng;
   
-  measAng = gaussian( truAng, rinAng, &pExec->seed );
+  measAng = pRng->Gaussian( truAng, rinAng );
               
-  measRdot = gaussian( truRdot, rinRdot, &pExec->seed );
+  measRdot = pRng->Gaussian( truRdot, rinRdot );
 
-  measRng = gaussian( truRng, rinRng, &pExec->seed );
+  measRng = pRng->Gaussian( truRng, rinRng );
 
   timeStamp = simTime;
               
@@ -171,64 +191,6 @@ void FcRadar::Finalize()
 
 }
  
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void FcRadar::Output( bool printHeader,
-                      FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "fcRdr.measAng");
-    fprintf( pOutFile, "%20s", "fcRdr.measRdot");
-    fprintf( pOutFile, "%20s", "fcRdr.measRng");
-    fprintf( pOutFile, "%20s", "fcRdr.timeStamp");
-
-    fprintf( pOutFile, "%20s", "fcRdr.pxf");
-    fprintf( pOutFile, "%20s", "fcRdr.pyf");
-
-    fprintf( pOutFile, "%20s", "fcRdr.rinAng");
-    fprintf( pOutFile, "%20s", "fcRdr.rinRdot");
-    fprintf( pOutFile, "%20s", "fcRdr.rinRng");
-
-    fprintf( pOutFile, "%20s", "fcRdr.truAng");
-    fprintf( pOutFile, "%20s", "fcRdr.truPosY");
-    fprintf( pOutFile, "%20s", "fcRdr.truRdot");
-    fprintf( pOutFile, "%20s", "fcRdr.truRng");
-
-    fprintf( pOutFile, "%20s", "fcRdr.vxf");
-    fprintf( pOutFile, "%20s", "fcRdr.vyf");
-  }
-  else
-  {
-    fprintf( pOutFile, "%20.6e", measAng );
-    fprintf( pOutFile, "%20.6e", measRdot );
-    fprintf( pOutFile, "%20.6e", measRng );
-    fprintf( pOutFile, "%20.6e", timeStamp );
-
-    fprintf( pOutFile, "%20.6e", pxf );
-    fprintf( pOutFile, "%20.6e", pyf );
-
-    fprintf( pOutFile, "%20.6e", rinAng );
-    fprintf( pOutFile, "%20.6e", rinRdot );
-    fprintf( pOutFile, "%20.6e", rinRng );
-
-    fprintf( pOutFile, "%20.6e", truAng );
-    fprintf( pOutFile, "%20.6e", truPosY );
-    fprintf( pOutFile, "%20.6e", truRdot );
-    fprintf( pOutFile, "%20.6e", truRng );
-    fprintf( pOutFile, "%20.6e", vxf );
-    fprintf( pOutFile, "%20.6e", vyf );
-  }
-}  // end Output()
-
-
 //
 // Class scope functions
 //
@@ -247,6 +209,7 @@ void FcRadar::ResetAll()
   measRdot  = 0.0;
   pxf       = 0.0;
   pyf       = 0.0; 
+  timeStamp = 0.0;
   truAng    = 0.0;
   truPosX   = 0.0;
   truPosY   = 0.0;
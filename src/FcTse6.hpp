@@ -20,7 +20,8 @@
 // Sim includes
 //
 //#include "genMath.h"
-#include "Matrix.hpp"
+#include "Mat.hpp"
+#include "MscEkf.hpp"
 
 //
 // Forward declarations
@@ -47,13 +48,14 @@ public:
   //
   double  initFrameTime; // sec     Time of first FrameUpdate
 
+  int     covFormInt;  // na        Covariance form 1=joseph, 2=ud
   double  singerTau;   // sec       Kalman process noise tuning parameter
   double  singerVar;   // (m/s^2)^2 Kalman process noise tuning parameter
 
   //
   // Other public scope variables
   //
-  Matrix  cartRel;     // na     Cartesian state vector
+  MscEkf<double> ekf;  // na     MSC extended Kalman filter
 
   double  estAccX;     // m/sec^2   Estimated acceleration along LOS
   double  estAccY;     // m/sec^2   Estimated acceleration across LOS 
@@ -73,7 +75,7 @@ public:
   double  truRng;      // m         True range                   
   double  truRdot;;    // m/sec     True range rate              
 
-  Matrix  truState;    // na        True MSC state
+  Mat<6,1> truState;   // na        True MSC state
 
 //############################################################################//
 //
@@ -140,16 +142,6 @@ public:
 //############################################################################//
   virtual void Finalize();
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-  void Output( bool printHeader,
-               FILE *outfile );
-
 //############################################################################//
 //
 // Function: SetRadar()
@@ -215,44 +207,6 @@ private:
 //############################################################################//
   void UpdateStates();
 
-//############################################################################//
-//
-// Function: IntegrateRK2()
-//
-// Purpose:  2nd order Runge Kutta integrator
-//
-//############################################################################//
-  void IntegrateRK2( Matrix &XX, double timeStep );
-
-//############################################################################//
-//
-// Function: StateDeriv()
-//
-// Purpose:  Calculate the state derivative
-//
-//############################################################################//
-  Matrix CalcStateDeriv( Matrix &XX );
-
-//############################################################################//
-//
-// Function: MscToCart()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-  void MscToCart( Matrix &mscState,
-                  Matrix &cartRel );
-
-//############################################################################//
-//
-// Function: CartToMsc()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-  void CartToMsc( Matrix &cartRel,
-                  Matrix &mscState );
-
 //############################################################################//
 //
 // Function: ResetAll()
@@ -266,23 +220,11 @@ private:
   // Class scope variables
   //
   double   angSig;     // rad    Measured angle standard deviation
-  Matrix   eye;        // na     Identity matrix
-  Matrix   HH;         // na     Measurement matrix
-  Matrix   HT;         // na     Transpose of the measurement matrix
-  bool     initialized;// na     Filter has been initialized.
-  Matrix   innovation; // na     Kalman innovation
-  Matrix   KK;         // na     Kalman gains
   double   measAng;    // rad    Measure LOS angle
   double   measRng;    // m      Measured range
   double   measRdot;   // m/sec  Measured range rate
-  Matrix   measVec;    // na     Measurement vector
-  Matrix   mscState;   // na     Modified spherical coordates state vector
-  Matrix   phi;        // na     State transition matrix
-  Matrix   PP;         // na     Estimation covariance matrix
   double   rDotSig;    // m/sec  Measured range rate standard deviation
-  Matrix   residual;   // ns     Update residual
   double   rngSig;     // m      Measured range standard deviation
-  Matrix   RR;         // na     Measurement covariance matrix
   double   simTime;    // sec    Simulation time
 
   //
@@ -293,15 +235,6 @@ private:
   Target   *pTgt;      // Target truth
 };
 
-//############################################################################//
-//
-// Function: inv33()
-//
-// Purpose:  Safely invert a 3x3 matrix using Gaussian elimination.
-//
-//############################################################################//
-bool inv33(Matrix &matIn, Matrix &matOut );
-
 #endif
 
 //############################################################################//
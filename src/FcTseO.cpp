@@ -30,7 +30,8 @@
 //
 //#include "genMath.h"
 //using namespace genMath;
-#include "Matrix.hpp"
+#include "Mat.hpp"
+#include "UdFactor.hpp"
 using namespace MATRIX;
 
 #include "MathUtils.hpp"
@@ -51,6 +52,7 @@ FcTseO::FcTseO()
   frameTimeStep = 1.0/64.0;
   initFrameTime = 0.0;
 
+  covFormInt = 1;
   initOmega = 4.0;
   initPosY = 0.0;
   initPosYsigScale = 1.4;
@@ -60,18 +62,24 @@ FcTseO::FcTseO()
 //  procNoise = 0.1e-3;
   procNoise = 0.0128;
 
+  eye.Eye();
+
   //
-  // Set matrix sizes.
+  // Register output channels
   //
-  eye.Eye(3);
-  HH.Resize(1,3);
-  HT.Resize(3,1);
-  innovation.Resize(3,1);
-  KK.Resize(3,1);
-  phi.Resize(3,3);
-  PP.Resize(3,3);
-  QQ.Resize(3,3);
-  stateVec.Resize(3,1);
+  RegisterChannel( "fcTseO.measPosY", "m", measPosY );
+  RegisterChannel( "fcTseO.residual", "m", residual );
+  RegisterChannel( "fcTseO.RR00", "m^2", RR );
+  RegisterChannel( "fcTseO.estPosY", "m", estPosY );
+  RegisterChannel( "fcTseO.estPosYdot", "m/sec", estPosYdot );
+  RegisterChannel( "fcTseO.estOmega2", "rad^2/sec^2", estOmega2 );
+  RegisterChannel( "fcTseO.estOmega", "rad/sec", estOmega );
+  RegisterChannel( "fcTseO.P00", "m^2", PP[0][0] );
+  RegisterChannel( "fcTseO.P11", "m^2/sec^2", PP[1][1] );
+  RegisterChannel( "fcTseO.P22", "rad^4/sec^4", PP[2][2] );
+  RegisterChannel( "fcTseO.K0", "na", KK[0][0] );
+  RegisterChannel( "fcTseO.K1", "1/sec", KK[1][0] );
+  RegisterChannel( "fcTseO.K2", "rad^2/sec^2/m", KK[2][0] );
 
 }
 
@@ -104,6 +112,8 @@ void FcTseO::Initialize()
 
   nextFrameTime = initFrameTime;
 
+  covForm = static_cast<UD_FACTOR::CovForm>( covFormInt );
+
   HH = 0.0;
   HH[0][0] = 1.0;
 
@@ -150,6 +160,11 @@ void FcTseO::FrameUpdate()
     PP[0][0] = SQ( initPosYsigScale * rinPosY );
     PP[1][1] = SQ( initVelYsig );
     PP[2][2] = SQ( initWsig );
+
+    if ( covForm == UD_FACTOR::cfUD )
+    {
+      UD_FACTOR::Factor( PP, UU, DD );
+    }
   }
 
   PropStates( frameTimeStep );
@@ -197,53 +212,6 @@ void FcTseO::Finalize()
   simTime = GetSimTime();
 }
  
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void FcTseO::Output( bool printHeader,
-                    FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "fcTseO.measPosY");
-    fprintf( pOutFile, "%20s", "fcTseO.residual");
-    fprintf( pOutFile, "%20s", "fcTseO.RR00");
-    fprintf( pOutFile, "%20s", "fcTseO.estPosY");
-    fprintf( pOutFile, "%20s", "fcTseO.estPosYdot");
-    fprintf( pOutFile, "%20s", "fcTseO.estOmega2");
-    fprintf( pOutFile, "%20s", "fcTseO.estOmega");
-    fprintf( pOutFile, "%20s", "fcTseO.P00");
-    fprintf( pOutFile, "%20s", "fcTseO.P11");
-    fprintf( pOutFile, "%20s", "fcTseO.P22");
-    fprintf( pOutFile, "%20s", "fcTseO.K0");
-    fprintf( pOutFile, "%20s", "fcTseO.K1");
-    fprintf( pOutFile, "%20s", "fcTseO.K2");
-  }
-  else
-  {
-    fprintf( pOutFile, "%20.6e", measPosY );
-    fprintf( pOutFile, "%20.6e", residual );
-    fprintf( pOutFile, "%20.6e", RR );
-    fprintf( pOutFile, "%20.6e", estPosY );
-    fprintf( pOutFile, "%20.6e", estPosYdot );
-    fprintf( pOutFile, "%20.6e", estOmega2 );
-    fprintf( pOutFile, "%20.6e", estOmega );
-    fprintf( pOutFile, "%20.6e", PP[0][0] );
-    fprintf( pOutFile, "%20.6e", PP[1][1] );
-    fprintf( pOutFile, "%20.6e", PP[2][2] );
-    fprintf( pOutFile, "%20.6e", KK[0][0] );
-    fprintf( pOutFile, "%20.6e", KK[1][0] );
-    fprintf( pOutFile, "%20.6e", KK[2][0] );
-  }
-}  // end Output()
-
-
 //
 // Class scope functions
 //
@@ -257,6 +225,12 @@ void FcTseO::Output( bool printHeader,
 //############################################################################//
   void FcTseO::PropStates( double timeStep )
 {
+  Mat<3,1> DQ;
+  Mat<6,1> DW;
+  Mat<3,3> phiU;
+  Mat<3,3> UQ;
+  Mat<3,6> WW;
+
   double timeStep2 = timeStep * timeStep;
   double timeStep3 = timeStep2 * timeStep;
 
@@ -295,7 +269,33 @@ void FcTseO::Output( bool printHeader,
   //
   // Propagate the estimation covariance matrix
   //
-  PP = phi * PP * Transpose(phi) + QQ;
+  if ( covForm == UD_FACTOR::cfUD )
+  {
+    //
+    // W = [ phi * U | UQ ], with QQ = UQ * DQ * UQ'
+    //
+    UD_FACTOR::Factor( QQ, UQ, DQ );
+
+    phiU = phi * UU;
+
+    for ( int row = 0; row < 3; ++row )
+    {
+      for ( int col = 0; col < 3; ++col )
+      {
+        WW[row][col] = phiU[row][col];
+        WW[row][col + 3] = UQ[row][col];
+      }
+
+      DW(row) = DD(row);
+      DW(row + 3) = DQ(row);
+    }
+
+    UD_FACTOR::TimeUpdate( WW, DW, UU, DD );
+  }
+  else
+  {
+    PP = phi * PP * Transpose(phi) + QQ;
+  }
 
 }
 
@@ -309,15 +309,35 @@ void FcTseO::Output( bool printHeader,
 //############################################################################//
 void FcTseO::UpdateStates( double measPosY )
 {
+  Mat<3,1> hh;
   double   temp0;
-  Matrix   temp1(3,3);
-  Matrix   temp2(3,3);
+  Mat<3,3> temp1;
+  Mat<3,3> temp2;
 
 //  RR = SQ( rinPosY );
 // TBD RR is wrong, but it works better.  Maybe process noise or initial PP
 // is too low?
   RR = rinPosY;
 
+  if ( covForm == UD_FACTOR::cfUD )
+  {
+    hh = 0.0;
+    hh(0) = 1.0;
+
+    residual = measPosY - stateVec(0);
+
+    if ( UD_FACTOR::MeasUpdate( hh, RR, UU, DD, KK ) )
+    {
+      innovation = KK * residual;
+
+      stateVec += innovation;
+    }
+
+    UD_FACTOR::Compose( UU, DD, PP );
+
+    return;
+  }
+
   //
   // Calculate the Kalman gains.
   //
@@ -383,13 +403,13 @@ void FcTseO::UpdateStates( double measPosY )
 // Purpose:  2nd order Runge Kutta integrator
 //
 //############################################################################//
-Matrix FcTseO::IntegrateRK2( Matrix &XX, double deltaTime  )
+Mat<3,1> FcTseO::IntegrateRK2( Mat<3,1> &XX, double deltaTime  )
 {
   double   half = 0.5;
-  Matrix   stateDerivK(3,1);
-  Matrix   stateDerivKp1(3,1);
-  Matrix   stateIncrement(3,1);
-  Matrix   stateTemp(3,1);
+  Mat<3,1> stateDerivK;
+  Mat<3,1> stateDerivKp1;
+  Mat<3,1> stateIncrement;
+  Mat<3,1> stateTemp;
 
   //
   // Get derivative at current time
@@ -428,9 +448,9 @@ Matrix FcTseO::IntegrateRK2( Matrix &XX, double deltaTime  )
 //   accY = -X2*X0 = -A * omega^2 * sin( omega * t )
 //  
 //############################################################################//
-Matrix FcTseO::CalcStateDeriv( Matrix &XX )
+Mat<3,1> FcTseO::CalcStateDeriv( Mat<3,1> &XX )
 {
-  Matrix deriv(3,1);
+  Mat<3,1> deriv;
                              // posY = A*sin(w*t)
 
   deriv(0) = XX(1);          // d/dt( posY ) = velY = w*A*cos(w*t) 
@@ -451,6 +471,8 @@ Matrix FcTseO::CalcStateDeriv( Matrix &XX )
 //############################################################################//
 void FcTseO::ResetAll()
 {
+  covForm     = UD_FACTOR::cfNULL;
+  DD          = 0.0;
   estPosY     = 0.0;
   estPosYdot  = 0.0;
   estOmega    = 0.0;
@@ -470,6 +492,7 @@ void FcTseO::ResetAll()
   QQ          = 0.0;
   simTime     = 0.0;
   stateVec    = 0.0;
+  UU          = 0.0;
 
 }  // end ResetAll()
 
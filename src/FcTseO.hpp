@@ -20,7 +20,8 @@
 // Sim includes
 //
 //#include "genMath.h"
-#include "Matrix.hpp"
+#include "Mat.hpp"
+#include "UdFactor.hpp"
 
 //
 // Forward declarations
@@ -45,6 +46,7 @@ public:
   //
   double initFrameTime;   // sec     Time of first FrameUpdate
 
+  int    covFormInt;      // na      Covariance form 1=joseph, 2=ud
   double initOmega;       // rad/sec Initial radian frequency estimate
   double initPosY;        // m       Initial position estimate
   double initPosYsigScale; // m      Initial position std dev scaling
@@ -126,16 +128,6 @@ public:
 //############################################################################//
   virtual void Finalize();
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-  void Output( bool printHeader,
-               FILE *outfile );
-
 //############################################################################//
 //
 // Function: SetSimExec()
@@ -188,7 +180,7 @@ private:
 // Purpose:  2nd order Runge Kutta integrator
 //
 //############################################################################//
-  Matrix IntegrateRK2( Matrix &XX, double timeStep );
+  Mat<3,1> IntegrateRK2( Mat<3,1> &XX, double timeStep );
 
 //############################################################################//
 //
@@ -197,7 +189,7 @@ private:
 // Purpose:  Calculate the state derivative
 //
 //############################################################################//
-  Matrix CalcStateDeriv( Matrix &XX );
+  Mat<3,1> CalcStateDeriv( Mat<3,1> &XX );
 
 //############################################################################//
 //
@@ -211,21 +203,24 @@ private:
   //
   // Class scope variables
   //
-  Matrix   eye;        // na     Identity matrix
-  Matrix   HH;         // na     Measurement matrix
-  Matrix   HT;         // na     Transpose of the measurement matrix
+  UD_FACTOR::CovForm covForm; // na Covariance form
+  Mat<3,1> DD;         // na     UD factor diagonal
+  Mat<3,3> eye;        // na     Identity matrix
+  Mat<1,3> HH;         // na     Measurement matrix
+  Mat<3,1> HT;         // na     Transpose of the measurement matrix
   bool     initialized;// na     Filter has been initialized
-  Matrix   innovation; // na     Kalman innovation
-  Matrix   KK;         // na     Kalman gains
+  Mat<3,1> innovation; // na     Kalman innovation
+  Mat<3,1> KK;         // na     Kalman gains
   double   measPosY;   // m      Measured Y position
-  Matrix   phi;        // na     State transition matrix
-  Matrix   PP;         // na     Estimation covariance matrix
+  Mat<3,3> phi;        // na     State transition matrix
+  Mat<3,3> PP;         // na     Estimation covariance matrix
   double   residual;   // m      Update residual     
   double   rinPosY;    // m      Std dev of Y position measurement
   double   RR;         // na     Measurement covariance matrix
-  Matrix   QQ;         // na     Process noise matrix
+  Mat<3,3> QQ;         // na     Process noise matrix
   double   simTime;    // sec    Simulation time
-  Matrix   stateVec;    // na     State vector
+  Mat<3,1> stateVec;    // na     State vector
+  Mat<3,3> UU;         // na     UD factor unit upper triangle
 
   //
   // Reference pointers
@@ -77,6 +77,18 @@ MdlBase()
   tauCtrl       = 0.4;       // sec     Optimal guidance tuning parameter
   useTruth      = false;     // na      Use truth for target state
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "gdn.aCmdYb", "m/sec^2", aCmdYb );
+  RegisterChannel( "gdn.losr", "rad/sec", estLosr );
+  RegisterChannel( "gdn.rDot", "m/sec", estRdot );
+  RegisterChannel( "gdn.relPxf", "m", relPxf );
+  RegisterChannel( "gdn.relPyf", "m", relPyf );
+  RegisterChannel( "gdn.relVxf", "m/sec", relVxf );
+  RegisterChannel( "gdn.relVyf", "m/sec", relVyf );
+  RegisterChannel( "gdn.rng", "m", estRng );
+
 }  // end Guidance()
 
 //############################################################################//
@@ -339,43 +351,6 @@ void Guidance::Finalize()
   simTime = GetSimTime();
 } 
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void Guidance::Output( bool printHeader,
-                       FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "gdn.aCmdYb" );
-    fprintf( pOutFile, "%20s", "gdn.losr" );
-    fprintf( pOutFile, "%20s", "gdn.rDot" );
-    fprintf( pOutFile, "%20s", "gdn.relPxf" );
-    fprintf( pOutFile, "%20s", "gdn.relPyf" );
-    fprintf( pOutFile, "%20s", "gdn.relVxf" );
-    fprintf( pOutFile, "%20s", "gdn.relVyf" );
-    fprintf( pOutFile, "%20s", "gdn.rng" );
-  }
-  else
-  {
-    fprintf(pOutFile, "%20.6e", aCmdYb );
-    fprintf(pOutFile, "%20.6e", estLosr );
-    fprintf(pOutFile, "%20.6e", estRdot );
-    fprintf(pOutFile, "%20.6e", relPxf );
-    fprintf(pOutFile, "%20.6e", relPyf );
-    fprintf(pOutFile, "%20.6e", relVxf );
-    fprintf(pOutFile, "%20.6e", relVyf );
-    fprintf(pOutFile, "%20.6e", estRng );
-
-  } // end if ( printHeader ) else
-}  // end Output()
-
 //############################################################################//
 //
 // Function: ResetAll()
@@ -820,164 +820,6 @@ double lut2d( double *xlist,
 // }
 
 
-/*
-// *****************************************************************************
-//
-//                         Random number generator code
-//
-// *****************************************************************************
-*/
-
-#define IA 16807
-#define IM 2147483647
-#define AM (1.0 / IM)
-#define IQ 127773
-#define IR 2836
-#define NTAB 32
-#define NDIV (1 + (IM - 1) / NTAB)
-#define EPS 1.2e-7
-#define RNMX (1.0 - EPS)
-
-
-/*!
- * Numerical Recipes uniform random number generator
- */
-double ran1(long *idum)
-{
-  int j;
-  long k;
-  static long iy = 0;
-  static long iv[NTAB];
-  double temp;
-
-  if (*idum <= 0 || !iy) {
-    if (-(*idum) < 1)
-      *idum = 1;
-    else *idum
-      = -(*idum);
-    for (j = NTAB + 7; j >= 0; j--) {
-      k = (*idum) / IQ;
-      *idum = IA * (*idum-k * IQ) - IR * k;
-      if (*idum<0)
-        *idum += IM;
-      if (j < NTAB)
-       iv[j] = *idum;
-    }
-    iy = iv[0];
-  }
-
-  k = (*idum) / IQ;
-  *idum = IA * (*idum - k * IQ) - IR * k;
-  if (*idum <= 0) *idum += IM;
-  j = iy / NDIV;
-  iy = iv[j];
-  iv[j] = *idum;
-  if ( (temp = AM * iy) > RNMX )
-    return RNMX;
-  else
-    return temp;
-}
-
-
-/*!
- * Numerical Recipes Gaussian random number generator
- */
-double gasdev(long *idum)
-{
-  static int iset              = 0;
-  static double gset;
-  double fac, rsq, v1, v2;
-  int i;
-  double sum;
-  if (0) {
-  if (*idum<0)            iset = 0;
-  if (iset==0) {
-    do {
-      v1                       = 2.0*ran1(idum)-1.0;
-      v2                       = 2.0*ran1(idum)-1.0;
-      rsq                      = v1*v1 + v2*v2;
-    } while ((rsq>=1.0) || (rsq==0.0));
-    fac                        = sqrt(-2.0*log(rsq)/rsq);
-    gset                       = v1*fac;
-    iset                       = 1;
-    return v2*fac;
-  } else {
-    iset                       = 0;
-    return gset;
-  }
-  } else {
-    sum = 0;
-    for (i=0; i<12; ++i) {
-      sum += ran1(idum)-0.5;
-    }
-    return sum;
-  }
-
-
-}
-
-
-/*!
- * Uniform random number generator
- */
-double uniform(double min,
-               double max,
-               long *seed)
-{
-  double ran = ran1(seed);
-
-  return (min + ran * (max - min));
-}
-
-
-/*!
- * Gaussian random number generator
- */
-double gaussian(double mean,
-                double sigma,
-                long   *seed)
-{
-  double rannum;
-
-  while (fabs(rannum = gasdev(seed)) > 3) {}
-
-  return mean + sigma*rannum;
-}
-
-
-/*!
- * Weibull random number generator
- */
-double weibull( double alpha,
-                double beta,
-                long   *seed)
-{
-  double ran;
-
-  do {
-    ran = ran1(seed);
-  } while (ran == 0.0);
-
-  return beta * pow(-log(ran), 1.0 / alpha);
-}
-
-
-/*!
- * Exponential distribution random number generator
- */
-double exponential( double av,
-                    long   *seed )
-{
-  double ran;
-
-  do {
-    ran = ran1(seed);
-  } while (ran == 0.0);
-
-  return -av * log(ran);
-}
-
-
 /*
 // *****************************************************************************
 //
@@ -228,36 +228,6 @@ double lut2d( double *xlist,
 //                   int    rows,
 //                   int    cols );
 
-/*
-// *****************************************************************************
-//
-//                        Random number generator code
-//
-// *****************************************************************************
-*/
-
-//
-// Numerical Recipes uniform random number generator
-//
-double ran1(long *idum);
-
-//
-// Numerical Recipes Gaussian random number generator
-//
-double gasdev(long *idum);
-
-//
-// Uniform random number generator
-//
-double uniform(double min, double max, long *seed);
-
-//
-// Gaussian random number generator
-//
-double gaussian(double mean, double sigma, long *seed);
-
-
-
 /*
 // *****************************************************************************
 //
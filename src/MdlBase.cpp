@@ -37,7 +37,7 @@ MdlBase::MdlBase()
   frameTimeStep = 999.0e9;
   mdlName = "";
   pSimTime = 0;
-  initComp = false;
+  pRng = 0;
   intEn = false;
 }
 
@@ -107,8 +107,32 @@ void MdlBase::FrameUpdate()
 // Purpose:  Print model output
 //
 //############################################################################//
-void MdlBase::Output( bool printHeader, FILE *pOutFile )
+void MdlBase::Output( bool printHeader, TrajFile &traj )
 {
+  const OutChannel *pChan;
+
+  for (unsigned int i = 0; i < outSelected.size(); ++i)
+  {
+    pChan = &outChannels[outSelected[i]];
+
+    if ( printHeader )
+    {
+      traj.Header( pChan->name.c_str(), pChan->units.c_str(),
+                   ( pChan->type == REAL_CHAN ) ? 0 : TRAJ_INTEGER );
+    }
+    else if ( pChan->type == REAL_CHAN )
+    {
+      traj.Value( *static_cast<const double *>( pChan->pVar ) );
+    }
+    else if ( pChan->type == INT_CHAN )
+    {
+      traj.Value( *static_cast<const int *>( pChan->pVar ) );
+    }
+    else
+    {
+      traj.Value( static_cast<int>( *static_cast<const bool *>( pChan->pVar ) ) );
+    }
+  }
 }
 
 //############################################################################//
@@ -183,14 +207,89 @@ void MdlBase::RegisterState(double &state, double &deriv)
   ptr = &deriv; 
   m_deriv.push_back(ptr);
 
+  //
+  // Size the integrator work space with the state vector, so stepping
+  // never allocates.
+  //
+  xn.push_back( 0.0 );
+  k1.push_back( 0.0 );
+  k2.push_back( 0.0 );
+  k3.push_back( 0.0 );
+  k4.push_back( 0.0 );
+
   intEn = true;
 }
 
+//############################################################################//
+///
+/// <b> Function: </b>  RegisterChannel()
+///
+/// <b> Purpose: </b>   Register an output channel.  Channels start selected.
+///
+///
+//############################################################################//
+void MdlBase::RegisterChannel(const char *name, const char *units, double &var)
+{
+  AddChannel( name, units, REAL_CHAN, &var );
+}
+
+void MdlBase::RegisterChannel(const char *name, const char *units, int &var)
+{
+  AddChannel( name, units, INT_CHAN, &var );
+}
+
+void MdlBase::RegisterChannel(const char *name, const char *units, bool &var)
+{
+  AddChannel( name, units, BOOL_CHAN, &var );
+}
+
+void MdlBase::AddChannel(const char *name, const char *units, CHAN_TYPE type,
+                         const void *pVar)
+{
+  OutChannel chan;
+
+  chan.name  = name;
+  chan.units = units;
+  chan.type  = type;
+  chan.pVar  = pVar;
+
+  outSelected.push_back( outChannels.size() );
+  outChannels.push_back( chan );
+}
+
+//############################################################################//
+///
+/// <b> Function: </b>  SelectChannels()
+///
+/// <b> Purpose: </b>   Select the channels matching any of the patterns
+///
+///
+//############################################################################//
+int MdlBase::SelectChannels(const std::vector<string> &patterns)
+{
+  outSelected.clear();
+
+  for (unsigned int i = 0; i < outChannels.size(); ++i)
+  {
+    for (unsigned int j = 0; j < patterns.size(); ++j)
+    {
+      if ( TrajFile::GlobMatch( patterns[j].c_str(), outChannels[i].name.c_str() ) )
+      {
+        outSelected.push_back( i );
+        break;
+      }
+    }
+  }
+
+  return outSelected.size();
+}
+
 //############################################################################//
 //
 // Function: Integrate()  
 //                                    
-// Purpose:  RK4 integrator.
+// Purpose:  RK4 integrator.  Works directly through the registered state and
+//           derivative pointers.  No heap allocation or container copies.
 //                                    
 //
 //############################################################################//
@@ -203,34 +302,23 @@ void MdlBase::Integrate(double   &timeStep )
   double h_half = hh / 2.0;
   double tempSimTime = *pSimTime;
 
-  //
-  // Define local derivaitve and state containers
-  //
-  std::vector<double *> pDeriv;
-  std::vector<double *> pState;
-
-  //
-  // Get current states and store values
-  //
-  GetStates( pState );
+  const int nn = m_state.size();
 
-  if ( !initComp )
-  {
-    initComp = true;
+  double * const *pState = &m_state[0];
+  double * const *pDeriv = &m_deriv[0];
 
-    //
-    // Allocate container memory with sizes of state vector
-    //
-    xn.insert( xn.end(), pState.size(), 0.0 );
-    k1.insert( k1.end(), pState.size(), 0.0 );
-    k2.insert( k2.end(), pState.size(), 0.0 );
-    k3.insert( k3.end(), pState.size(), 0.0 );
-    k4.insert( k4.end(), pState.size(), 0.0 );
-  }
+  double *pXn = &xn[0];
+  double *pK1 = &k1[0];
+  double *pK2 = &k2[0];
+  double *pK3 = &k3[0];
+  double *pK4 = &k4[0];
 
-  for( unsigned int idx = 0; idx < pState.size(); ++idx )
+  //
+  // Store current states
+  //
+  for( int idx = 0; idx < nn; ++idx )
   {
-     xn[idx] = *pState[idx];
+     pXn[idx] = *pState[idx];
   }
 
   //
@@ -238,16 +326,15 @@ void MdlBase::Integrate(double   &timeStep )
   // Step 1
   //
   UpdateDerivatives();
-  GetDerivatives( pDeriv );
 
-  for( unsigned int idx = 0; idx < pDeriv.size(); ++idx )
+  for( int idx = 0; idx < nn; ++idx )
   {
-    k1[idx] = *pDeriv[idx] * hh;
+    pK1[idx] = *pDeriv[idx] * hh;
 
     //
     // Compute states for next step while we are here
     //
-    *pState[idx] = xn[idx] + k1[idx] / 2.0;
+    *pState[idx] = pXn[idx] + pK1[idx] / 2.0;
   }
 
   // 
@@ -257,38 +344,34 @@ void MdlBase::Integrate(double   &timeStep )
 
   //
   // Step 2
-  // Apply state step and get new derivatives
+  // Get new derivatives at the stage states
   //
-  SetStates(pState);
   UpdateDerivatives();
-  GetDerivatives(pDeriv);
 
-  for( unsigned int idx = 0; idx < pDeriv.size(); ++idx )
+  for( int idx = 0; idx < nn; ++idx )
   {
-    k2[idx] = *pDeriv[idx] * hh;
+    pK2[idx] = *pDeriv[idx] * hh;
 
     //
     // Compute states for next step while we are here
     //
-    *pState[idx] = xn[idx] + k2[idx]/2.0;
+    *pState[idx] = pXn[idx] + pK2[idx]/2.0;
   }
 
   //
   // Step 3
-  // Apply state step and get new derivatives
+  // Get new derivatives at the stage states
   //
-  SetStates(pState);
   UpdateDerivatives();
-  GetDerivatives(pDeriv);
 
-  for(unsigned int idx = 0; idx < pDeriv.size(); ++idx)
+  for( int idx = 0; idx < nn; ++idx )
   {
-    k3[idx] = *pDeriv[idx]*hh;
+    pK3[idx] = *pDeriv[idx]*hh;
 
     //
     // Compute states for next step while we are here
     //
-    *pState[idx] = xn[idx] + k3[idx];
+    *pState[idx] = pXn[idx] + pK3[idx];
   }
 
   //
@@ -298,23 +381,20 @@ void MdlBase::Integrate(double   &timeStep )
 
   //
   // Step 4
-  // Apply state step and get new derivatives
+  // Get new derivatives at the stage states
   //
-  SetStates(pState);
   UpdateDerivatives();
-  GetDerivatives(pDeriv);
 
-  for(unsigned int idx = 0; idx < pDeriv.size(); ++idx)
+  for( int idx = 0; idx < nn; ++idx )
   {
-    k4[idx] = *pDeriv[idx]*hh;
+    pK4[idx] = *pDeriv[idx]*hh;
 
     //
     // Compute states
     //
-    *pState[idx] = xn[idx] + k1[idx]/6.0 + k2[idx]/3.0 + k3[idx]/3.0 + 
-                                                               k4[idx]/6.0;
+    *pState[idx] = pXn[idx] + pK1[idx]/6.0 + pK2[idx]/3.0 + pK3[idx]/3.0 + 
+                                                               pK4[idx]/6.0;
   }
-  SetStates(pState);
 
   //
   // Reset clock for this module
@@ -25,6 +25,12 @@ using std::ofstream;
 #include <string>
 using std::string;
 
+//
+// Sim includes
+//
+#include "Random.hpp"
+#include "TrajFile.hpp"
+
 //
 // Global scope constants
 //
@@ -95,6 +101,27 @@ public:
     FIRST_ORD
   } ACS_AP;
 
+  //
+  // Type of the variable behind an output channel
+  //
+  typedef enum _chan_type_
+  {
+    REAL_CHAN,      // 0 = double
+    INT_CHAN,       // 1 = int
+    BOOL_CHAN       // 2 = bool, written as an integer 0 or 1
+  } CHAN_TYPE;
+
+  //
+  // Output channel registry entry
+  //
+  typedef struct _out_channel_
+  {
+    string      name;       // na  Channel name, model prefix included
+    string      units;      // na  Channel units
+    CHAN_TYPE   type;       // na  Type of the variable
+    const void *pVar;       // na  Variable written by the channel
+  } OutChannel;
+
   //
   // Public variables
   //  
@@ -102,6 +129,8 @@ public:
   string mdlName;
   double nextFrameTime;
   double *pSimTime;
+  Random *pRng;
+  Random rng;
   bool   intEn;
 
 
@@ -165,10 +194,11 @@ public:
 //
 // Function: Output()
 //
-// Purpose:  Print model output
+// Purpose:  Write the selected output channels, their names and units to
+//           the header row or their values to a data row
 //
 //############################################################################//
-  virtual void Output( bool printHeader, FILE *pOutFile );
+  virtual void Output( bool printHeader, TrajFile &traj );
 
 //############################################################################//
 //
@@ -183,7 +213,8 @@ public:
 //
 // Function:   getStates
 //
-// Purpose:    State accessor
+// Purpose:    State accessor.  Copies the pointer vector, not for use in the
+//             integration path.
 //
 //############################################################################//
   void GetStates(std::vector<double *> &states);
@@ -215,6 +246,43 @@ public:
 //############################################################################//
   void RegisterState(double &state, double &deriv);
 
+//############################################################################//
+//
+// Function: RegisterChannel
+//
+// Purpose:  Register a variable as a named output channel.  The variable
+//           must live as long as the model.  Integer and flag channels are
+//           written as integers.
+//
+//############################################################################//
+  void RegisterChannel( const char *name, const char *units, double &var );
+
+  void RegisterChannel( const char *name, const char *units, int &var );
+
+  void RegisterChannel( const char *name, const char *units, bool &var );
+
+//############################################################################//
+//
+// Function: SelectChannels
+//
+// Purpose:  Select the output channels with a name matching any of the
+//           glob patterns.  Returns the quantity selected.
+//
+//############################################################################//
+  int SelectChannels( const std::vector<string> &patterns );
+
+//############################################################################//
+//
+// Function: GetChannels
+//
+// Purpose:  Output channel registry accessor
+//
+//############################################################################//
+  const std::vector<OutChannel> &GetChannels() const
+  {
+    return outChannels;
+  }
+
 //############################################################################//
 //
 // Function: Integrate()  
@@ -237,6 +305,18 @@ public:
     pSimTime = pSimTime_;
   }
 
+//############################################################################//
+//
+// Function: SetRng
+//
+// Purpose:  Set the run random number generator pointer
+//
+//############################################################################//
+  void SetRng( Random *pRng_ )
+  {
+    pRng = pRng_;
+  }
+
 //############################################################################//
 //
 // Function: GetTime()
@@ -253,6 +333,9 @@ protected:
 
 private:
 
+  void AddChannel( const char *name, const char *units, CHAN_TYPE type,
+                   const void *pVar );
+
   std::vector<double *> m_state;
   std::vector<double *> m_deriv;
 
@@ -262,7 +345,8 @@ private:
   std::vector<double> k3;
   std::vector<double> k4;
 
-  bool initComp;
+  std::vector<OutChannel> outChannels;  // Registered output channels
+  std::vector<int>        outSelected;  // Indexes of the selected channels
 };
 
 #endif
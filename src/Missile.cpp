@@ -70,6 +70,22 @@ MdlBase()
   RegisterState( vxf, axf);
   RegisterState( vyf, ayf);
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "msl.axb", "m/sec^2", axb );
+  RegisterChannel( "msl.axf", "m/sec^2", axf );
+  RegisterChannel( "msl.ayb", "m/sec^2", ayb );
+  RegisterChannel( "msl.ayf", "m/sec^2", ayf );
+  RegisterChannel( "msl.launchTime", "sec", launchTime );
+  RegisterChannel( "msl.pxf", "m", pxf );
+  RegisterChannel( "msl.pyf", "m", pyf );
+  RegisterChannel( "msl.theta", "rad", theta );
+  RegisterChannel( "msl.vxb", "m/sec", vxb );
+  RegisterChannel( "msl.vxf", "m/sec", vxf );
+  RegisterChannel( "msl.vyb", "m/sec", vyb );
+  RegisterChannel( "msl.vyf", "m/sec", vyf );
+
 }  // end Missile()
 
 //############################################################################//
@@ -159,7 +175,7 @@ void Missile::UpdateDerivatives()
 
   simTime = GetSimTime();
 
-  ayb = pAp->ayb;
+  ayb = pAp->GetStateAyb();
 
   theta = atan2( vyf, vxf );
   cth = cos( theta );
@@ -182,51 +198,6 @@ void Missile::Finalize()
   simTime = GetSimTime();
 } 
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void Missile::Output( bool printHeader,
-                     FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "msl.axb" );
-    fprintf( pOutFile, "%20s", "msl.axf" );
-    fprintf( pOutFile, "%20s", "msl.ayb" );
-    fprintf( pOutFile, "%20s", "msl.ayf" );
-    fprintf( pOutFile, "%20s", "msl.launchTime" );
-    fprintf( pOutFile, "%20s", "msl.pxf" );
-    fprintf( pOutFile, "%20s", "msl.pyf" );
-    fprintf( pOutFile, "%20s", "msl.theta" );
-    fprintf( pOutFile, "%20s", "msl.vxb" );
-    fprintf( pOutFile, "%20s", "msl.vxf" );
-    fprintf( pOutFile, "%20s", "msl.vyb" );
-    fprintf( pOutFile, "%20s", "msl.vyf" );
-  }
-  else
-  {
-    fprintf(pOutFile, "%20.6e", axb);
-    fprintf(pOutFile, "%20.6e", axf);
-    fprintf(pOutFile, "%20.6e", ayb);
-    fprintf(pOutFile, "%20.6e", ayf);
-    fprintf(pOutFile, "%20.6e", launchTime);
-    fprintf(pOutFile, "%20.6e", pxf);
-    fprintf(pOutFile, "%20.6e", pyf);
-    fprintf(pOutFile, "%20.6e", theta);
-    fprintf(pOutFile, "%20.6e", vxb);
-    fprintf(pOutFile, "%20.6e", vxf);
-    fprintf(pOutFile, "%20.6e", vyb);
-    fprintf(pOutFile, "%20.6e", vyf);
-
-  } // end if ( printHeader ) else
-}  // end Output()
-
 //############################################################################//
 //
 // Function: ResetAll()
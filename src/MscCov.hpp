@@ -0,0 +1,477 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       MscCov.hpp
+
+    \author     David Bruce
+
+    \brief      Structure exploiting covariance algebra for the six state
+                modified spherical coordinate (MSC) Kalman filters
+
+    The MSC filters, FcTse6 and MslTse6, share a state transition Jacobian
+    with a fixed pattern of 15 nonzeros out of 36, and a measurement matrix
+    that selects states 0, 2 and 3.  The functions here propagate and update
+    the covariance using only the nonzero elements of phi, apply H as an
+    index selection, and compute only the lower triangle of the symmetric
+    covariance before mirroring it to the upper triangle.
+
+    The dense forms are kept alongside for the regression in test/, which
+    checks the two paths agree to round off.  SymmetricSparse and Dense
+    wrap the two sets as covariance policies for MscEkf.  All functions are
+    templates on the element type of the matrices.
+
+*/
+//############################################################################//
+
+#ifndef MSCCOV_HPP
+#define MSCCOV_HPP
+
+#include <utility>
+
+#include "Mat.hpp"
+
+namespace MSC_COV
+{
+
+//
+// Nonzero columns of each row of the state transition Jacobian, see
+// FcTse6::PropStates().  Rows with fewer than three nonzeros are padded with
+// -1.  The tables are compile time constants so the products below expand
+// into straight line code, as Mat<R,C> products do.
+//
+constexpr int PHI_NNZ[6]     = { 2, 3, 2, 3, 2, 2 };
+constexpr int PHI_COLS[6][3] = { { 0, 1, -1 },
+                                 { 1, 3,  5 },
+                                 { 2, 3, -1 },
+                                 { 1, 3,  4 },
+                                 { 3, 4, -1 },
+                                 { 3, 5, -1 } };
+
+//
+// States measured, H = [ e0'; e2'; e3' ]
+//
+constexpr int MEAS_IDX[3] = { 0, 2, 3 };
+
+//############################################################################//
+//
+// Function: Mirror()
+//
+// Purpose:  Copy the lower triangle of a symmetric matrix to the upper.
+//
+//############################################################################//
+template <class T>
+inline void Mirror( Mat<6,6,T> &PP )
+{
+  for ( int row = 0; row < 6; ++row )
+  {
+    for ( int col = 0; col < row; ++col )
+    {
+      PP[col][row] = PP[row][col];
+    }
+  }
+}
+
+//
+// One row of phi * PP, a weighted sum of the rows of PP picked out by the
+// nonzeros of row ROW of phi.
+//
+template <int ROW, class T, std::size_t... kk>
+inline void PhiRow( const Mat<6,6,T> &phi,
+                    const Mat<6,6,T> &PP,
+                    Mat<6,6,T>       &phiP,
+                    std::index_sequence<kk...> )
+{
+  for ( int col = 0; col < 6; ++col )
+  {
+    T sum(0.0);
+
+    ((sum += phi[ROW][PHI_COLS[ROW][kk]] * PP[PHI_COLS[ROW][kk]][col]), ...);
+
+    phiP[ROW][col] = sum;
+  }
+}
+
+//
+// One column of phiP * phi', from the diagonal down.
+//
+template <int COL, class T, std::size_t... kk>
+inline void PhiTCol( const Mat<6,6,T> &phi,
+                     const Mat<6,6,T> &phiP,
+                     Mat<6,6,T>       &PP,
+                     std::index_sequence<kk...> )
+{
+  for ( int row = COL; row < 6; ++row )
+  {
+    T sum(0.0);
+
+    ((sum += phiP[row][PHI_COLS[COL][kk]] * phi[COL][PHI_COLS[COL][kk]]), ...);
+
+    PP[row][COL] = sum;
+  }
+}
+
+template <class T, std::size_t... rr>
+inline void PropRows( const Mat<6,6,T> &phi,
+                      Mat<6,6,T>       &PP,
+                      std::index_sequence<rr...> )
+{
+  Mat<6,6,T> phiP;
+
+  (PhiRow<rr>( phi, PP, phiP, std::make_index_sequence<PHI_NNZ[rr]>() ), ...);
+
+  (PhiTCol<rr>( phi, phiP, PP, std::make_index_sequence<PHI_NNZ[rr]>() ), ...);
+}
+
+//############################################################################//
+//
+// Function: Prop()
+//
+// Purpose:  PP = phi * PP * phi', visiting only the nonzeros of phi and the
+//           lower triangle of the result.
+//
+//############################################################################//
+template <class T>
+inline void Prop( const Mat<6,6,T> &phi, Mat<6,6,T> &PP )
+{
+  PropRows( phi, PP, std::make_index_sequence<6>() );
+
+  Mirror( PP );
+}
+
+//############################################################################//
+//
+// Function: Innovation()
+//
+// Purpose:  SS = H * PP * H' + RR, picking the measured rows and columns of PP.
+//
+//############################################################################//
+template <class T>
+inline void Innovation( const Mat<6,6,T> &PP,
+                        const Mat<3,3,T> &RR,
+                        Mat<3,3,T>       &SS )
+{
+  for ( int row = 0; row < 3; ++row )
+  {
+    for ( int col = 0; col < 3; ++col )
+    {
+      SS[row][col] = PP[MEAS_IDX[row]][MEAS_IDX[col]] + RR[row][col];
+    }
+  }
+}
+
+//############################################################################//
+//
+// Function: CrossCov()
+//
+// Purpose:  PHT = PP * H', the measured columns of PP.
+//
+//############################################################################//
+template <class T>
+inline void CrossCov( const Mat<6,6,T> &PP, Mat<6,3,T> &PHT )
+{
+  for ( int row = 0; row < 6; ++row )
+  {
+    for ( int col = 0; col < 3; ++col )
+    {
+      PHT[row][col] = PP[row][MEAS_IDX[col]];
+    }
+  }
+}
+
+//############################################################################//
+//
+// Function: Residual()
+//
+// Purpose:  residual = measVec - H * state
+//
+//############################################################################//
+template <class T>
+inline void Residual( const Mat<3,1,T> &measVec,
+                      const Mat<6,1,T> &state,
+                      Mat<3,1,T>       &residual )
+{
+  for ( int row = 0; row < 3; ++row )
+  {
+    residual(row) = measVec(row) - state(MEAS_IDX[row]);
+  }
+}
+
+//############################################################################//
+//
+// Function: Joseph()
+//
+// Purpose:  Joseph form covariance update,
+//
+//             PP = (I - KK*H) * PP * (I - KK*H)' + KK * RR * KK'
+//
+//           With A = I - KK*H,
+//
+//             A * PP      = PP - KK * (H * PP)
+//             A * PP * A' = A*PP - (A*PP * H') * KK'
+//
+//           where H * PP and A*PP * H' are row and column selections, and
+//           the two KK' products are combined into one.
+//
+//############################################################################//
+template <class T>
+inline void Joseph( const Mat<6,3,T> &KK,
+                    const Mat<3,3,T> &RR,
+                    Mat<6,6,T>       &PP )
+{
+  Mat<6,6,T> AP;
+  Mat<6,3,T> DD;
+  int      col;
+  int      row;
+
+  const int m0(MEAS_IDX[0]);
+  const int m1(MEAS_IDX[1]);
+  const int m2(MEAS_IDX[2]);
+
+  //
+  // A * PP
+  //
+  for ( row = 0; row < 6; ++row )
+  {
+    for ( col = 0; col < 6; ++col )
+    {
+      AP[row][col] = PP[row][col] - ( KK[row][0] * PP[m0][col] +
+                                      KK[row][1] * PP[m1][col] +
+                                      KK[row][2] * PP[m2][col] );
+    }
+  }
+
+  //
+  // DD = KK * RR - A*PP * H'
+  //
+  for ( row = 0; row < 6; ++row )
+  {
+    for ( col = 0; col < 3; ++col )
+    {
+      DD[row][col] = KK[row][0] * RR[0][col] +
+                     KK[row][1] * RR[1][col] +
+                     KK[row][2] * RR[2][col] - AP[row][MEAS_IDX[col]];
+    }
+  }
+
+  //
+  // A*PP*A' + KK*RR*KK' = A*PP + DD * KK', lower triangle
+  //
+  for ( row = 0; row < 6; ++row )
+  {
+    for ( col = 0; col <= row; ++col )
+    {
+      PP[row][col] = AP[row][col] + ( DD[row][0] * KK[col][0] +
+                                      DD[row][1] * KK[col][1] +
+                                      DD[row][2] * KK[col][2] );
+    }
+  }
+
+  Mirror( PP );
+}
+
+//############################################################################//
+//
+// Function: MeasMatrix()
+//
+// Purpose:  The measurement matrix H built from MEAS_IDX.
+//
+//############################################################################//
+template <class T>
+inline Mat<3,6,T> MeasMatrix()
+{
+  Mat<3,6,T> HH;
+
+  for ( int row = 0; row < 3; ++row )
+  {
+    HH[row][MEAS_IDX[row]] = 1.0;
+  }
+
+  return HH;
+}
+
+//############################################################################//
+//
+// Function: PropDense(), InnovationDense(), CrossCovDense(),
+//           ResidualDense(), JosephDense()
+//
+// Purpose:  The dense matrix forms of Prop(), Innovation(), CrossCov(),
+//           Residual() and Joseph(), for regression.
+//
+//############################################################################//
+template <class T>
+inline void PropDense( const Mat<6,6,T> &phi, Mat<6,6,T> &PP )
+{
+  PP = phi * PP * MATRIX::Transpose( phi );
+}
+
+template <class T>
+inline void InnovationDense( const Mat<6,6,T> &PP,
+                             const Mat<3,3,T> &RR,
+                             Mat<3,3,T>       &SS )
+{
+  Mat<3,6,T> HH( MeasMatrix<T>() );
+
+  SS = HH * PP * MATRIX::Transpose( HH ) + RR;
+}
+
+template <class T>
+inline void CrossCovDense( const Mat<6,6,T> &PP, Mat<6,3,T> &PHT )
+{
+  PHT = PP * MATRIX::Transpose( MeasMatrix<T>() );
+}
+
+template <class T>
+inline void ResidualDense( const Mat<3,1,T> &measVec,
+                           const Mat<6,1,T> &state,
+                           Mat<3,1,T>       &residual )
+{
+  residual = measVec - MeasMatrix<T>() * state;
+}
+
+template <class T>
+inline void JosephDense( const Mat<6,3,T> &KK,
+                         const Mat<3,3,T> &RR,
+                         Mat<6,6,T>       &PP )
+{
+  Mat<6,6,T> eye;
+  Mat<6,6,T> temp1;
+
+  eye.Eye();
+
+  temp1 = eye - KK * MeasMatrix<T>();
+
+  PP = temp1 * PP * MATRIX::Transpose( temp1 ) +
+       KK * RR * MATRIX::Transpose( KK );
+}
+
+//
+// Covariance storage policies for MscEkf.  SymmetricSparse keeps only the
+// lower triangle of PP current and uses the structure of phi and H; Dense
+// runs the full matrix products.
+//
+struct SymmetricSparse
+{
+  template <class T>
+  static void Prop( const Mat<6,6,T> &phi, Mat<6,6,T> &PP )
+  { MSC_COV::Prop( phi, PP ); }
+
+  template <class T>
+  static void Innovation( const Mat<6,6,T> &PP,
+                          const Mat<3,3,T> &RR,
+                          Mat<3,3,T>       &SS )
+  { MSC_COV::Innovation( PP, RR, SS ); }
+
+  template <class T>
+  static void CrossCov( const Mat<6,6,T> &PP, Mat<6,3,T> &PHT )
+  { MSC_COV::CrossCov( PP, PHT ); }
+
+  template <class T>
+  static void Residual( const Mat<3,1,T> &measVec,
+                        const Mat<6,1,T> &state,
+                        Mat<3,1,T>       &residual )
+  { MSC_COV::Residual( measVec, state, residual ); }
+
+  template <class T>
+  static void Joseph( const Mat<6,3,T> &KK,
+                      const Mat<3,3,T> &RR,
+                      Mat<6,6,T>       &PP )
+  { MSC_COV::Joseph( KK, RR, PP ); }
+};
+
+struct Dense
+{
+  template <class T>
+  static void Prop( const Mat<6,6,T> &phi, Mat<6,6,T> &PP )
+  { PropDense( phi, PP ); }
+
+  template <class T>
+  static void Innovation( const Mat<6,6,T> &PP,
+                          const Mat<3,3,T> &RR,
+                          Mat<3,3,T>       &SS )
+  { InnovationDense( PP, RR, SS ); }
+
+  template <class T>
+  static void CrossCov( const Mat<6,6,T> &PP, Mat<6,3,T> &PHT )
+  { CrossCovDense( PP, PHT ); }
+
+  template <class T>
+  static void Residual( const Mat<3,1,T> &measVec,
+                        const Mat<6,1,T> &state,
+                        Mat<3,1,T>       &residual )
+  { ResidualDense( measVec, state, residual ); }
+
+  template <class T>
+  static void Joseph( const Mat<6,3,T> &KK,
+                      const Mat<3,3,T> &RR,
+                      Mat<6,6,T>       &PP )
+  { JosephDense( KK, RR, PP ); }
+};
+
+//############################################################################//
+//
+// Function: PropFlops(), UpdateFlops()
+//
+// Purpose:  Multiplies plus adds for one covariance propagation and one
+//           covariance update, sparse or dense.  The sparse counts follow the
+//           loops above and the phi pattern; the update counts include the
+//           innovation covariance, PP * H', H * x and the Joseph form, but
+//           not the gain solve, which is the same for both.
+//
+//############################################################################//
+inline int PropFlops( bool sparse )
+{
+  int flops(0);
+
+  if ( sparse )
+  {
+    for ( int row = 0; row < 6; ++row )
+    {
+      flops += 2 * PHI_NNZ[row] * 6;
+
+      for ( int col = 0; col <= row; ++col )
+      {
+        flops += 2 * PHI_NNZ[col];
+      }
+    }
+  }
+  else
+  {
+    flops = 2 * ( 2 * 6 * 6 * 6 );
+  }
+
+  return flops;
+}
+
+inline int UpdateFlops( bool sparse )
+{
+  int flops(0);
+
+  if ( sparse )
+  {
+    flops  = 3 * 3;                  // SS = H*PP*H' + RR
+    flops += 3;                      // residual
+    flops += 6 * 6 * 2 * 3;          // A * PP
+    flops += 6 * 3 * 2 * 3;          // KK * RR - A*PP * H'
+    flops += 21 * 2 * 3;             // A*PP + DD * KK'
+  }
+  else
+  {
+    flops  = 3 * 6 * 2 * 6 + 3 * 3 * 2 * 6 + 3 * 3;
+    flops += 6 * 3 * 2 * 6;                         // PP * H'
+    flops += 3 * 2 * 6 + 3;
+    flops += 6 * 6 * 2 * 3 + 6 * 6;                 // eye - KK * HH
+    flops += 2 * ( 6 * 6 * 2 * 6 );                 // temp1*PP*temp1'
+    flops += 6 * 3 * 2 * 3 + 6 * 6 * 2 * 3 + 6 * 6; // + KK*RR*KK'
+  }
+
+  return flops;
+}
+
+} // end namespace MSC_COV
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,637 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       MscEkf.hpp
+
+    \author     David Bruce
+
+    \brief      Six state modified spherical coordinate (MSC) extended Kalman
+                filter core
+
+    The filter shared by the fire control TSE, FcTse6, and the missile TSE,
+    MslTse6.  The states are
+
+      0  LOS angle                        rad
+      1  LOS rate                         rad/sec
+      2  Inverse range                    1/m
+      3  Range rate / range               1/sec
+      4  Acceleration along LOS / range   1/sec^2
+      5  Acceleration across LOS / range  1/sec^2
+
+    and the measurements LOS angle, inverse range and range rate / range.
+    The states are propagated in cartesian coordinates with a second order
+    Runge Kutta integrator, and the covariance with the linearized MSC
+    dynamics and Singer acceleration process noise.
+
+    Scalar is the element type of the states and matrices.  CovPolicy
+    selects the covariance algebra, MSC_COV::SymmetricSparse or
+    MSC_COV::Dense, see MscCov.hpp.  Everything is in this header, so a
+    model instantiates the filter it needs.
+
+    covForm selects the covariance form at run time.  cfJOSEPH carries PP
+    and updates it in Joseph form with CovPolicy.  cfUD carries the UD
+    factors UU and DD, see UdFactor.hpp, and composes PP from them after
+    each update for output; the measurements are decorrelated with the
+    Cholesky factor of RR and processed one at a time, and KK holds the
+    gains of the decorrelated measurements.
+
+    The models own the measurement interface and output; they fill measVec,
+    call Initialize() on the first frame, then Propagate() and Update() each
+    frame.
+
+*/
+//############################################################################//
+
+#ifndef MSCEKF_HPP
+#define MSCEKF_HPP
+
+#include <cmath>
+
+#include "Mat.hpp"
+#include "MathUtils.hpp"
+#include "MscCov.hpp"
+#include "UdFactor.hpp"
+
+template <class Scalar, class CovPolicy = MSC_COV::SymmetricSparse>
+class MscEkf
+{
+public:
+
+  typedef Mat<6,1,Scalar> State;
+
+  //
+  // Tuning
+  //
+  Scalar singerTau;     // sec       Kalman process noise tuning parameter
+  Scalar singerVar;     // (m/s^2)^2 Kalman process noise tuning parameter
+
+  UD_FACTOR::CovForm covForm; // na  Covariance form
+
+  //
+  // Filter variables
+  //
+  State            cartRel;     // na  Cartesian state vector
+  State            DD;          // na  UD factor diagonal
+  bool             initialized; // na  Filter has been initialized.
+  State            innovation;  // na  Kalman innovation
+  Mat<6,3,Scalar>  KK;          // na  Kalman gains
+  Mat<3,1,Scalar>  measVec;     // na  Measurement vector
+  State            mscState;    // na  Modified spherical coordates state
+  Mat<6,6,Scalar>  phi;         // na  State transition matrix
+  Mat<6,6,Scalar>  PP;          // na  Estimation covariance matrix
+  Mat<3,1,Scalar>  residual;    // na  Update residual
+  Mat<3,3,Scalar>  RR;          // na  Measurement covariance matrix
+  Mat<6,6,Scalar>  UU;          // na  UD factor unit upper triangle
+
+//############################################################################//
+//
+// Function:  MscEkf()
+//
+// Purpose:   Constructor
+//
+//############################################################################//
+  MscEkf() :
+  singerTau(0.3),
+  singerVar(600.0),
+  covForm(UD_FACTOR::cfJOSEPH)
+  {
+    Reset();
+  }
+
+//############################################################################//
+//
+// Function: Reset()
+//
+// Purpose:  Clear the filter, leaving the tuning.
+//
+//############################################################################//
+  void Reset()
+  {
+    cartRel     = 0.0;
+    DD          = 0.0;
+    initialized = false;
+    innovation  = 0.0;
+    KK          = 0.0;
+    measVec     = 0.0;
+    mscState    = 0.0;
+    phi         = 0.0;
+    PP          = 0.0;
+    residual    = 0.0;
+    RR          = 0.0;
+    UU          = 0.0;
+  }
+
+//############################################################################//
+//
+// Function: Initialize()
+//
+// Purpose:  Initialize the states and covariance from the measurement in
+//           measVec.
+//
+//############################################################################//
+  void Initialize( Scalar measRdot,
+                   Scalar angSig,
+                   Scalar rngSig,
+                   Scalar rDotSig );
+
+//############################################################################//
+//
+// Function: Propagate()
+//
+// Purpose:  Propagate the states to the measurement time
+//
+//############################################################################//
+  void Propagate( Scalar deltaTime );
+
+//############################################################################//
+//
+// Function: Update()
+//
+// Purpose:  Update the states with the measurement in measVec.  Returns
+//           false, leaving the propagated estimate, if the innovation
+//           covariance is not positive definite.
+//
+//############################################################################//
+  bool Update( Scalar angSig,
+               Scalar rngSig,
+               Scalar rDotSig );
+
+//############################################################################//
+//
+// Function: PropagateUd()
+//
+// Purpose:  Propagate the UD factors through phi, adding the process noise
+//           on the acceleration states.
+//
+//############################################################################//
+  void PropagateUd( Scalar Q44,
+                    Scalar Q55 );
+
+//############################################################################//
+//
+// Function: UpdateUd()
+//
+// Purpose:  Update the states and UD factors with the measurement in
+//           measVec and covariance in RR.
+//
+//############################################################################//
+  bool UpdateUd();
+
+//############################################################################//
+//
+// Function: IntegrateRK2()
+//
+// Purpose:  2nd order Runge Kutta integrator
+//
+//############################################################################//
+  static void IntegrateRK2( State &XX, Scalar deltaTime );
+
+//############################################################################//
+//
+// Function: CalcStateDeriv()
+//
+// Purpose:  Calculate the cartesian state derivative
+//
+//############################################################################//
+  static State CalcStateDeriv( const State &XX );
+
+//############################################################################//
+//
+// Function: MscToCart()
+//
+// Purpose:  Convert from modified spherical coordinates to cartesian
+//
+//############################################################################//
+  static void MscToCart( const State &mscState,
+                         State       &cartRel );
+
+//############################################################################//
+//
+// Function: CartToMsc()
+//
+// Purpose:  Convert from cartesian to modified spherical coordinates
+//
+//############################################################################//
+  static void CartToMsc( const State &cartRel,
+                         State       &mscState );
+};
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::Initialize( Scalar measRdot,
+                                            Scalar angSig,
+                                            Scalar rngSig,
+                                            Scalar rDotSig )
+{
+  Scalar invRng2;
+
+  initialized = true;
+
+  mscState(0) = measVec(0);    // LOS angle
+  mscState(1) = 0.0;           // LOS rate
+  mscState(2) = measVec(1);    // Inverse range
+  mscState(3) = measVec(2);    // rDot / range
+  mscState(4) = 0.0;           // Acceleration along LOS / range
+  mscState(5) = 0.0;           // Acceleration across LOS / range
+
+  invRng2 = SQ( mscState(2) );
+
+  PP[0][0] = SQ( angSig );
+
+  PP[1][1] = SQ( SQ(rDotSig) * measVec(2) );
+
+  PP[2][2] = SQ( rngSig * invRng2 );
+
+  PP[3][3] = SQ( SQ(rDotSig) * measVec(1) ) +
+             SQ( measRdot * rngSig * invRng2 );
+
+  PP[2][3] = SQ( rngSig * measVec(1) ) * measVec(1) * measVec(2);
+  PP[3][2] = PP[2][3];
+
+  PP[4][4] = singerVar * invRng2;
+  PP[5][5] = PP[4][4];
+
+  if ( covForm == UD_FACTOR::cfUD )
+  {
+    UD_FACTOR::Factor( PP, UU, DD );
+  }
+
+}  // end Initialize()
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::Propagate( Scalar deltaTime )
+{
+  Scalar alphaR;
+  Scalar cCoeff;
+  Scalar Q44;
+  Scalar Q55;
+
+  //
+  // Propagate the state vector in cartesian coordinates
+  //
+  MscToCart( mscState,
+             cartRel );
+
+  IntegrateRK2( cartRel, deltaTime );
+
+  CartToMsc( cartRel,
+             mscState );
+
+  //
+  // State transition Jacobian
+  //
+  phi = 0.0;
+
+  phi[0][0] = 1.0;
+  phi[0][1] = deltaTime;
+
+  phi[1][1] = 1.0 - 2.0 * mscState(3) * deltaTime;
+  phi[1][3] = -2.0 * mscState(1) * deltaTime;
+  phi[1][5] = deltaTime;
+
+  phi[2][2] = 1.0 - mscState(3) * deltaTime;
+  phi[2][3] = -mscState(2) * deltaTime;
+
+  phi[3][1] = 2.0 * mscState(1) * deltaTime;
+  phi[3][3] = 1.0 - 2.0 * mscState(3) * deltaTime;
+  phi[3][4] = deltaTime;
+
+  phi[4][3] = -mscState(4) * deltaTime;
+  phi[4][4] = 1.0 - (1.0 / singerTau + mscState(3)) * deltaTime;
+
+  phi[5][3] = -mscState(5) * deltaTime;
+  phi[5][5] = phi[4][4];
+
+  //
+  // Process noise matrix
+  //
+  cCoeff = 2.0 * SQ( mscState(2) ) * deltaTime / ( 3.0 * singerTau );
+
+  alphaR = cCoeff * singerVar;
+
+  Q44 = alphaR * ( SQ(phi[4][4]) + phi[4][4] + 1.0 );
+
+  Q55 = Q44;
+
+  //
+  // Propagate the estimation covariance matrix.
+  //
+  if ( covForm == UD_FACTOR::cfUD )
+  {
+    PropagateUd( Q44, Q55 );
+    return;
+  }
+
+  CovPolicy::Prop( phi, PP );
+  PP[4][4] += Q44;
+  PP[5][5] += Q55;
+
+}  // end Propagate()
+
+template <class Scalar, class CovPolicy>
+bool MscEkf<Scalar, CovPolicy>::Update( Scalar angSig,
+                                        Scalar rngSig,
+                                        Scalar rDotSig )
+{
+  Mat<3,3,Scalar> lower;
+  Mat<6,3,Scalar> PHT;
+  bool            posDef;
+  Scalar          sigmaInvRng;
+  Scalar          sigmaInvTgo2;
+  Mat<3,3,Scalar> temp0;
+
+  //
+  // Measurement covariance matrix
+  //
+  sigmaInvRng = rngSig * SQ(measVec(1));
+
+  sigmaInvTgo2 = ( SQ(rDotSig) + SQ(rngSig * measVec(2)) ) * SQ( measVec(1) );
+
+  RR[0][0] = SQ( angSig );
+  RR[1][1] = SQ( sigmaInvRng );
+  RR[2][2] = sigmaInvTgo2;
+  RR[1][2] = SQ( rngSig ) * measVec(2) * SQ( measVec(1) ) * measVec(1);
+  RR[2][1] = RR[1][2];
+
+  if ( covForm == UD_FACTOR::cfUD )
+  {
+    return UpdateUd();
+  }
+
+  //
+  // Calculate the Kalman gains.
+  //
+  //  K = P * H' * [ H * P * H' + R]^-1
+  //
+  // The innovation covariance S = H * P * H' + R is symmetric positive
+  // definite, so it is factored S = L * L' and the gain found by triangular
+  // substitution instead of forming inv(S).  With S symmetric
+  //
+  //  K' = S^-1 * ( P * H' )'
+  //
+  CovPolicy::Innovation( PP, RR, temp0 );
+
+  lower = temp0.Chol_LLt( posDef );
+  if ( !posDef )
+  {
+    return false;
+  }
+
+  CovPolicy::CrossCov( PP, PHT );
+
+  KK = MATRIX::Transpose( lower.CholSolve( MATRIX::Transpose( PHT ) ) );
+
+  //
+  // Update the state with the measurement
+  //
+  // residual = Z - H * x
+  //
+  CovPolicy::Residual( measVec, mscState, residual );
+
+  innovation = KK * residual;
+
+  mscState += innovation;
+
+  //
+  // Update the estimation covariance
+  //
+  CovPolicy::Joseph( KK, RR, PP );
+
+  return true;
+
+}  // end Update()
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::PropagateUd( Scalar Q44,
+                                             Scalar Q55 )
+{
+  Mat<8,1,Scalar> DW;
+  Mat<6,8,Scalar> WW;
+
+  //
+  // W = [ phi * U | e4 e5 ], using the nonzeros of phi and the upper
+  // triangle of U.
+  //
+  WW = 0.0;
+
+  for ( int row = 0; row < 6; ++row )
+  {
+    for ( int nz = 0; nz < MSC_COV::PHI_NNZ[row]; ++nz )
+    {
+      int    kk  = MSC_COV::PHI_COLS[row][nz];
+      Scalar phk = phi[row][kk];
+
+      for ( int col = kk; col < 6; ++col )
+      {
+        WW[row][col] += phk * UU[kk][col];
+      }
+    }
+
+    DW(row) = DD(row);
+  }
+
+  WW[4][6] = 1.0;
+  WW[5][7] = 1.0;
+
+  DW(6) = Q44;
+  DW(7) = Q55;
+
+  UD_FACTOR::TimeUpdate( WW, DW, UU, DD );
+
+}  // end PropagateUd()
+
+template <class Scalar, class CovPolicy>
+bool MscEkf<Scalar, CovPolicy>::UpdateUd()
+{
+  Mat<6,1,Scalar> gain;
+  Mat<6,1,Scalar> hh;
+  Mat<3,3,Scalar> invLower;
+  Mat<3,3,Scalar> lower;
+  bool            posDef;
+  Mat<3,1,Scalar> resid;
+  State           stateStart;
+  Scalar          yy;
+
+  //
+  // With RR = L * L', the measurements L^-1 * Z are uncorrelated with unit
+  // variance, and row m of L^-1 * H picks states MEAS_IDX[0..m].
+  //
+  lower = RR.Chol_LLt( posDef );
+  if ( !posDef )
+  {
+    UD_FACTOR::Compose( UU, DD, PP );
+    return false;
+  }
+
+  invLower = 0.0;
+
+  for ( int col = 0; col < 3; ++col )
+  {
+    invLower[col][col] = 1.0 / lower[col][col];
+
+    for ( int row = col + 1; row < 3; ++row )
+    {
+      Scalar sum(0.0);
+
+      for ( int kk = col; kk < row; ++kk )
+      {
+        sum += lower[row][kk] * invLower[kk][col];
+      }
+
+      invLower[row][col] = -sum / lower[row][row];
+    }
+  }
+
+  MSC_COV::Residual( measVec, mscState, residual );
+
+  stateStart = mscState;
+
+  for ( int meas = 0; meas < 3; ++meas )
+  {
+    hh = 0.0;
+    yy = 0.0;
+
+    MSC_COV::Residual( measVec, mscState, resid );
+
+    for ( int kk = 0; kk <= meas; ++kk )
+    {
+      hh( MSC_COV::MEAS_IDX[kk] ) = invLower[meas][kk];
+      yy += invLower[meas][kk] * resid(kk);
+    }
+
+    if ( !UD_FACTOR::MeasUpdate( hh, Scalar(1.0), UU, DD, gain ) )
+    {
+      UD_FACTOR::Compose( UU, DD, PP );
+      return false;
+    }
+
+    for ( int row = 0; row < 6; ++row )
+    {
+      KK[row][meas] = gain(row);
+      mscState(row) += gain(row) * yy;
+    }
+  }
+
+  innovation = mscState - stateStart;
+
+  UD_FACTOR::Compose( UU, DD, PP );
+
+  return true;
+
+}  // end UpdateUd()
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::IntegrateRK2( State &XX, Scalar deltaTime )
+{
+  Scalar half = 0.5;
+  State  stateDerivK;
+  State  stateDerivKp1;
+  State  stateIncrement;
+  State  stateTemp;
+
+  //
+  // Get derivative at current time
+  //
+  stateDerivK = CalcStateDeriv( XX );
+
+  //
+  // Get derivative at next time step
+  //
+  stateIncrement = stateDerivK * deltaTime;
+
+  stateTemp = XX + stateIncrement;
+
+  stateDerivKp1 = CalcStateDeriv( stateTemp );
+
+  //
+  // The final state increment is calculated from the average of the current
+  // and next state derivatives.
+  //
+  stateIncrement = (stateDerivK + stateDerivKp1) * deltaTime * half;
+
+  XX += stateIncrement;
+
+}  // end IntegrateRK2()
+
+template <class Scalar, class CovPolicy>
+typename MscEkf<Scalar, CovPolicy>::State
+MscEkf<Scalar, CovPolicy>::CalcStateDeriv( const State &XX )
+{
+  State deriv;
+
+  deriv(0) = XX(2);  // d/dt(posX) = velX
+  deriv(1) = XX(3);  // d/dt(posY) = velY
+  deriv(2) = XX(4);  // d/dt(velX) = accX
+  deriv(3) = XX(5);  // d/dt(velY) = accY
+  deriv(4) = 0.0;    // d/dt(accX) = 0.0
+  deriv(5) = 0.0;    // d/dy(accY) = 0.0
+
+  return( deriv );
+
+} // end CalcStateDeriv()
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::MscToCart( const State &mscState,
+                                           State       &cartRel )
+{
+  using std::cos;
+  using std::sin;
+
+  Scalar range = 1.0 / mscState(2);
+  Scalar rDot = mscState(3) * range;
+
+  Scalar cth = cos( mscState(0) );
+  Scalar sth = sin( mscState(0) );
+
+  Scalar thDot = mscState(1);
+
+  cartRel(0) = range * cth;
+  cartRel(1) = range * sth;
+
+  cartRel(2) = rDot * cth - range * thDot * sth;
+  cartRel(3) = rDot * sth + range * thDot * cth;
+
+  cartRel(4) = range * ( mscState(4) * cth - mscState(5) * sth );
+  cartRel(5) = range * ( mscState(4) * sth + mscState(5) * cth );
+
+}  // end MSCtoCart()
+
+template <class Scalar, class CovPolicy>
+void MscEkf<Scalar, CovPolicy>::CartToMsc( const State &cartRel,
+                                           State       &mscState )
+{
+  using std::atan2;
+  using std::cos;
+  using std::sin;
+  using std::sqrt;
+
+  Scalar range2 = SQ( cartRel(0) ) + SQ( cartRel(1) );
+
+  Scalar range = sqrt( range2 );
+
+  Scalar rDot = ( cartRel(0) * cartRel(2) + cartRel(1) * cartRel(3) ) / range;
+
+  Scalar losAng = atan2(cartRel(1), cartRel(0) );
+
+  Scalar losr = ( cartRel(0) * cartRel(3) - cartRel(1) * cartRel(2) ) / range2;
+
+  Scalar cth = cos( losAng );
+  Scalar sth = sin( losAng );
+
+  Scalar Ar =  cartRel(4) * cth + cartRel(5) * sth;
+  Scalar Ac = -cartRel(4) * sth + cartRel(5) * cth;
+
+  mscState(0) = losAng;
+  mscState(1) = losr;
+  mscState(2) = 1.0 / range;
+  mscState(3) = mscState(2) * rDot;
+  mscState(4) = Ar / range;
+  mscState(5) = Ac / range;
+
+}  // end CartToMSC()
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
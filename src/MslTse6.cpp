@@ -41,7 +41,7 @@ using std::endl;
 //#include "genMath.h"
 //#include "genMathStatLib.h"
 //using namespace genMath;
-#include "Matrix.hpp"
+#include "Mat.hpp"
 using namespace MATRIX;
 
 #include "MathUtils.hpp"
@@ -74,27 +74,74 @@ MdlBase()
 
   datalinkStep = 1.0 / 64;        // Datalink uplink interval
   nextUpLinkTime = initFrameTime; // Next datalink uplink time
+  covFormInt = 1;                 // Joseph form covariance
   singerTau = 0.3;                // Kalman process noise tuning parameter
   singerVar = 600.0;              // Kalman process noise tuning parameter
 
   //
-  // Set matrix sizes
-  //
-  cartRel.Resize(6,1);
-  truState.Resize(6,1);
-  dlState.Resize(6,1);
-  eye.Eye(6);
-  HH.Resize(3,6);
-  HT.Resize(6,3);
-  innovation.Resize(6,1);
-  KK.Resize(6,3);
-  measVec.Resize(3,1);
-  mscState.Resize(6,1);
-  phi.Resize(6,6);
-  PP.Resize(6,6);
-  residual.Resize(3,1);
-  RR.Resize(3,3);
-   
+  // Register output channels
+  //
+  RegisterChannel( "mslTse6.estAccX", "m/sec^2", estAccX );
+  RegisterChannel( "mslTse6.estAccY", "m/sec^2", estAccY );
+  RegisterChannel( "mslTse6.estLosAng", "rad", estLosAng );
+  RegisterChannel( "mslTse6.estLosr", "rad/sec", estLosr );
+  RegisterChannel( "mslTse6.estRng", "m", estRng );
+  RegisterChannel( "mslTse6.estRdot", "m/sec", estRdot );
+  RegisterChannel( "mslTse6.estTgtPxf", "m", estTgtPxf );
+  RegisterChannel( "mslTse6.estTgtPyf", "m", estTgtPyf );
+  RegisterChannel( "mslTse6.estTgtVxf", "m/sec", estTgtVxf );
+  RegisterChannel( "mslTse6.estTgtVyf", "m/sec", estTgtVyf );
+  RegisterChannel( "mslTse6.estTgtAxf", "m/sec^2", estTgtAxf );
+  RegisterChannel( "mslTse6.estTgtAyf", "m/sec^2", estTgtAyf );
+  RegisterChannel( "mslTse6.estTgtJxf", "m/sec^3", estTgtJxf );
+  RegisterChannel( "mslTse6.estTgtJyf", "m/sec^3", estTgtJyf );
+  RegisterChannel( "mslTse6.measAng", "rad", measAng );
+  RegisterChannel( "mslTse6.measRng", "m", measRng );
+  RegisterChannel( "mslTse6.measRdot", "m/sec", measRdot );
+  RegisterChannel( "mslTse6.measVec0", "rad", ekf.measVec(0) );
+  RegisterChannel( "mslTse6.measVec1", "1/m", ekf.measVec(1) );
+  RegisterChannel( "mslTse6.measVec2", "1/sec", ekf.measVec(2) );
+  RegisterChannel( "mslTse6.mscState0", "rad", ekf.mscState(0) );
+  RegisterChannel( "mslTse6.mscState1", "rad/sec", ekf.mscState(1) );
+  RegisterChannel( "mslTse6.mscState2", "1/m", ekf.mscState(2) );
+  RegisterChannel( "mslTse6.mscState3", "1/sec", ekf.mscState(3) );
+  RegisterChannel( "mslTse6.mscState4", "1/sec^2", ekf.mscState(4) );
+  RegisterChannel( "mslTse6.mscState5", "1/sec^2", ekf.mscState(5) );
+  RegisterChannel( "mslTse6.timeStamp", "sec", timeStamp );
+  RegisterChannel( "mslTse6.P00", "rad^2", ekf.PP[0][0] );
+  RegisterChannel( "mslTse6.P11", "rad^2/sec^2", ekf.PP[1][1] );
+  RegisterChannel( "mslTse6.P22", "1/m^2", ekf.PP[2][2] );
+  RegisterChannel( "mslTse6.P33", "1/sec^2", ekf.PP[3][3] );
+  RegisterChannel( "mslTse6.P44", "1/sec^4", ekf.PP[4][4] );
+  RegisterChannel( "mslTse6.P55", "1/sec^4", ekf.PP[5][5] );
+  RegisterChannel( "mslTse6.residual0", "rad", ekf.residual(0) );
+  RegisterChannel( "mslTse6.residual1", "1/m", ekf.residual(1) );
+  RegisterChannel( "mslTse6.residual2", "1/sec", ekf.residual(2) );
+  RegisterChannel( "mslTse6.cartState0", "m", ekf.cartRel(0) );
+  RegisterChannel( "mslTse6.cartState1", "m", ekf.cartRel(1) );
+  RegisterChannel( "mslTse6.cartState2", "m/sec", ekf.cartRel(2) );
+  RegisterChannel( "mslTse6.cartState3", "m/sec", ekf.cartRel(3) );
+  RegisterChannel( "mslTse6.cartState4", "m/sec^2", ekf.cartRel(4) );
+  RegisterChannel( "mslTse6.cartState5", "m/sec^2", ekf.cartRel(5) );
+  RegisterChannel( "mslTse6.truRelPxf", "m", truRelPxf );
+  RegisterChannel( "mslTse6.truRelPyf", "m", truRelPyf );
+  RegisterChannel( "mslTse6.truRelVxf", "m/sec", truRelVxf );
+  RegisterChannel( "mslTse6.truRelVyf", "m/sec", truRelVyf );
+  RegisterChannel( "mslTse6.truRelAxf", "m/sec^2", truRelAxf );
+  RegisterChannel( "mslTse6.truRelAyf", "m/sec^2", truRelAyf );
+  RegisterChannel( "mslTse6.truAccLosX", "m/sec^2", truAccLosX );
+  RegisterChannel( "mslTse6.truAccLosY", "m/sec^2", truAccLosY );
+  RegisterChannel( "mslTse6.truLosAng", "rad", truLosAng );
+  RegisterChannel( "mslTse6.truLosr", "rad/sec", truLosr );
+  RegisterChannel( "mslTse6.truRng", "m", truRng );
+  RegisterChannel( "mslTse6.truRdot", "m/sec", truRdot );
+  RegisterChannel( "mslTse6.truState0", "rad", truState(0) );
+  RegisterChannel( "mslTse6.truState1", "rad/sec", truState(1) );
+  RegisterChannel( "mslTse6.truState2", "1/m", truState(2) );
+  RegisterChannel( "mslTse6.truState3", "1/sec", truState(3) );
+  RegisterChannel( "mslTse6.truState4", "1/sec^2", truState(4) );
+  RegisterChannel( "mslTse6.truState5", "1/sec^2", truState(5) );
+
 }
 
 //############################################################################//
@@ -118,8 +165,6 @@ MslTse6::~MslTse6()
 //############################################################################//
 void MslTse6::Initialize()
 {
-  int idx;
-
   ResetAll();
 
   simTime = GetSimTime();
@@ -132,16 +177,9 @@ void MslTse6::Initialize()
   assert( pTse6 );
   assert( pTseO );
 
-  for (idx = 0; idx < 6; ++idx)
-  {
-    eye[idx][idx] = 1.0;
-  }
-
-  HH[0][0] = 1.0;
-  HH[1][2] = 1.0;
-  HH[2][3] = 1.0;
-
-  HT = Transpose( HH );
+  ekf.covForm = static_cast<UD_FACTOR::CovForm>( covFormInt );
+  ekf.singerTau = singerTau;
+  ekf.singerVar = singerVar;
 
   initFrameTime = pMsl->launchTime;
 
@@ -307,7 +345,7 @@ void MslTse6::FrameUpdate()
       
       dlTgtVyf = rdrVyf + dlRdot * sth + dlRng * dlLosr * cth;
 
-      dlTgtAxf = pTse6->cartRel(4);
+      dlTgtAxf = pTse6->ekf.cartRel(4);
       dlTgtAyf = -dlTgtPyf * dlOmega2;
 
       dlTgtJxf = 0.0;
@@ -332,7 +370,7 @@ void MslTse6::FrameUpdate()
     dlState(4) = dlTgtAxf;
     dlState(5) = dlTgtAyf;
 
-    IntegrateRK2( dlState, pSkr->timeStamp - priorDlTime );
+    ekf.IntegrateRK2( dlState, pSkr->timeStamp - priorDlTime );
     priorDlTime = pSkr->timeStamp;
 
     dlTgtPxf = dlState(0);
@@ -377,9 +415,9 @@ void MslTse6::FrameUpdate()
 
   rDotSig = dlRdotSig;
 
-  measVec(0) = measAng;
-  measVec(1) = 1.0 / measRng;
-  measVec(2) = measRdot / measRng;
+  ekf.measVec(0) = measAng;
+  ekf.measVec(1) = 1.0 / measRng;
+  ekf.measVec(2) = measRdot / measRng;
 
   PropStates( pSkr->timeStamp - timeStamp );
 
@@ -387,21 +425,21 @@ void MslTse6::FrameUpdate()
 
   UpdateStates();
 
-  estLosAng = mscState(0);
-  estLosr = mscState(1);
-  estRng = 1.0 / mscState(2);
-  estRdot = mscState(3) * estRng;
-  estAccX = mscState(4) * estRng;
-  estAccY = mscState(5) * estRng;
+  estLosAng = ekf.mscState(0);
+  estLosr = ekf.mscState(1);
+  estRng = 1.0 / ekf.mscState(2);
+  estRdot = ekf.mscState(3) * estRng;
+  estAccX = ekf.mscState(4) * estRng;
+  estAccY = ekf.mscState(5) * estRng;
 
-  estTgtPxf = mslPxf + cartRel(0);
-  estTgtPyf = mslPyf + cartRel(1);
+  estTgtPxf = mslPxf + ekf.cartRel(0);
+  estTgtPyf = mslPyf + ekf.cartRel(1);
 
-  estTgtVxf = mslVxf + cartRel(2);
-  estTgtVyf = mslVyf + cartRel(3);
+  estTgtVxf = mslVxf + ekf.cartRel(2);
+  estTgtVyf = mslVyf + ekf.cartRel(3);
 
-  estTgtAxf = mslAxf + cartRel(4);
-  estTgtAyf = mslAyf + cartRel(5);
+  estTgtAxf = mslAxf + ekf.cartRel(4);
+  estTgtAyf = mslAyf + ekf.cartRel(5);
 
   estTgtJxf = 0.0;
   estTgtJyf = estTgtPyf * dlOmega2*dlOmega;
@@ -442,169 +480,6 @@ void MslTse6::Finalize()
   simTime = GetSimTime();
 }
  
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void MslTse6::Output( bool printHeader,
-                     FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "mslTse6.estAccX" );
-    fprintf( pOutFile, "%20s", "mslTse6.estAccY" );
-    fprintf( pOutFile, "%20s", "mslTse6.estLosAng" );
-    fprintf( pOutFile, "%20s", "mslTse6.estLosr" );
-    fprintf( pOutFile, "%20s", "mslTse6.estRng" );
-    fprintf( pOutFile, "%20s", "mslTse6.estRdot" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtPxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtPyf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtVxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtVyf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtAxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtAyf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtJxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.estTgtJyf" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.measAng" );
-    fprintf( pOutFile, "%20s", "mslTse6.measRng" );
-    fprintf( pOutFile, "%20s", "mslTse6.measRdot" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.measVec0" );
-    fprintf( pOutFile, "%20s", "mslTse6.measVec1" );
-    fprintf( pOutFile, "%20s", "mslTse6.measVec2" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.mscState0" );
-    fprintf( pOutFile, "%20s", "mslTse6.mscState1" );
-    fprintf( pOutFile, "%20s", "mslTse6.mscState2" );
-    fprintf( pOutFile, "%20s", "mslTse6.mscState3" );
-    fprintf( pOutFile, "%20s", "mslTse6.mscState4" );
-    fprintf( pOutFile, "%20s", "mslTse6.mscState5" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.timeStamp" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.P00" );
-    fprintf( pOutFile, "%20s", "mslTse6.P11" );
-    fprintf( pOutFile, "%20s", "mslTse6.P22" );
-    fprintf( pOutFile, "%20s", "mslTse6.P33" );
-    fprintf( pOutFile, "%20s", "mslTse6.P44" );
-    fprintf( pOutFile, "%20s", "mslTse6.P55" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.residual0" );
-    fprintf( pOutFile, "%20s", "mslTse6.residual1" );
-    fprintf( pOutFile, "%20s", "mslTse6.residual2" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.cartState0" );
-    fprintf( pOutFile, "%20s", "mslTse6.cartState1" );
-    fprintf( pOutFile, "%20s", "mslTse6.cartState2" );
-    fprintf( pOutFile, "%20s", "mslTse6.cartState3" );
-    fprintf( pOutFile, "%20s", "mslTse6.cartState4" );
-    fprintf( pOutFile, "%20s", "mslTse6.cartState5" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.truRelPxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRelPyf" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRelVxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRelVyf" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRelAxf" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRelAyf" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.truAccLosX" );
-    fprintf( pOutFile, "%20s", "mslTse6.truAccLosY" );
-    fprintf( pOutFile, "%20s", "mslTse6.truLosAng" );
-    fprintf( pOutFile, "%20s", "mslTse6.truLosr" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRng" );
-    fprintf( pOutFile, "%20s", "mslTse6.truRdot" );
-
-    fprintf( pOutFile, "%20s", "mslTse6.truState0" );
-    fprintf( pOutFile, "%20s", "mslTse6.truState1" );
-    fprintf( pOutFile, "%20s", "mslTse6.truState2" );
-    fprintf( pOutFile, "%20s", "mslTse6.truState3" );
-    fprintf( pOutFile, "%20s", "mslTse6.truState4" );
-    fprintf( pOutFile, "%20s", "mslTse6.truState5" );
-  }
-  else
-  {
-    fprintf( pOutFile, "%20.6e", estAccX );
-    fprintf( pOutFile, "%20.6e", estAccY );
-    fprintf( pOutFile, "%20.6e", estLosAng );
-    fprintf( pOutFile, "%20.6e", estLosr );
-    fprintf( pOutFile, "%20.6e", estRng );
-    fprintf( pOutFile, "%20.6e", estRdot );
-
-    fprintf( pOutFile, "%20.6e", estTgtPxf );
-    fprintf( pOutFile, "%20.6e", estTgtPyf );
-    fprintf( pOutFile, "%20.6e", estTgtVxf );
-    fprintf( pOutFile, "%20.6e", estTgtVyf );
-    fprintf( pOutFile, "%20.6e", estTgtAxf );
-    fprintf( pOutFile, "%20.6e", estTgtAyf );
-    fprintf( pOutFile, "%20.6e", estTgtJxf );
-    fprintf( pOutFile, "%20.6e", estTgtJyf );
-
-    fprintf( pOutFile, "%20.6e", measAng );
-    fprintf( pOutFile, "%20.6e", measRng );
-    fprintf( pOutFile, "%20.6e", measRdot );
-
-    fprintf( pOutFile, "%20.6e", measVec(0) );
-    fprintf( pOutFile, "%20.6e", measVec(1) );
-    fprintf( pOutFile, "%20.6e", measVec(2) );
-
-    fprintf( pOutFile, "%20.6e", mscState(0) );
-    fprintf( pOutFile, "%20.6e", mscState(1) );
-    fprintf( pOutFile, "%20.6e", mscState(2) );
-    fprintf( pOutFile, "%20.6e", mscState(3) );
-    fprintf( pOutFile, "%20.6e", mscState(4) );
-    fprintf( pOutFile, "%20.6e", mscState(5) );
-
-    fprintf( pOutFile, "%20.6e", timeStamp );
-
-    fprintf( pOutFile, "%20.6e", PP[0][0] );
-    fprintf( pOutFile, "%20.6e", PP[1][1] );
-    fprintf( pOutFile, "%20.6e", PP[2][2] );
-    fprintf( pOutFile, "%20.6e", PP[3][3] );
-    fprintf( pOutFile, "%20.6e", PP[4][4] );
-    fprintf( pOutFile, "%20.6e", PP[5][5] );
-
-    fprintf( pOutFile, "%20.6e", residual(0) );
-    fprintf( pOutFile, "%20.6e", residual(1) );
-    fprintf( pOutFile, "%20.6e", residual(2) );
-
-    fprintf( pOutFile, "%20.6e", cartRel(0) );
-    fprintf( pOutFile, "%20.6e", cartRel(1) );
-    fprintf( pOutFile, "%20.6e", cartRel(2) );
-    fprintf( pOutFile, "%20.6e", cartRel(3) );
-    fprintf( pOutFile, "%20.6e", cartRel(4) );
-    fprintf( pOutFile, "%20.6e", cartRel(5) );
-
-    fprintf( pOutFile, "%20.6e", truRelPxf );
-    fprintf( pOutFile, "%20.6e", truRelPyf );
-    fprintf( pOutFile, "%20.6e", truRelVxf );
-    fprintf( pOutFile, "%20.6e", truRelVyf );
-    fprintf( pOutFile, "%20.6e", truRelAxf );
-    fprintf( pOutFile, "%20.6e", truRelAyf );
-
-    fprintf( pOutFile, "%20.6e", truAccLosX );
-    fprintf( pOutFile, "%20.6e", truAccLosY );
-    fprintf( pOutFile, "%20.6e", truLosAng );
-    fprintf( pOutFile, "%20.6e", truLosr );
-    fprintf( pOutFile, "%20.6e", truRng );
-    fprintf( pOutFile, "%20.6e", truRdot );
-
-    fprintf( pOutFile, "%20.6e", truState(0) );
-    fprintf( pOutFile, "%20.6e", truState(1) );
-    fprintf( pOutFile, "%20.6e", truState(2) );
-    fprintf( pOutFile, "%20.6e", truState(3) );
-    fprintf( pOutFile, "%20.6e", truState(4) );
-    fprintf( pOutFile, "%20.6e", truState(5) );
-
-  }
-}  // end Output()
-
 //
 // Class scope functions
 //
@@ -616,102 +491,15 @@ void MslTse6::Output( bool printHeader,
 // Purpose:  Propagate the states to the measurement time
 //
 //############################################################################//
-  void MslTse6::PropStates( double deltaTime )
+void MslTse6::PropStates( double deltaTime )
 {
-  double alphaR;
-  double cCoeff;
-  double invRng2;
-  double Q44;
-  double Q55;
-
-  if ( !initialized )
+  if ( !ekf.initialized )
   {
-    initialized = true;
-
-    mscState(0) = measVec(0);    // LOS angle
-    mscState(1) = 0.0;           // LOS rate
-    mscState(2) = measVec(1);    // Inverse range
-    mscState(3) = measVec(2);    // rDot / range
-    mscState(4) = 0.0;           // Acceleration along LOS / range
-    mscState(5) = 0.0;           // Acceleration across LOS / range
-
-    invRng2 = SQ( mscState(2) );
-
-    PP[0][0] = SQ( angSig );
-    
-    PP[1][1] = SQ( SQ(rDotSig) * measVec(2) );
-
-    PP[2][2] = SQ( rngSig * invRng2 );
-
-    PP[3][3] = SQ( SQ(rDotSig) * measVec(1) ) +
-               SQ( measRdot * rngSig * invRng2 );
-
-    PP[2][3] = SQ( rngSig * measVec(1) ) * measVec(1) * measVec(2);
-    PP[3][2] = PP[2][3];
-
-    PP[4][4] = singerVar * invRng2;
-    PP[5][5] = PP[4][4];
-
-  }  // end if ( !initialized )
-
-  //
-  // Propagate the state vector in cartesian coordinates
-  //
-  MscToCart( mscState,
-             cartRel );
-
-
-  IntegrateRK2( cartRel, deltaTime );
-
-  CartToMsc( cartRel,
-             mscState );
-
-  //
-  // Propagate the estimation covariance matrix
-  //
-  //
-  // State transition Jacobian
-  //
-  phi = 0.0;
-
-  phi[0][0] = 1.0;
-  phi[0][1] = deltaTime;
-
-  phi[1][1] = 1.0 - 2.0 * mscState(3) * deltaTime;
-  phi[1][3] = -2.0 * mscState(1) * deltaTime;
-  phi[1][5] = deltaTime;
-
-  phi[2][2] = 1.0 - mscState(3) * deltaTime;
-  phi[2][3] = -mscState(2) * deltaTime;
-
-  phi[3][1] = 2.0 * mscState(1) * deltaTime;
-  phi[3][3] = 1.0 - 2.0 * mscState(3) * deltaTime;
-  phi[3][4] = deltaTime;
-
-  phi[4][3] = -mscState(4) * deltaTime;
-  phi[4][4] = 1.0 - (1.0 / singerTau + mscState(3)) * deltaTime;
- 
-  phi[5][3] = -mscState(5) * deltaTime;
-  phi[5][5] = phi[4][4];
-
-  //
-  // Process noise matrix
-  //
-  cCoeff = 2.0 * SQ( mscState(2) ) * deltaTime / ( 3.0 * singerTau );
-
-  alphaR = cCoeff * singerVar;
-    
-  Q44 = alphaR * ( SQ(phi[4][4]) + phi[4][4] + 1.0 );
+    ekf.Initialize( measRdot, angSig, rngSig, rDotSig );
+  }
 
-  Q55 = Q44;
+  ekf.Propagate( deltaTime );
 
-  //
-  // Propagate the estimation covariance matrix.
-  //
-  PP = phi * PP * Transpose( phi );
-  PP[4][4] += Q44;
-  PP[5][5] += Q55;
- 
 }  // end PropStates()
 
 //############################################################################//
@@ -723,198 +511,17 @@ void MslTse6::Output( bool printHeader,
 //############################################################################//
 void MslTse6::UpdateStates()
 {
-  Matrix   invTemp33(3,3);
-  double   sigmaInvRng;
-  double   sigmaInvTgo2;
-  Matrix   temp0(3,3);
-  Matrix   temp1(6,6);
-  bool     test;
-
-  //
-  // Measurement covariance matrix
-  //
-  sigmaInvRng = rngSig * SQ(measVec(1));
-
-  sigmaInvTgo2 = ( SQ(rDotSig) + SQ(rngSig * measVec(2)) ) * SQ( measVec(1) );
-
-  RR[0][0] = SQ( angSig );
-  RR[1][1] = SQ( sigmaInvRng );
-  RR[2][2] = sigmaInvTgo2;
-  RR[1][2] = SQ( rngSig ) * measVec(2) * SQ( measVec(1) ) * measVec(1);
-  RR[2][1] = RR[1][2];
-
-  //
-  // Calculate the Kalman gains.
-  //
-  //  K = P * H' * [ H * P * H' + R]^-1
-  //
-  temp0 = HH * PP * HT + RR;  
-
-//  test = temp0.Invert();
-
-  test = inv33( temp0, invTemp33 );
-  if ( !test )
+  if ( !ekf.Update( angSig, rngSig, rDotSig ) )
   {
-    cout << "MslTse::UpdateStates() temp33 matrix inversion fail @ time = " 
-             << simTime << endl;
-    exit( 1 );
+    //
+    // Skip this measurement and carry the propagated estimate.
+    //
+    cout << "MslTse::UpdateStates() innovation covariance not positive "
+         << "definite, measurement skipped @ time = " << simTime << endl;
   }
-  temp0 = invTemp33;
-
-
-  KK = PP * HT  * temp0;
-
-  //
-  // Update the state with the measurement
-  //
-  // residual = Z - H * x
-  //
-  residual = measVec - HH * mscState;
-
-  innovation = KK * residual;
-
-  mscState += innovation;
-
-  //
-  // Update the estimation covariance
-  //
-  temp1 = eye - KK * HH;
-
-  PP = temp1 * PP * Transpose( temp1 ) + KK * RR * Transpose( KK );
 
 }  // end UpdateStates()
 
-//############################################################################//
-//
-// Function: IntegrateRK2()
-//
-// Purpose:  2nd order Runge Kutta integrator
-//
-//############################################################################//
-void MslTse6::IntegrateRK2( Matrix &XX, double deltaTime  )
-{
-  double  half = 0.5;
-  Matrix  stateDerivK(6,1);
-  Matrix  stateDerivKp1(6,1);
-  Matrix  stateIncrement(6,1);
-  Matrix  stateTemp(6,1);
-
-  //
-  // Get derivative at current time
-  //
-  stateDerivK = CalcStateDeriv( XX );
-
-  //
-  // Get derivative at next time step
-  //
-  stateIncrement = stateDerivK * deltaTime;
-
-  stateTemp = XX + stateIncrement;
-
-  stateDerivKp1 = CalcStateDeriv( stateTemp );
-
-  //
-  // The final state increment is calculated from the average of the current
-  // and next state derivatives.
-  //
-  stateIncrement = (stateDerivK + stateDerivKp1) * deltaTime * half;
-
-  XX += stateIncrement;
-
-}  // end IntegrateRK2()
-
-//############################################################################//
-//
-// Function: CalcStateDeriv()
-//
-// Purpose:  Calculate the state derivative vector
-//
-//   posY = X0 = A * sin( omega * t )
-//
-//   velY = X1 = A * omega * cos( omega * t )
-//
-//   accY = -X2*X0 = -A * omega^2 * sin( omega * t )
-//  
-//############################################################################//
-Matrix  MslTse6::CalcStateDeriv( Matrix  &XX )
-{
-  Matrix  deriv(6,1);
-                             
-  deriv(0) = XX(2);  // d/dt(posX) = velX
-  deriv(1) = XX(3);  // d/dt(posY) = velY
-  deriv(2) = XX(4);  // d/dt(velX) = accX
-  deriv(3) = XX(5);  // d/dt(velY) = accY
-  deriv(4) = 0.0;    // d/dt(accX) = 0.0
-  deriv(5) = 0.0;    // d/dy(accY) = 0.0
-
-  return( deriv );
-
-} // end CalcStateDeriv()
-
-//############################################################################//
-//
-// Function: MscToCart()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-void MslTse6::MscToCart( Matrix &mscState,
-                         Matrix &cartRel )
-{
-  double range = 1.0 / mscState(2);
-  double rDot = mscState(3) * range;
-
-  double cth = cos( mscState(0) );
-  double sth = sin( mscState(0) );
-
-  double thDot = mscState(1);
-
-  cartRel(0) = range * cth;
-  cartRel(1) = range * sth;
-  
-  cartRel(2) = rDot * cth - range * thDot * sth;
-  cartRel(3) = rDot * sth + range * thDot * cth;
-
-  cartRel(4) = range * ( mscState(4) * cth - mscState(5) * sth );
-  cartRel(5) = range * ( mscState(4) * sth + mscState(5) * cth );
-
-}  // end MSCtoCart()
-
-//############################################################################//
-//
-// Function: CartToMsc()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-void MslTse6::CartToMsc( Matrix &cartRel,
-                         Matrix &mscState )
-{
-  double range2 = SQ( cartRel(0) ) + SQ( cartRel(1) );
-
-  double range = sqrt( range2 );
-
-  double rDot = ( cartRel(0) * cartRel(2) + cartRel(1) * cartRel(3) ) / range;
-
-  double losAng = atan2(cartRel(1), cartRel(0) );
-
-  double losr = ( cartRel(0) * cartRel(3) - cartRel(1) * cartRel(2) ) / range2;
-
-  double cth = cos( losAng );
-  double sth = sin( losAng );
-
-  double Ar =  cartRel(4) * cth + cartRel(5) * sth;
-  double Ac = -cartRel(4) * sth + cartRel(5) * cth;
-
-  mscState(0) = losAng;
-  mscState(1) = losr;
-  mscState(2) = 1.0 / range;
-  mscState(3) = mscState(2) * rDot;
-  mscState(4) = Ar / range;
-  mscState(5) = Ac / range;
-
-}  // end CartToMSC()
-
 //############################################################################//
 //
 // Function: ResetAll()
@@ -925,11 +532,13 @@ void MslTse6::CartToMsc( Matrix &cartRel,
 void MslTse6::ResetAll()
 {
   angSig      = 0.0;
-  cartRel     = 0.0;
   dlAccX      = 0.0;
   dlAccY      = 0.0;
   dlLosAng    = 0.0;
   dlLosr      = 0.0;
+  dlOmega     = 0.0;
+  dlOmega2    = 0.0;
+  dlPosYdot   = 0.0;
   dlRdot      = 0.0;
   dlRdotSig   = 0.0;
   dlRng       = 0.0;
@@ -938,23 +547,28 @@ void MslTse6::ResetAll()
   dlState     = 0.0;
   dlTgtAxf    = 0.0;
   dlTgtAyf    = 0.0;
+  dlTgtJxf    = 0.0;
+  dlTgtJyf    = 0.0;
   dlTgtPxf    = 0.0;
   dlTgtPyf    = 0.0;
   dlTgtVxf    = 0.0;
   dlTgtVyf    = 0.0;
   dlTimeStamp = 0.0;
+  ekf.Reset();
   estAccX     = 0.0;
   estAccY     = 0.0;
   estLosAng   = 0.0;
   estLosr     = 0.0;
   estRng      = 0.0;
   estRdot     = 0.0;
-  eye         = 0.0;
-  HH          = 0.0;
-  HT          = 0.0;
-  initialized = false;
-  innovation  = 0.0;
-  KK          = 0.0;
+  estTgtAxf   = 0.0;
+  estTgtAyf   = 0.0;
+  estTgtJxf   = 0.0;
+  estTgtJyf   = 0.0;
+  estTgtPxf   = 0.0;
+  estTgtPyf   = 0.0;
+  estTgtVxf   = 0.0;
+  estTgtVyf   = 0.0;
   measAng     = 0.0;
   measRng     = 0.0;
   measRdot    = 0.0;
@@ -962,8 +576,6 @@ void MslTse6::ResetAll()
   measRelPyf  = 0.0;
   measRelVxf  = 0.0;
   measRelVyf  = 0.0;
-  measVec     = 0.0;
-  mscState    = 0.0;
   mslAxf      = 0.0;
   mslAyf      = 0.0;
   mslPxf      = 0.0;
@@ -971,17 +583,13 @@ void MslTse6::ResetAll()
   mslVxf      = 0.0;
   mslVyf      = 0.0;
   omega       = 0.0;
-  phi         = 0.0;
-  PP          = 0.0;
   priorDlTime = 0.0;
   rDotSig     = 0.0;
   rdrPxf      = 0.0;
   rdrPyf      = 0.0;
   rdrVxf      = 0.0;
   rdrVyf      = 0.0;
-  residual    = 0.0;
   rngSig      = 0.0;
-  RR          = 0.0;
   simTime     = 0.0;
   tgtAxf      = 0.0;
   tgtAyf      = 0.0;
@@ -1012,22 +620,6 @@ void MslTse6::ResetAll()
 }  // end ResetAll()
 
 
-//############################################################################//
-//
-// Function: inv33()
-//
-// Purpose:  Safely invert a 3x3 matrix using Gaussian elimination.
-//
-//############################################################################//
-bool MslTse6::inv33(Matrix &matIn, Matrix &matOut )
-{
-  bool test(true);
-  
-  matOut = matIn.Inv();
-
-  return( test ); 
-}
-
 //############################################################################//
 //                                UNCLASSIFIED                                //
 //############################################################################//
@@ -20,7 +20,8 @@
 // Sim includes
 //
 //#include "genMath.h"
-#include "Matrix.hpp"
+#include "Mat.hpp"
+#include "MscEkf.hpp"
 
 //
 // Forward declarations
@@ -51,6 +52,7 @@ public:
   //
   double  initFrameTime; // sec     Time of first FrameUpdate
 
+  int     covFormInt;  // na        Covariance form 1=joseph, 2=ud
   double  datalinkStep;// sec       Uplink interval 
   double  nextUpLinkTime; // sec    Next uplink time
   double  singerTau;   // sec       Kalman process noise tuning parameter
@@ -59,7 +61,7 @@ public:
   //
   // Other public scope variables
   //
-  Matrix  cartRel;     // na        Cartesian state vector
+  MscEkf<double> ekf;  // na        MSC extended Kalman filter
   double  estAccX;     // m/sec^2   Estimated acceleration along LOS
   double  estAccY;     // m/sec^2   Estimated acceleration across LOS 
   double  estLosAng;   // rad       Estimated LOS angle               
@@ -87,7 +89,7 @@ public:
   double  truRng;      // m         True range                   
   double  truRdot;;    // m/sec     True range rate              
 
-  Matrix  truState;    // na        True MSC state
+  Mat<6,1> truState;   // na        True MSC state
 
   double  dlOmega;
   double  dlOmega2;
@@ -170,16 +172,6 @@ public:
 //############################################################################//
   virtual void Finalize();
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-  void Output( bool printHeader,
-               FILE *outfile );
-
 //############################################################################//
 //
 // Function: SetFcTse6()
@@ -274,44 +266,6 @@ private:
 //############################################################################//
   void UpdateStates();
 
-//############################################################################//
-//
-// Function: IntegrateRK2()
-//
-// Purpose:  2nd order Runge Kutta integrator
-//
-//############################################################################//
-  void IntegrateRK2( Matrix &XX, double timeStep );
-
-//############################################################################//
-//
-// Function: StateDeriv()
-//
-// Purpose:  Calculate the state derivative
-//
-//############################################################################//
-  Matrix CalcStateDeriv( Matrix &XX );
-
-//############################################################################//
-//
-// Function: MscToCart()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-  void MscToCart( Matrix &mscState,
-                  Matrix &cartRel );
-
-//############################################################################//
-//
-// Function: CartToMsc()
-//
-// Purpose:  Convert from modified spherical coordinates to cartesian
-//
-//############################################################################//
-  void CartToMsc( Matrix &cartRel,
-                  Matrix &mscState );
-
 //############################################################################//
 //
 // Function: ResetAll()
@@ -334,7 +288,7 @@ private:
   double   dlRng;      // m       Datalink range wrt the projectile
   double   dlRng2;     // m^2     Datalink range squared wrt the projectile
   double   dlRngSig;   // m       Datalink range noise sigma
-  Matrix   dlState;    // na      Datalink intertial cartesian target state
+  Mat<6,1> dlState;    // na      Datalink intertial cartesian target state
   double   dlTgtAxf;   // m/sec^2 Datalink inertial target acceleration
   double   dlTgtAyf;   // m/sec^2 Datalink inertial target acceleration
   double   dlTgtPxf;   // m       Datalink inertial target positon
@@ -342,12 +296,6 @@ private:
   double   dlTgtVxf;   // m/sec   Datalink inertial target velocity
   double   dlTgtVyf;   // m/sec   Datalink inertial target velocity
   double   dlTimeStamp;// sec     Datalink time stamp
-  Matrix   eye;        // na      Identity matrix
-  Matrix   HH;         // na      Measurement matrix
-  Matrix   HT;         // na      Transpose of the measurement matrix
-  bool     initialized;// na      Filter has been initialized.
-  Matrix   innovation; // na      Kalman innovation
-  Matrix   KK;         // na      Kalman gains
   double   measAng;    // rad     Measure LOS angle
   double   measRdot;   // m/sec   Measured range rate
   double   measRelPxf; // m       Datalink target position wrt the projectile
@@ -356,8 +304,6 @@ private:
   double   measRelVyf; // m/sec   Datalink target velocity wrt the projectile
   double   measRng;    // m       Measured (datalink) range
   double   measRng2;   // m^2     measRng squared
-  Matrix   measVec;    // na      Measurement vector
-  Matrix   mscState;   // na      Modified spherical coordates state vector
   double   mslAxf;     // m/sec^2 True projectile inertial acceleraton
   double   mslAyf;     // m/sec^2 True projectile inertial acceleraton
   double   mslPxf;     // m       True projectile inertial position
@@ -365,17 +311,13 @@ private:
   double   mslVxf;     // m/sec   True projectile inertial velocity
   double   mslVyf;     // m/sec   True projectile inertial velocity
   double   omega;      // rad/sec True target weave frequeny
-  Matrix   phi;        // na      State transition matrix
-  Matrix   PP;         // na      Estimation covariance matrix
   double   priorDlTime;// sec     Prior datalink integration time
   double   rDotSig;    // m/sec   Measured range rate standard deviation
   double   rdrPxf;     // m       True radar platform position
   double   rdrPyf;     // m       True radar platform position
   double   rdrVxf;     // m/sec   True radar platform velocity
   double   rdrVyf;     // m/sec   True radar platform velocity
-  Matrix   residual;   // ns      Update residual
   double   rngSig;     // m       Measured range standard deviation
-  Matrix   RR;         // na      Measurement covariance matrix
   double   simTime;    // sec     Simulation time
   double   truRelPxf;  // m       True target position wrt the projectile
   double   truRelPyf;  // m       True target position wrt the projectile
@@ -397,18 +339,8 @@ private:
   FcTse6   *pTse6;     // Fire control TSE
   FcTseO   *pTseO;     // Fire control weave TSE
 
-//############################################################################//
-//
-// Function: inv33()
-//
-// Purpose:  Safely invert a 3x3 matrix using Gaussian elimination.
-//
-//############################################################################//
-bool inv33(Matrix &matIn, Matrix &matOut );
-
 };
 
-
 #endif
 
 //############################################################################//
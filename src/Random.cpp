@@ -0,0 +1,459 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       Random.cpp
+
+    \author     David Bruce
+
+    \brief      Random number generator object.
+
+*/
+//############################################################################//
+
+#include "Random.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <cmath>
+
+//
+// ran1 constants
+//
+const long   IA   = 16807;
+const long   IM   = 2147483647;
+const double AM   = 1.0 / IM;
+const long   IQ   = 127773;
+const long   IR   = 2836;
+const long   NDIV = 1 + (IM - 1) / Random::NTAB;
+const double EPS  = 1.2e-7;
+const double RNMX = 1.0 - EPS;
+
+//
+// Philox4x32 constants
+//
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+const int      PHILOX_ROUNDS = 10;
+
+//
+// 2^-53, spacing of 53 bit uniforms
+//
+const double TWO_M53 = 1.0 / 9007199254740992.0;
+
+const double RNG_TWOPI = 6.28318530717958647692528;
+
+//############################################################################//
+//
+// Function: Random()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+Random::Random()
+{
+  int idx;
+
+  mode = RAN1_RNG;
+  seed = -1;
+  iy   = 0;
+
+  for ( idx = 0; idx < NTAB; ++idx )
+  {
+    iv[idx] = 0;
+  }
+
+  key[0] = 0;
+  key[1] = 0;
+  block  = 0;
+  buf[0] = 0.0;
+  buf[1] = 0.0;
+  bufIdx = 2;
+
+  gaussMode = SUM12_GAUSS;
+  gaussCnt  = 0;
+  gaussIdx  = 0;
+
+}  // end Random()
+
+//############################################################################//
+//
+// Function: ~Random()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+Random::~Random()
+{
+
+}  // end ~Random()
+
+//############################################################################//
+//
+// Function: Seed()
+//
+// Purpose:  Start a new sequence
+//
+//############################################################################//
+void Random::Seed( long seed_ )
+{
+  mode = RAN1_RNG;
+  seed = seed_;
+
+  gaussCnt = 0;
+  gaussIdx = 0;
+
+}  // end Seed()
+
+//############################################################################//
+//
+// Function: SetStream()
+//
+// Purpose:  Key the counter based generator by run and stream
+//
+//############################################################################//
+void Random::SetStream( uint32_t run,
+                        uint32_t stream )
+{
+  mode   = PHILOX_RNG;
+  key[0] = run;
+  key[1] = stream;
+
+  SetPosition( 0 );
+
+  gaussCnt = 0;
+  gaussIdx = 0;
+
+}  // end SetStream()
+
+//############################################################################//
+//
+// Function: SetGaussMode()
+//
+// Purpose:  Select the normal generator
+//
+//############################################################################//
+void Random::SetGaussMode( GaussMode gaussMode_ )
+{
+  gaussMode = gaussMode_;
+
+  gaussCnt = 0;
+  gaussIdx = 0;
+
+}  // end SetGaussMode()
+
+//############################################################################//
+//
+// Function: SetPosition()
+//
+// Purpose:  Skip directly to a draw number.  Each block holds two draws.
+//
+//############################################################################//
+void Random::SetPosition( uint64_t drawNo )
+{
+  block  = drawNo / 2;
+  bufIdx = 2;
+
+  if ( drawNo % 2 )
+  {
+    NextBlock();
+    bufIdx = 1;
+  }
+
+}  // end SetPosition()
+
+//############################################################################//
+//
+// Function: StreamId()
+//
+// Purpose:  32 bit FNV-1a hash of a name
+//
+//############################################################################//
+uint32_t Random::StreamId( const char *name )
+{
+  uint32_t hash = 2166136261u;
+
+  while ( *name != '\0' )
+  {
+    hash ^= static_cast<unsigned char>( *name );
+    hash *= 16777619u;
+    ++name;
+  }
+
+  return hash;
+
+}  // end StreamId()
+
+//############################################################################//
+//
+// Function: Philox()
+//
+// Purpose:  Philox4x32-10 block function.  Salmon et al., "Parallel random
+//           numbers: as easy as 1, 2, 3", SC11.
+//
+//############################################################################//
+void Random::Philox( const uint32_t ctr[4],
+                     const uint32_t key[2],
+                     uint32_t       out[4] )
+{
+  int      idx;
+  uint32_t c0 = ctr[0];
+  uint32_t c1 = ctr[1];
+  uint32_t c2 = ctr[2];
+  uint32_t c3 = ctr[3];
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  uint64_t p0;
+  uint64_t p1;
+
+  for ( idx = 0; idx < PHILOX_ROUNDS; ++idx )
+  {
+    p0 = static_cast<uint64_t>( PHILOX_M0 ) * c0;
+    p1 = static_cast<uint64_t>( PHILOX_M1 ) * c2;
+
+    c0 = static_cast<uint32_t>( p1 >> 32 ) ^ c1 ^ k0;
+    c2 = static_cast<uint32_t>( p0 >> 32 ) ^ c3 ^ k1;
+    c1 = static_cast<uint32_t>( p1 );
+    c3 = static_cast<uint32_t>( p0 );
+
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+
+}  // end Philox()
+
+//############################################################################//
+//
+// Function: NextBlock()
+//
+// Purpose:  Generate two 53 bit uniforms on (0, 1) from the next block
+//
+//############################################################################//
+void Random::NextBlock()
+{
+  uint32_t ctr[4];
+  uint32_t out[4];
+  uint64_t bits;
+
+  ctr[0] = static_cast<uint32_t>( block );
+  ctr[1] = static_cast<uint32_t>( block >> 32 );
+  ctr[2] = 0;
+  ctr[3] = 0;
+
+  Philox( ctr, key, out );
+
+  ++block;
+
+  bits = ( (static_cast<uint64_t>( out[0] ) << 32) | out[1] ) >> 11;
+  buf[0] = ( static_cast<double>( bits ) + 0.5 ) * TWO_M53;
+
+  bits = ( (static_cast<uint64_t>( out[2] ) << 32) | out[3] ) >> 11;
+  buf[1] = ( static_cast<double>( bits ) + 0.5 ) * TWO_M53;
+
+  bufIdx = 0;
+
+}  // end NextBlock()
+
+//############################################################################//
+//
+// Function: Ran1()
+//
+// Purpose:  Uniform random number generator.  Numerical Recipes ran1 or
+//           the counter based generator, depending on the mode.
+//
+//############################################################################//
+double Random::Ran1()
+{
+  int    j;
+  long   k;
+  double temp;
+
+  if ( mode == PHILOX_RNG )
+  {
+    if ( bufIdx > 1 )
+    {
+      NextBlock();
+    }
+
+    return buf[bufIdx++];
+  }
+
+  if ( seed <= 0 || !iy )
+  {
+    if ( -seed < 1 )
+    {
+      seed = 1;
+    }
+    else
+    {
+      seed = -seed;
+    }
+
+    for ( j = NTAB + 7; j >= 0; j-- )
+    {
+      k = seed / IQ;
+      seed = IA * (seed - k * IQ) - IR * k;
+      if ( seed < 0 )
+      {
+        seed += IM;
+      }
+      if ( j < NTAB )
+      {
+        iv[j] = seed;
+      }
+    }
+    iy = iv[0];
+  }
+
+  k = seed / IQ;
+  seed = IA * (seed - k * IQ) - IR * k;
+  if ( seed <= 0 )
+  {
+    seed += IM;
+  }
+  j = iy / NDIV;
+  iy = iv[j];
+  iv[j] = seed;
+
+  if ( (temp = AM * iy) > RNMX )
+  {
+    return RNMX;
+  }
+  else
+  {
+    return temp;
+  }
+
+}  // end Ran1()
+
+//############################################################################//
+//
+// Function: Gasdev()
+//
+// Purpose:  Gaussian random number generator.  Sum of 12 uniforms.
+//
+//############################################################################//
+double Random::Gasdev()
+{
+  int    idx;
+  double sum;
+
+  sum = 0.0;
+  for ( idx = 0; idx < 12; ++idx )
+  {
+    sum += Ran1() - 0.5;
+  }
+
+  return sum;
+
+}  // end Gasdev()
+
+//############################################################################//
+//
+// Function: Uniform()
+//
+// Purpose:  Uniform random number generator
+//
+//############################################################################//
+double Random::Uniform( double min,
+                        double max )
+{
+  double ran = Ran1();
+
+  return ( min + ran * (max - min) );
+
+}  // end Uniform()
+
+//############################################################################//
+//
+// Function: Gaussian()
+//
+// Purpose:  Gaussian random number generator truncated at three sigma
+//
+//############################################################################//
+double Random::Gaussian( double mean,
+                         double sigma )
+{
+  double rannum;
+
+  if ( gaussMode == BOX_MULLER_GAUSS )
+  {
+    if ( gaussIdx >= gaussCnt )
+    {
+      FillGaussBatch();
+    }
+
+    rannum = gaussBuf[gaussIdx++];
+  }
+  else
+  {
+    while ( fabs(rannum = Gasdev()) > 3.0 ) {}
+  }
+
+  return ( mean + sigma * rannum );
+
+}  // end Gaussian()
+
+//############################################################################//
+//
+// Function: FillGaussBatch()
+//
+// Purpose:  Box-Muller transform of a batch of uniform pairs.  The uniforms
+//           come from the sequential generator, the transform loops are
+//           independent per element.
+//
+//############################################################################//
+void Random::FillGaussBatch()
+{
+  int    idx;
+  double draw;
+
+  do
+  {
+    for ( idx = 0; idx < GAUSS_PAIRS; ++idx )
+    {
+      uni1[idx] = Ran1();
+      uni2[idx] = Ran1();
+    }
+
+    for ( idx = 0; idx < GAUSS_PAIRS; ++idx )
+    {
+      radius[idx] = sqrt( -2.0 * log(uni1[idx]) );
+      angle[idx]  = RNG_TWOPI * uni2[idx];
+    }
+
+    for ( idx = 0; idx < GAUSS_PAIRS; ++idx )
+    {
+      gaussBuf[2*idx]   = radius[idx] * cos( angle[idx] );
+      gaussBuf[2*idx+1] = radius[idx] * sin( angle[idx] );
+    }
+
+    //
+    // Drop draws beyond three sigma, keeping the order of the rest
+    //
+    gaussCnt = 0;
+    for ( idx = 0; idx < 2 * GAUSS_PAIRS; ++idx )
+    {
+      draw = gaussBuf[idx];
+      if ( fabs(draw) <= 3.0 )
+      {
+        gaussBuf[gaussCnt++] = draw;
+      }
+    }
+  } while ( gaussCnt == 0 );
+
+  gaussIdx = 0;
+
+}  // end FillGaussBatch()
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,254 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       Random.hpp
+
+    \author     David Bruce
+
+    \brief      Random number generator object.
+
+    Holds all generator state for one run, so runs made concurrently on
+    separate executives do not share anything.  Two uniform generators are
+    available:
+
+    RAN1_RNG   - Numerical Recipes ran1().  A given seed reproduces the
+                 ran1() sequence bit for bit.  Sequential, needs a warm up.
+
+    PHILOX_RNG - Philox4x32-10 counter based generator.  Draw n of the
+                 stream keyed by (run, stream) is a pure function of those
+                 three numbers, so any draw of any run can be regenerated
+                 directly, on any thread, with no warm up.
+
+    Two normal generators are available:
+
+    SUM12_GAUSS       - 12 uniform sum used by gasdev().  One draw at a time.
+
+    BOX_MULLER_GAUSS  - Box-Muller transform applied to a batch of uniform
+                        pairs.  The transform loops have no dependencies
+                        between iterations so the compiler can vectorize
+                        them.  Draws beyond three sigma are dropped from the
+                        batch, which gives the same truncation as the
+                        rejection loop in Gaussian().
+
+*/
+//############################################################################//
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <cstdint>
+
+class Random
+{
+public:
+
+  typedef enum _rng_mode_
+  {
+    RAN1_RNG,       // 0 = Numerical Recipes ran1
+    PHILOX_RNG      // 1 = Philox4x32-10 counter based
+  } RngMode;
+
+  typedef enum _gauss_mode_
+  {
+    SUM12_GAUSS,      // 0 = Sum of 12 uniforms, legacy gasdev
+    BOX_MULLER_GAUSS  // 1 = Batched Box-Muller
+  } GaussMode;
+
+  //
+  // Size of the ran1 shuffle table
+  //
+  static const int NTAB = 32;
+
+  //
+  // Uniform pairs transformed per Box-Muller batch
+  //
+  static const int GAUSS_PAIRS = 64;
+
+//############################################################################//
+//
+// Function: Random()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+  Random();
+
+//############################################################################//
+//
+// Function: ~Random()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+  ~Random();
+
+//############################################################################//
+//
+// Function: Seed()
+//
+// Purpose:  Start a new sequence.  A negative seed reinitializes the shuffle
+//           table on the next draw, the same as ran1().
+//
+//############################################################################//
+  void Seed( long seed_ );
+
+//############################################################################//
+//
+// Function: SetStream()
+//
+// Purpose:  Select the counter based generator and key it by run and stream.
+//           The draw counter is reset to zero.
+//
+//############################################################################//
+  void SetStream( uint32_t run, uint32_t stream );
+
+//############################################################################//
+//
+// Function: SetPosition()
+//
+// Purpose:  Move a counter based stream directly to draw number drawNo
+//
+//############################################################################//
+  void SetPosition( uint64_t drawNo );
+
+//############################################################################//
+//
+// Function: SetGaussMode()
+//
+// Purpose:  Select the normal generator.  Any buffered draws are discarded.
+//
+//############################################################################//
+  void SetGaussMode( GaussMode gaussMode_ );
+
+//############################################################################//
+//
+// Function: StreamId()
+//
+// Purpose:  Stable stream number for a name, FNV-1a hash
+//
+//############################################################################//
+  static uint32_t StreamId( const char *name );
+
+//############################################################################//
+//
+// Function: Ran1()
+//
+// Purpose:  Uniform deviate on (0, 1) from the generator in use
+//
+//############################################################################//
+  double Ran1();
+
+//############################################################################//
+//
+// Function: Gasdev()
+//
+// Purpose:  Zero mean, unit variance normal deviate.  Sum of 12 uniforms.
+//           Used by the SUM12_GAUSS mode.
+//
+//############################################################################//
+  double Gasdev();
+
+//############################################################################//
+//
+// Function: Uniform()
+//
+// Purpose:  Uniform deviate on (min, max)
+//
+//############################################################################//
+  double Uniform( double min, double max );
+
+//############################################################################//
+//
+// Function: Gaussian()
+//
+// Purpose:  Normal deviate truncated at three sigma from the normal
+//           generator in use
+//
+//############################################################################//
+  double Gaussian( double mean, double sigma );
+
+//############################################################################//
+//
+// Function: GetSeed()
+//
+// Purpose:  Current generator seed
+//
+//############################################################################//
+  long GetSeed()
+  {
+    return seed;
+  }
+
+//############################################################################//
+//
+// Function: GetMode()
+//
+// Purpose:  Current uniform generator
+//
+//############################################################################//
+  RngMode GetMode()
+  {
+    return mode;
+  }
+
+private:
+
+//############################################################################//
+//
+// Function: Philox()
+//
+// Purpose:  Ten round Philox4x32 block function
+//
+//############################################################################//
+  static void Philox( const uint32_t ctr[4],
+                      const uint32_t key[2],
+                      uint32_t       out[4] );
+
+//############################################################################//
+//
+// Function: NextBlock()
+//
+// Purpose:  Fill the uniform buffer from the next counter block
+//
+//############################################################################//
+  void NextBlock();
+
+//############################################################################//
+//
+// Function: FillGaussBatch()
+//
+// Purpose:  Refill the normal buffer with truncated Box-Muller draws
+//
+//############################################################################//
+  void FillGaussBatch();
+
+  RngMode  mode;      // na      Uniform generator in use
+  GaussMode gaussMode;// na      Normal generator in use
+
+  long     seed;      // na      ran1 current generator seed
+  long     iy;        // na      ran1 last shuffle table output
+  long     iv[NTAB];  // na      ran1 shuffle table
+
+  uint32_t key[2];    // na      Philox key, run and stream
+  uint64_t block;     // na      Philox block counter for the next block
+  double   buf[2];    // na      Uniforms from the current block
+  int      bufIdx;    // na      Next unused entry of buf
+
+  double   uni1[GAUSS_PAIRS];     // na  Box-Muller radius uniforms
+  double   uni2[GAUSS_PAIRS];     // na  Box-Muller angle uniforms
+  double   radius[GAUSS_PAIRS];   // na  Box-Muller radii
+  double   angle[GAUSS_PAIRS];    // rad Box-Muller angles
+  double   gaussBuf[2*GAUSS_PAIRS];// na Truncated normal draws
+  int      gaussCnt;  // na      Valid entries of gaussBuf
+  int      gaussIdx;  // na      Next unused entry of gaussBuf
+};
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,380 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       RunStats.cpp
+
+    \author     David Bruce
+
+    \brief      Streaming run set statistics
+
+*/
+//############################################################################//
+
+#include "RunStats.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+//############################################################################//
+//
+// Function: Welford()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+Welford::Welford()
+{
+  count = 0;
+  mean  = 0.0;
+  m2    = 0.0;
+
+}  // end Welford()
+
+//############################################################################//
+//
+// Function: Add()
+//
+// Purpose:  Welford's update of the mean and the sum of squared deviations
+//
+//############################################################################//
+void Welford::Add( double xx )
+{
+  double delta;
+
+  ++count;
+
+  delta = xx - mean;
+  mean += delta / static_cast<double>( count );
+  m2   += delta * ( xx - mean );
+
+}  // end Add()
+
+//############################################################################//
+//
+// Function: Merge()
+//
+// Purpose:  Chan's pairwise combination of two accumulators
+//
+//############################################################################//
+void Welford::Merge( const Welford &other )
+{
+  double    delta;
+  long long total;
+
+  if ( other.count == 0 )
+  {
+    return;
+  }
+
+  total = count + other.count;
+  delta = other.mean - mean;
+
+  mean += delta * static_cast<double>( other.count ) /
+                  static_cast<double>( total );
+  m2   += other.m2 + delta * delta * static_cast<double>( count ) *
+                     static_cast<double>( other.count ) /
+                     static_cast<double>( total );
+
+  count = total;
+
+}  // end Merge()
+
+//############################################################################//
+//
+// Function: StdDev()
+//
+// Purpose:  Sample standard deviation
+//
+//############################################################################//
+double Welford::StdDev() const
+{
+  if ( count < 2 )
+  {
+    return 0.0;
+  }
+
+  return sqrt( m2 / static_cast<double>( count - 1 ) );
+
+}  // end StdDev()
+
+//############################################################################//
+//
+// Function: QuantileSketch()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+QuantileSketch::QuantileSketch( int kk )
+{
+  capacity = ( kk < 2 ) ? 2 : kk + ( kk & 1 );
+  count    = 0;
+  maxVal   = 0.0;
+  minVal   = 0.0;
+  rankErr  = 0;
+
+  levels.assign( 1, vector<double>() );
+  parity.assign( 1, 0 );
+
+  levels[0].reserve( capacity );
+
+}  // end QuantileSketch()
+
+//############################################################################//
+//
+// Function: Add()
+//
+// Purpose:  Add a value to the stream
+//
+//############################################################################//
+void QuantileSketch::Add( double xx )
+{
+  if ( count == 0 )
+  {
+    minVal = xx;
+    maxVal = xx;
+  }
+  else
+  {
+    minVal = std::min( minVal, xx );
+    maxVal = std::max( maxVal, xx );
+  }
+
+  ++count;
+
+  levels[0].push_back( xx );
+
+  if ( levels[0].size() >= capacity )
+  {
+    Compact();
+  }
+
+}  // end Add()
+
+//############################################################################//
+//
+// Function: Merge()
+//
+// Purpose:  Combine another sketch into this one
+//
+//############################################################################//
+void QuantileSketch::Merge( const QuantileSketch &other )
+{
+  int level;
+
+  assert( other.capacity == capacity );
+
+  if ( other.count == 0 )
+  {
+    return;
+  }
+
+  if ( count == 0 )
+  {
+    minVal = other.minVal;
+    maxVal = other.maxVal;
+  }
+  else
+  {
+    minVal = std::min( minVal, other.minVal );
+    maxVal = std::max( maxVal, other.maxVal );
+  }
+
+  count   += other.count;
+  rankErr += other.rankErr;
+
+  if ( levels.size() < other.levels.size() )
+  {
+    levels.resize( other.levels.size() );
+    parity.resize( other.levels.size(), 0 );
+  }
+
+  for ( level = 0; level < other.levels.size(); ++level )
+  {
+    levels[level].insert( levels[level].end(),
+                          other.levels[level].begin(),
+                          other.levels[level].end() );
+  }
+
+  Compact();
+
+}  // end Merge()
+
+//############################################################################//
+//
+// Function: Compact()
+//
+// Purpose:  Halve every full compactor into the level above it.  An odd
+//           value out stays behind, so only pairs are compacted.
+//
+//############################################################################//
+void QuantileSketch::Compact()
+{
+  int    idx;
+  int    level;
+  int    qtyPairs;
+
+  for ( level = 0; level < levels.size(); ++level )
+  {
+    if ( levels[level].size() < capacity )
+    {
+      continue;
+    }
+
+    if ( level + 1 == levels.size() )
+    {
+      levels.push_back( vector<double>() );
+      parity.push_back( 0 );
+    }
+
+    vector<double> &buf   = levels[level];
+    vector<double> &above = levels[level + 1];
+
+    std::sort( buf.begin(), buf.end() );
+
+    qtyPairs = buf.size() / 2;
+
+    for ( idx = parity[level]; idx < 2 * qtyPairs; idx += 2 )
+    {
+      above.push_back( buf[idx] );
+    }
+
+    buf.erase( buf.begin(), buf.begin() + 2 * qtyPairs );
+
+    parity[level] ^= 1;
+
+    rankErr += 1LL << level;
+  }
+
+}  // end Compact()
+
+//############################################################################//
+//
+// Function: Quantile()
+//
+// Purpose:  Walk the weighted values in order to rank ceil( qq * n )
+//
+//############################################################################//
+double QuantileSketch::Quantile( double qq ) const
+{
+  int                                 idx;
+  int                                 level;
+  double                              target;
+  long long                           cum;
+  vector< std::pair<double, long long> > items;
+
+  if ( count == 0 )
+  {
+    return 0.0;
+  }
+
+  if ( qq <= 0.0 )
+  {
+    return minVal;
+  }
+
+  if ( qq >= 1.0 )
+  {
+    return maxVal;
+  }
+
+  items.reserve( Retained() );
+
+  for ( level = 0; level < levels.size(); ++level )
+  {
+    for ( idx = 0; idx < levels[level].size(); ++idx )
+    {
+      items.push_back( std::make_pair( levels[level][idx], 1LL << level ) );
+    }
+  }
+
+  std::sort( items.begin(), items.end() );
+
+  target = ceil( qq * static_cast<double>( count ) );
+  cum    = 0;
+
+  for ( idx = 0; idx < items.size(); ++idx )
+  {
+    cum += items[idx].second;
+
+    if ( static_cast<double>( cum ) >= target )
+    {
+      return items[idx].first;
+    }
+  }
+
+  return maxVal;
+
+}  // end Quantile()
+
+//############################################################################//
+//
+// Function: RankError()
+//
+// Purpose:  Rank error bound as a fraction of the stream length
+//
+//############################################################################//
+double QuantileSketch::RankError() const
+{
+  if ( count == 0 )
+  {
+    return 0.0;
+  }
+
+  return static_cast<double>( rankErr ) / static_cast<double>( count );
+
+}  // end RankError()
+
+//############################################################################//
+//
+// Function: Retained()
+//
+// Purpose:  Quantity of values held by the sketch
+//
+//############################################################################//
+int QuantileSketch::Retained() const
+{
+  int level;
+  int qty(0);
+
+  for ( level = 0; level < levels.size(); ++level )
+  {
+    qty += levels[level].size();
+  }
+
+  return qty;
+
+}  // end Retained()
+
+//############################################################################//
+//
+// Function: SortedQuantile()
+//
+// Purpose:  Exact quantile of sorted values
+//
+//############################################################################//
+double SortedQuantile( const vector<double> &sorted,
+                       double                qq )
+{
+  long long rank;
+
+  if ( sorted.empty() )
+  {
+    return 0.0;
+  }
+
+  rank = static_cast<long long>( ceil( qq * static_cast<double>( sorted.size() ) ) );
+  rank = std::max( 1LL, std::min( rank, static_cast<long long>( sorted.size() ) ) );
+
+  return sorted[rank - 1];
+
+}  // end SortedQuantile()
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
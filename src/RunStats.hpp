@@ -0,0 +1,189 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       RunStats.hpp
+
+    \author     David Bruce
+
+    \brief      Streaming run set statistics
+
+    Welford accumulates the mean and standard deviation of a stream in one
+    pass.  QuantileSketch estimates quantiles of a stream in bounded memory.
+    Both merge, so partial statistics gathered separately, by worker
+    threads or by separate run sets, combine into the statistics of the
+    whole.
+
+    The sketch is a stack of compactors, each holding up to k values.  The
+    values at level h each stand for 2^h values of the stream.  A full
+    compactor is sorted and every other value is promoted to the next level,
+    alternating between the odd and even values on successive compactions.
+    A compaction at level h moves the rank of any value by at most 2^h, so
+    the sum of 2^h over all compactions made is a hard bound on the rank
+    error of every quantile.  The sketch keeps that sum.  Until the first
+    compaction the sketch holds every value and is exact.
+
+    Memory is k values per level, about k * log2( n / k ) values for n
+    values in the stream, and the rank error bound is about
+    log2( n / k ) / k of n.
+
+*/
+//############################################################################//
+
+#ifndef RUNSTATS_HPP
+#define RUNSTATS_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <vector>
+using std::vector;
+
+class Welford
+{
+public:
+
+  Welford();
+
+//############################################################################//
+//
+// Function: Add()
+//
+// Purpose:  Add a value to the stream
+//
+//############################################################################//
+  void Add( double xx );
+
+//############################################################################//
+//
+// Function: Merge()
+//
+// Purpose:  Combine another accumulator into this one
+//
+//############################################################################//
+  void Merge( const Welford &other );
+
+  long long Count() const { return count; }
+
+  double Mean() const { return mean; }
+
+//############################################################################//
+//
+// Function: StdDev()
+//
+// Purpose:  Sample standard deviation, zero for fewer than two values
+//
+//############################################################################//
+  double StdDev() const;
+
+private:
+
+  long long count;          // na  Quantity of values
+  double    mean;           // na  Mean of the values
+  double    m2;             // na  Sum of squared deviations from the mean
+};
+
+class QuantileSketch
+{
+public:
+
+//############################################################################//
+//
+// Function: QuantileSketch()
+//
+// Purpose:  Constructor.  kk is the capacity of each compactor, rounded up
+//           to an even number.
+//
+//############################################################################//
+  QuantileSketch( int kk = 4096 );
+
+//############################################################################//
+//
+// Function: Add()
+//
+// Purpose:  Add a value to the stream
+//
+//############################################################################//
+  void Add( double xx );
+
+//############################################################################//
+//
+// Function: Merge()
+//
+// Purpose:  Combine another sketch into this one.  The sketches must have
+//           the same capacity.
+//
+//############################################################################//
+  void Merge( const QuantileSketch &other );
+
+//############################################################################//
+//
+// Function: Quantile()
+//
+// Purpose:  Estimate of the value of rank ceil( qq * n ), qq in [0,1]
+//
+//############################################################################//
+  double Quantile( double qq ) const;
+
+//############################################################################//
+//
+// Function: RankError()
+//
+// Purpose:  Bound on the rank error of any quantile as a fraction of n.
+//           The true rank of Quantile( qq ) is within RankError() * n of
+//           qq * n.
+//
+//############################################################################//
+  double RankError() const;
+
+//############################################################################//
+//
+// Function: Retained()
+//
+// Purpose:  Quantity of values held by the sketch
+//
+//############################################################################//
+  int Retained() const;
+
+  long long Count() const { return count; }
+
+  double Min() const { return minVal; }
+
+  double Max() const { return maxVal; }
+
+private:
+
+//############################################################################//
+//
+// Function: Compact()
+//
+// Purpose:  Compact every full compactor, lowest level first
+//
+//############################################################################//
+  void Compact();
+
+  int       capacity;       // na  Capacity of each compactor
+  long long count;          // na  Quantity of values in the stream
+  double    maxVal;         // na  Largest value in the stream
+  double    minVal;         // na  Smallest value in the stream
+  long long rankErr;        // na  Sum of the weights of all compactions
+
+  vector< vector<double> > levels; // na  Compactors, level h of weight 2^h
+  vector<char>             parity; // na  Next compaction offset by level
+};
+
+//############################################################################//
+//
+// Function: SortedQuantile()
+//
+// Purpose:  Value of rank ceil( qq * n ) of n sorted values, the rank that
+//           QuantileSketch::Quantile() estimates, qq in [0,1]
+//
+//############################################################################//
+double SortedQuantile( const vector<double> &sorted, double qq );
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -25,6 +25,7 @@
 // Reference includes
 //
 #include "Missile.hpp"
+#include "Random.hpp"
 #include "SimExec.hpp"
 #include "Target.hpp"
 
@@ -65,6 +66,19 @@ MdlBase()
   // Other variable initialization
   //
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "skr.measAng", "rad", measAng );
+  RegisterChannel( "skr.measValid", "na", measValid );
+  RegisterChannel( "skr.rinAng", "rad", rinAng );
+  RegisterChannel( "skr.timeStamp", "sec", timeStamp );
+  RegisterChannel( "skr.truAng", "rad", truAng );
+  RegisterChannel( "skr.truRdot", "m/sec", truRdot );
+  RegisterChannel( "skr.truRng", "m", truRng );
+  RegisterChannel( "skr.vxf", "m/sec", vxf );
+  RegisterChannel( "skr.vyf", "m/sec", vyf );
+
 }
 
 //############################################################################//
@@ -138,7 +152,7 @@ void Seeker::FrameUpdate()
 
   if ( truRng < detRng )
   {
-    measAng = gaussian( truAng, rinAng, &pExec->seed );
+    measAng = pRng->Gaussian( truAng, rinAng );
     measValid = true;      
   }
   else
@@ -186,50 +200,6 @@ void Seeker::Finalize()
 
 }
  
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void Seeker::Output( bool printHeader,
-                      FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "skr.measAng");
-    fprintf( pOutFile, "%20s", "skr.measValid");
-    fprintf( pOutFile, "%20s", "skr.rinAng");
-    fprintf( pOutFile, "%20s", "skr.timeStamp");
-
-
-    fprintf( pOutFile, "%20s", "skr.truAng");
-    fprintf( pOutFile, "%20s", "skr.truRdot");
-    fprintf( pOutFile, "%20s", "skr.truRng");
-
-    fprintf( pOutFile, "%20s", "skr.vxf");
-    fprintf( pOutFile, "%20s", "skr.vyf");
-  }
-  else
-  {
-    fprintf( pOutFile, "%20.6e", measAng );
-    fprintf( pOutFile, "%20.6d", measValid );
-    fprintf( pOutFile, "%20.6e", rinAng );
-    fprintf( pOutFile, "%20.6e", timeStamp );
-
-    fprintf( pOutFile, "%20.6e", truAng );
-    fprintf( pOutFile, "%20.6e", truRdot );
-    fprintf( pOutFile, "%20.6e", truRng );
-
-    fprintf( pOutFile, "%20.6e", vxf );
-    fprintf( pOutFile, "%20.6e", vyf );
-  }
-}  // end Output()
-
-
 //
 // Class scope functions
 //
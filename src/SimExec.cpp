@@ -37,6 +37,8 @@ using std::endl;
 #include <algorithm>
 using std::sort;
 
+#include <thread>
+
 //
 // Sim includes
 //
@@ -50,6 +52,35 @@ using std::sort;
 const double LARGE = 999.0e9;
 const double SMALL = 1.0e-6;
 
+//
+// Executive clock limits.  Times that never occur in the run are scheduled
+// at NEVER_TICK.
+//
+const int64_t MAX_TICKS_PER_SEC = 1000000000;
+const int64_t NEVER_TICK        = INT64_MAX;
+
+//
+// Input strings for Random::RngMode
+//
+static char *RNG_MODE_STR[] = { (char *)"ran1", (char *)"philox" };
+
+//
+// Input strings for Random::GaussMode
+//
+static char *GAUSS_MODE_STR[] = { (char *)"sum12", (char *)"boxMuller" };
+
+//
+// Input strings for StateArena::IntegMode
+//
+static char *INTEG_MODE_STR[] = { (char *)"rk4", (char *)"rk4Fused",
+                                  (char *)"dp5" };
+
+//
+// Input strings for TrajFile::OutFormat
+//
+static char *OUT_FORMAT_STR[] = { (char *)"text", (char *)"bin",
+                                  (char *)"bin32" };
+
 //############################################################################//
 //
 // Function:  SimExec()
@@ -73,21 +104,51 @@ tgt()
   //
   // Default initialization of input variables
   //
+  channelSel     = "*";   // na      Output channel glob patterns
+  cpaEn          = false; // na      Flag to solve for the closest point
+                          //         of approach between steps
   fileStub[0]    = '\0';  // na      Output file name stub
   flyerThld      = 10.0;  // m       Threshold for flyer miss distance
   maxTime        = 100.0; // sec     Maximum amount of simulation time
   outputRate     = -1.0;  // Hz      Trajectory data output rate
+  outFormat      = TrajFile::TEXT_FMT;
+                          // na      Trajectory data file format
+  outputDrop     = false; // na      Flag to drop trajectory blocks when
+                          //         the writer queue is full
+  outputQueue    = 4;     // na      Trajectory blocks queued to the writer
+                          //         thread, 0 = write on the sim thread
+  outputSet      = false; // na      Flag to write the run set to one
+                          //         indexed container file
   pHitThld       = 1.0;   // m       Miss threshold for pHit calculation
   printAll       = false; // na      Flag directing to print all Monte
                           //         Carlo run miss data
   runs           = 1;     // na      Number of runs in the Monte Carlo set
   runStart       = 1;     // na      First run to be made resolved
+  threads        = 1;     // na      Quantity of Monte Carlo worker threads
+  statsExactRuns = 100000;// na      Largest run set with exact miss
+                          //         percentiles
+  rngMode        = Random::RAN1_RNG;
+                          // na      Random number generator selection
+  gaussMode      = Random::SUM12_GAUSS;
+                          // na      Normal random number generator selection
+  integMode      = StateArena::RK4_MODEL;
+                          // na      Integrator selection
+  intAtol        = 1.0e-6;// na      Adaptive integrator absolute tolerance
+  intRtol        = 1.0e-6;// na      Adaptive integrator relative tolerance
   timeStep       = 1.0e-3;// sec     Simulation time step  
   xa             = 0.0;   // rad     Crossing angle.  Suplement of angle between
                           //         velocity vectors.
 
   tFinal         = 50.0;  // sec     Sim duration
 
+  pTrajSet       = NULL;
+
+  //
+  // Register output channels
+  //
+  RegisterChannel( "simTime", "sec", simTime );
+  RegisterChannel( "seed", "na", runSeed );
+
 }  // end SimExec()
 
 //############################################################################//
@@ -143,7 +204,7 @@ void  SimExec::Initialize()
     mdlVec[idx]->Initialize();
   }
 
-  outputTimeStep = 1.0 / outputRate;
+  ScheduleFrames();
 }
 
 //############################################################################//
@@ -158,6 +219,18 @@ void SimExec::Integrate()
   int idx;
   MdlBase *pMdl;
   
+  if ( integMode == StateArena::RK4_FUSED )
+  {
+    arena.StepRK4( deltaTime );
+
+    return;
+  }
+  else if ( integMode == StateArena::DP5_ADAPTIVE )
+  {
+    arena.Advance( deltaTime );
+
+    return;
+  }
 
   for ( idx = 0; idx < mdlVec.size(); ++idx )
   {
@@ -196,73 +269,333 @@ void SimExec::Update()
 //############################################################################//
 void SimExec::FrameUpdate()
 {
-  int    idx;
-  double temp;
+  FrameEvent event;
+  int     idx;
+  int64_t temp;
 
   //
   // Write selected variables to output file
   //
-  if ( (simTime >= outputTime) && (pOutFile != NULL) )
+  if ( (simTick >= outputTick) && traj.IsOpen() )
+  {
+    Output( false, traj );
+
+    outputTick += outputTickStep;
+  }
+
+  if ( integMode == StateArena::DP5_ADAPTIVE )
   {
-    Output( false, pOutFile );
+    //
+    // The adaptive integrator picks its own sub steps, so the executive
+    // only steps to the next frame or output event.
+    //
+    deltaTick = maxTick - simTick;
+  }
+  else
+  {
+    //
+    // Start next time step calculation with the sim time step.
+    //
+    deltaTick = timeStepTick;
+
+    if ( simTick >= nextFrameTick )
+    {
+      nextFrameTick += timeStepTick;
+    }
 
-    outputTime += outputTimeStep;
+    temp = nextFrameTick - simTick;
+    if ( temp < deltaTick )
+    {
+      deltaTick = temp;
+    }
   }
 
   //
-  // Start next time step calculation with the sim time step.
+  // Check output time step
   //
-  deltaTime = timeStep;
-
-  if ( simTime >= nextFrameTime - SMALL )
+  if ( traj.IsOpen() )
   {
-    nextFrameTime += timeStep;
+    temp = outputTick - simTick;
+    if ( temp < deltaTick )
+    {
+      deltaTick = temp;
+    }
   }
 
-  temp = nextFrameTime - simTime;
-  if ( deltaTime - temp > SMALL )
+  //
+  // Pull every model that is due off the frame queue.
+  //
+  frameDue.clear();
+  while ( !frameQueue.empty() && (simTick >= frameQueue.front().tick) )
   {
-    deltaTime = temp;
+    frameDue.push_back( frameQueue.front().idx );
+
+    std::pop_heap( frameQueue.begin(), frameQueue.end(), FrameLater() );
+    frameQueue.pop_back();
   }
 
   //
-  // Check output time step
+  // Perform model frame updates in model order, then requeue each model at
+  // its next frame time.
   //
-  if (pOutFile != NULL )    
+  sort( frameDue.begin(), frameDue.end() );
+
+  for ( idx = 0; idx < frameDue.size(); ++idx )
   {
-    temp = outputTime - simTime;
-    if ( deltaTime - temp > SMALL )
+    pMdl = mdlVec[frameDue[idx]];
+
+    pMdl->FrameUpdate();
+
+    event.idx  = frameDue[idx];
+    event.tick = NEVER_TICK;
+
+    if ( frameTickStep[event.idx] != NEVER_TICK )
     {
-      deltaTime = temp;
+      event.tick = frameTick[event.idx] + frameTickStep[event.idx];
     }
+
+    frameTick[event.idx] = event.tick;
+    pMdl->nextFrameTime  = TickTime( event.tick );
+
+    frameQueue.push_back( event );
+    std::push_heap( frameQueue.begin(), frameQueue.end(), FrameLater() );
   }
 
   //
-  // Perform model frame updates.
+  //  The earliest queued frame bounds the next time step.
   //
+  if ( !frameQueue.empty() )
+  {
+    temp = frameQueue.front().tick - simTick;
+    if ( temp < deltaTick )
+    {
+      deltaTick = temp;
+    }
+  }
+
+  deltaTime = TickTime( deltaTick );
+
+} // end FrameUpdate()
+
+//############################################################################//
+//
+// Function: ScheduleFrames()
+//
+// Purpose:  Load the frame queue from the model frame times
+//
+//############################################################################//
+void SimExec::ScheduleFrames()
+{
+  FrameEvent event;
+  int idx;
+
+  SetTickRate();
+
+  timeStepTick   = ToTick( timeStep );
+  maxTick        = ToTick( maxTime );
+  nextFrameTick  = 0;
+  outputTick     = 0;
+  outputTickStep = NEVER_TICK;
+
+  if ( outputRate > 0.0 )
+  {
+    outputTickStep = ToTick( 1.0 / outputRate );
+  }
+
+  frameQueue.clear();
+  frameTick.assign( mdlVec.size(), NEVER_TICK );
+  frameTickStep.assign( mdlVec.size(), NEVER_TICK );
+
   for ( idx = 0; idx < mdlVec.size(); ++idx )
   {
-    pMdl = mdlVec[idx];
+    frameTick[idx]     = ToTick( mdlVec[idx]->nextFrameTime );
+    frameTickStep[idx] = ToTick( mdlVec[idx]->frameTimeStep );
+
+    event.tick = frameTick[idx];
+    event.idx  = idx;
+
+    frameQueue.push_back( event );
+  }
+
+  std::make_heap( frameQueue.begin(), frameQueue.end(), FrameLater() );
+
+}  // end ScheduleFrames()
+
+//############################################################################//
+//
+// Function: SetTickRate()
+//
+// Purpose:  Pick the tick rate that makes every schedule time a whole
+//           number of ticks
+//
+//############################################################################//
+void SimExec::SetTickRate()
+{
+  int idx;
 
-    if ( simTime >= pMdl->nextFrameTime - SMALL )
+  ticksPerSec = 1;
+
+  AddTickRate( timeStep );
+  AddTickRate( maxTime );
+
+  if ( outputRate > 0.0 )
+  {
+    AddTickRate( 1.0 / outputRate );
+  }
+
+  for ( idx = 0; idx < mdlVec.size(); ++idx )
+  {
+    AddTickRate( mdlVec[idx]->nextFrameTime );
+    AddTickRate( mdlVec[idx]->frameTimeStep );
+  }
+
+}  // end SetTickRate()
+
+//############################################################################//
+//
+// Function: AddTickRate()
+//
+// Purpose:  Raise the tick rate to the least common multiple of the current
+//           rate and the denominator of a schedule time.  Times with no
+//           small denominator, or a rate beyond MAX_TICKS_PER_SEC, fall
+//           back to MAX_TICKS_PER_SEC with times rounded to the nearest tick.
+//
+//############################################################################//
+void SimExec::AddTickRate( double time )
+{
+  int64_t aa;
+  int64_t bb;
+  int64_t den;
+  int64_t tmp;
+
+  //
+  // Times past the end of the run never happen
+  //
+  if ( (time > maxTime) || (ticksPerSec == MAX_TICKS_PER_SEC) )
+  {
+    return;
+  }
+
+  den = TickDenominator( time );
+
+  //
+  // Greatest common divisor
+  //
+  aa = ticksPerSec;
+  bb = den;
+  while ( bb != 0 )
+  {
+    tmp = aa % bb;
+    aa  = bb;
+    bb  = tmp;
+  }
+
+  if ( (den == 0) || (ticksPerSec / aa > MAX_TICKS_PER_SEC / den) )
+  {
+    ticksPerSec = MAX_TICKS_PER_SEC;
+  }
+  else
+  {
+    ticksPerSec = ticksPerSec / aa * den;
+  }
+
+}  // end AddTickRate()
+
+//############################################################################//
+//
+// Function: TickDenominator()
+//
+// Purpose:  Denominator of the continued fraction convergent that matches a
+//           time to rounding.  Zero when no denominator up to
+//           MAX_TICKS_PER_SEC does.
+//
+//############################################################################//
+int64_t SimExec::TickDenominator( double time )
+{
+  double  frac;
+  double  whole;
+  int64_t hh;
+  int64_t hPrev;
+  int64_t kk;
+  int64_t kPrev;
+  int64_t tmp;
+  int     idx;
+
+  hPrev = 1;
+  kPrev = 0;
+  hh    = static_cast<int64_t>( floor(time) );
+  kk    = 1;
+  frac  = time - floor(time);
+
+  for ( idx = 0; idx < 40; ++idx )
+  {
+    if ( fabs( time - static_cast<double>(hh) / kk ) <= 1.0e-12 * fabs(time) )
     {
-      pMdl->FrameUpdate();
+      return kk;
+    }
+
+    frac  = 1.0 / frac;
+    whole = floor( frac );
+    frac  = frac - whole;
 
-      pMdl->nextFrameTime += pMdl->frameTimeStep;
+    if ( whole > MAX_TICKS_PER_SEC )
+    {
+      break;
     }
 
-    //
-    //  Check the models for the next time step.
-    //
-    temp = pMdl->nextFrameTime - simTime;
-    if ( deltaTime - temp > SMALL )
+    tmp   = static_cast<int64_t>( whole ) * hh + hPrev;
+    hPrev = hh;
+    hh    = tmp;
+
+    tmp   = static_cast<int64_t>( whole ) * kk + kPrev;
+    kPrev = kk;
+    kk    = tmp;
+
+    if ( kk > MAX_TICKS_PER_SEC )
     {
-      deltaTime = temp;
+      break;
     }
+  }
 
-  }  // end for ( idx = 0; idx < mdlVec.size(); ++idx )
+  return 0;
 
-} // end FrameUpdate()
+}  // end TickDenominator()
+
+//############################################################################//
+//
+// Function: ToTick()
+//
+// Purpose:  Schedule time in ticks
+//
+//############################################################################//
+int64_t SimExec::ToTick( double time )
+{
+  if ( time > maxTime )
+  {
+    return NEVER_TICK;
+  }
+
+  return llround( time * ticksPerSec );
+
+}  // end ToTick()
+
+//############################################################################//
+//
+// Function: TickTime()
+//
+// Purpose:  Time of a tick
+//
+//############################################################################//
+double SimExec::TickTime( int64_t tick )
+{
+  if ( tick == NEVER_TICK )
+  {
+    return LARGE;
+  }
+
+  return static_cast<double>( tick ) / ticksPerSec;
+
+}  // end TickTime()
 
 //############################################################################//
 //
@@ -284,27 +617,13 @@ void SimExec::Finalize()
 
 //############################################################################//
 //
-// Function: Execute()
+// Function: SetupModels()
 //
-// Purpose:  Run the simulation
+// Purpose:  Add the sim modules to the module vector and connect them
 //
 //############################################################################//
-void SimExec::Execute( int argc, char *argv[] )
+void SimExec::SetupModels()
 {
-  double angA;      // rad Angle between relative position and velocity vectors.
-  double dummy;     // na  Throw away variable
-  int    idx;       // na  Loop variable
-  double overShoot; // m   Distance of travel beyond the closest point of
-                    //     approach.
-
-  strcpy( fileStub, argv[0] );
-
-  process_command_line(argc, argv);
-
-  //
-  // Set up all the sim modules
-  //
-
   //
   // Target
   //
@@ -372,29 +691,650 @@ void SimExec::Execute( int argc, char *argv[] )
   gdn.SetMslTse( &mslTse6 ); 
   gdn.SetAutopilot( &ap ); 
 
-  AddModel( &ap, "autopilot" );
-  ap.SetSimExec( this );
-  ap.SetMissile( &msl );
-  ap.SetGuidance( &gdn ); 
+  AddModel( &ap, "autopilot" );
+  ap.SetSimExec( this );
+  ap.SetMissile( &msl );
+  ap.SetGuidance( &gdn ); 
+
+  //
+  // Map the states of the dynamic models into the state arena
+  //
+  arena.Bind( mdlVec, &simTime );
+
+}  // end SetupModels()
+
+//############################################################################//
+//
+// Function: Configure()
+//
+// Purpose:  Set up this executive as a private copy of the master executive
+//           for use by a Monte Carlo worker thread.
+//
+//############################################################################//
+void SimExec::Configure( SimExec &master )
+{
+  int  idx;
+  char name[512];
+  char val[512];
+
+  //
+  // Replay the master's inputs so the models get the same parameters.
+  //
+  for ( idx = 0; idx < master.inputLog.size(); ++idx )
+  {
+    strcpy( name, master.inputLog[idx].first.c_str() );
+    strcpy( val,  master.inputLog[idx].second.c_str() );
+
+    parse_symbols( name, val );
+  }
+
+  strcpy( fileStub, master.fileStub );
+
+  pTrajSet = master.pTrajSet;
+
+  SetupModels();
+
+  SelectOutput( false );
+
+}  // end Configure()
+
+//############################################################################//
+//
+// Function: RunSingle()
+//
+// Purpose:  Make a single Monte Carlo run.  Everything the run touches is
+//           owned by this executive, so runs on separate executives can be
+//           made concurrently.
+//
+//############################################################################//
+void SimExec::RunSingle( int       runNo,
+                         RunResult &result )
+{
+  double angA;      // rad Angle between relative position and velocity vectors.
+  double cpaTime;   // sec Time of the closest point of approach
+  RelState curRel;  // na  Relative geometry at the end of this step
+  int    idx;       // na  Loop variable
+  double overShoot; // m   Distance of travel beyond the closest point of
+                    //     approach.
+  RelState prevRel; // na  Relative geometry at the end of the last step
+  bool   prevValid; // na  Flag that prevRel holds a completed step
+
+  run = runNo;
+
+  if ( rngMode == Random::PHILOX_RNG )
+  {
+    //
+    // Each model draws from its own counter based stream keyed by run
+    // number and model name.  No warm up is needed, and draws added to one
+    // model do not change the noise seen by any other.
+    //
+    runSeed = run;
+
+    for ( idx = 0; idx < mdlVec.size(); ++idx )
+    {
+      mdlVec[idx]->rng.SetStream( run,
+                                  Random::StreamId( mdlVec[idx]->mdlName.c_str() ) );
+      mdlVec[idx]->rng.SetGaussMode( gaussMode );
+      mdlVec[idx]->SetRng( &mdlVec[idx]->rng );
+    }
+  }
+  else
+  {
+    //
+    // Initialize random number generator
+    //
+    runSeed = -abs(2 * run - 1) * 13579;
+    rng.Seed( runSeed );
+    rng.SetGaussMode( gaussMode );
+
+    //
+    // "Warm up" random number seed
+    //
+    for ( idx = 0; idx < 500; ++idx )
+    {
+      rng.Uniform( 0.0, 1.0 );
+    }
+
+    //
+    // All models share the run generator
+    //
+    for ( idx = 0; idx < mdlVec.size(); ++idx )
+    {
+      mdlVec[idx]->SetRng( &rng );
+    }
+  }
+
+  //
+  // Run simulation
+  //
+
+  //
+  // Initialize the modules
+  //
+  Initialize();
+
+  arena.Reset( timeStep, intRtol, intAtol );
+
+  sprintf( filename, "%s-%05d%s", fileStub, run,
+           TrajFile::FileExt( outFormat ) );
+
+  if ( (outputRate > 0.0) && (pTrajSet != NULL) )
+  {
+    traj.Open( *pTrajSet, run, outputQueue, outputDrop );
+  }
+  else if ( outputRate > 0.0 )
+  {
+    traj.Open( filename, outFormat, outputQueue, outputDrop );
+  }
+
+  //
+  // Print the output file header if necessary
+  //
+  if ( traj.IsOpen() )
+  {
+    Output( true, traj );
+  }
+
+  deltaTick = timeStepTick;
+  deltaTime = TickTime( deltaTick );
+
+  cpaTime   = 0.0;
+  curRel.t  = simTime;
+  prevValid = false;
+
+  //
+  // Main simulation loop
+  //
+  done = false;
+  while ( !done )
+  {
+    //
+    // Update variables in preparation for derivative calculations.
+    //
+    Update();
+  
+    Integrate();
+
+    //
+    // Time of the states at the end of this step.  Frame updates pick the
+    // next step size.
+    //
+    curRel.t += deltaTime;
+
+    //
+    // Update variables with the resultes of integration.
+    //
+    Update();
+
+    //
+    // Frame updates can run asynchrously with respect to eash other and the
+    // base simulation run rate.  Dynamics integration will be current at the
+    // time of any frame update.
+    //
+    FrameUpdate();
+
+    relPxf = tgt.pxf - msl.pxf;
+    relPyf = tgt.pyf - msl.pyf;
+
+    range = sqrt( SQ(relPxf) + SQ(relPyf) );
+
+    relVxf = tgt.vxf - msl.vxf;
+    relVyf = tgt.vyf - msl.vyf;
+
+    relVmag = sqrt( SQ(relVxf) + SQ(relVyf) );
+
+    rDot = ( relVxf * relPxf + relVyf * relPyf ) / range;
+
+    curRel.px = relPxf;
+    curRel.py = relPyf;
+    curRel.vx = relVxf;
+    curRel.vy = relVyf;
+
+    if ( rDot >= 0.0 )
+    {
+      done = true;
+   
+      //
+      // Calculate the miss distance
+      //
+
+      if ( cpaEn && prevValid )
+      {
+        //
+        // Closest point of approach between the last two steps
+        //
+        cpaTime = SolveCpa( prevRel, curRel );
+      }
+      //
+      // Use dot product to calculate the angle between relative position and
+      // velocity vectors.
+      //
+      else if ( range == 0.0 )
+      {
+        angA = 0.0;
+        miss = 0.0;
+        overShoot = 0.0;
+        missX = 0.0;
+        missY = 0.0;
+      }
+      else
+      {
+        angA = acos( (relPxf * relVxf + relPyf * relVyf) / (range * relVmag) );
+        miss = range * sin( angA );
+
+        overShoot = range * cos(angA);
+
+        missX = relPxf - overShoot * relVxf / relVmag;
+        missY = relPyf - overShoot * relVyf / relVmag;
+      }
+    }  // end if ( rDot >= 0.0 )
+    else if ( simTime >= maxTime )
+    {
+      done = true;
+      
+      miss = missX = missY = LARGE;
+    }
+
+    if ( !done )
+    {
+      simTick += deltaTick;
+      simTime  = TickTime( simTick );
+
+      prevRel   = curRel;
+      prevValid = true;
+    }
+  
+  }  // end while ( !done )
+  
+  //
+  // Do final dump of data
+  //
+  if ( traj.IsOpen() )
+  {
+    Output( false, traj );
+
+    traj.Close();
+  }
+
+  result.trajRows    = traj.Rows();
+  result.trajWaits   = traj.Waits();
+  result.trajDropped = traj.Dropped();
+
+  result.run   = run;
+  result.seed  = runSeed;
+  result.miss  = miss;
+  result.missX = missX;
+  result.missY = missY;
+  result.tof   = simTime;
+  result.xAng  = 0.0;
+
+  if ( cpaEn && prevValid && (miss < LARGE) )
+  {
+    result.tof = cpaTime;
+  }
+
+  if ( miss < flyerThld )
+  {
+    //
+    // Crossing angle. Supplement of angle between tgt & msl velocity vectors.
+    //
+    result.xAng = acos( (msl.vxf * tgt.vxf + msl.vyf * tgt.vyf) /
+                     sqrt((msl.vxf*msl.vxf + msl.vyf*msl.vyf) *
+                          (tgt.vxf*tgt.vxf + tgt.vyf*tgt.vyf)) );
+
+    result.xAng = PI - result.xAng;
+  }
+
+}  // end RunSingle()
+
+//############################################################################//
+//
+// Function: SolveCpa()
+//
+// Purpose:  Solve for the closest point of approach across one step
+//
+//############################################################################//
+double SimExec::SolveCpa( const RelState &prev,
+                          const RelState &cur )
+{
+  double hh;        // sec Step size
+  int    idx;       // na  Loop variable
+  double lo;        // na  Normalized time with range rate negative
+  double hi;        // na  Normalized time with range rate non-negative
+  double ss;        // na  Normalized time in the step, 0 to 1
+  double s2;        // na  ss squared
+  double s3;        // na  ss cubed
+  double h00;       // na  Hermite basis functions
+  double h10;       // na  Hermite basis functions
+  double h01;       // na  Hermite basis functions
+  double h11;       // na  Hermite basis functions
+  double px;        // m   Interpolated relative position
+  double py;        // m   Interpolated relative position
+  double vx;        // m/s Interpolated relative velocity
+  double vy;        // m/s Interpolated relative velocity
+
+  hh = cur.t - prev.t;
+
+  lo = 0.0;
+  hi = 1.0;
+  ss = 1.0;
+
+  for ( idx = 0; idx <= 60; ++idx )
+  {
+    //
+    // Bisect, then evaluate the solution on the final pass
+    //
+    if ( idx < 60 )
+    {
+      ss = 0.5 * ( lo + hi );
+    }
+    else
+    {
+      ss = hi;
+    }
+
+    s2 = ss * ss;
+    s3 = s2 * ss;
+
+    //
+    // Position basis, velocities scaled by the step size
+    //
+    h00 =  2.0 * s3 - 3.0 * s2 + 1.0;
+    h10 =        s3 - 2.0 * s2 + ss;
+    h01 = -2.0 * s3 + 3.0 * s2;
+    h11 =        s3 -       s2;
+
+    px = h00 * prev.px + h10 * hh * prev.vx + h01 * cur.px + h11 * hh * cur.vx;
+    py = h00 * prev.py + h10 * hh * prev.vy + h01 * cur.py + h11 * hh * cur.vy;
+
+    //
+    // Velocity basis, derivative of the position basis over the step size
+    //
+    h00 = ( 6.0 * s2 - 6.0 * ss ) / hh;
+    h10 =   3.0 * s2 - 4.0 * ss + 1.0;
+    h01 = ( 6.0 * ss - 6.0 * s2 ) / hh;
+    h11 =   3.0 * s2 - 2.0 * ss;
+
+    vx = h00 * prev.px + h10 * prev.vx + h01 * cur.px + h11 * cur.vx;
+    vy = h00 * prev.py + h10 * prev.vy + h01 * cur.py + h11 * cur.vy;
+
+    if ( idx < 60 )
+    {
+      if ( px * vx + py * vy < 0.0 )
+      {
+        lo = ss;
+      }
+      else
+      {
+        hi = ss;
+      }
+    }
+  }
+
+  missX = px;
+  missY = py;
+  miss  = sqrt( SQ(px) + SQ(py) );
+
+  return ( prev.t + ss * hh );
+
+}  // end SolveCpa()
+
+//############################################################################//
+//
+// Function: CollectRun()
+//
+// Purpose:  Accumulate one run into the run set statistics and print it if
+//           requested.  Runs must be collected in run order.
+//
+//############################################################################//
+void SimExec::CollectRun( RunResult &result )
+{
+  //
+  // Collect miss data
+  //
+  if ( exactStats )
+  {
+    missVec[runIdx] = result.miss;
+  }
+  else
+  {
+    missSketch.Add( result.miss );
+  }
+
+  if ( result.miss < flyerThld )
+  {
+    ++nonFlyerCnt;
+    missXstats.Add( result.missX );
+    missYstats.Add( result.missY );
+
+    avgMissMag = ( avgMissMag * static_cast<double>(nonFlyerCnt - 1) +
+                                         fabs(result.miss) ) /  nonFlyerCnt;
+
+    Xang = result.xAng;
+
+    avgXang = ( avgXang * static_cast<double>(nonFlyerCnt - 1) + Xang ) /
+                                                                nonFlyerCnt;
+
+  }
+
+  trajRows    += result.trajRows;
+  trajWaits   += result.trajWaits;
+  trajDropped += result.trajDropped;
+
+  //
+  // Count hits for pHit calculation
+  //
+  if ( result.miss < pHitThld )
+  {
+    ++hitCnt;
+  }
+
+  if ( printAll )  
+  {
+    if ( result.miss < flyerThld )
+    {
+      printf( "%5d",    result.run );
+      printf( "%10.3f", result.miss );
+      printf( "%10.3f", result.tof );
+      printf( "%10d",   result.seed );
+      printf( "\n" );
+      fflush( NULL );
+    }
+    else
+    {
+      printf( "%5d",    result.run );
+      printf( "%10.3e", result.miss );
+      printf( "%10.3f", result.tof );
+      printf( "%10d",   result.seed );
+      printf( "\n" );
+      fflush( NULL );
+    }
+  }
+  
+  if ( runIdx < runs - 1 )
+  {
+    ++runIdx;
+  }
+
+}  // end CollectRun()
+
+//############################################################################//
+//
+// Function: WorkerThread()
+//
+// Purpose:  Monte Carlo worker thread.  Makes runs on a private executive
+//           until the master has no runs left and posts each result.
+//
+//############################################################################//
+void SimExec::WorkerThread( SimExec *pMaster,
+                            SimExec *pWorker )
+{
+  int       idx;     // na  Index of the run being made
+  RunResult result;  // na  Results of the run
+
+  while ( true )
+  {
+    {
+      std::lock_guard<std::mutex> lock( pMaster->runMutex );
+
+      idx = pMaster->nextRunIdx++;
+    }
+
+    if ( idx >= pMaster->runs )
+    {
+      break;
+    }
+
+    pWorker->RunSingle( pMaster->runStart + idx, result );
+
+    {
+      std::lock_guard<std::mutex> lock( pMaster->runMutex );
+
+      pMaster->runResults[idx] = result;
+      pMaster->runReady[idx]   = true;
+    }
+
+    pMaster->runCond.notify_all();
+  }
+
+}  // end WorkerThread()
+
+//############################################################################//
+//
+// Function: ExecuteThreaded()
+//
+// Purpose:  Make the Monte Carlo run set on a pool of worker threads.  Each
+//           run is seeded from its run number, so the results match a
+//           serial run set.  Results are collected in run order.
+//
+//############################################################################//
+void SimExec::ExecuteThreaded()
+{
+  int                 idx;       // na  Loop variable
+  int                 nThreads;  // na  Quantity of worker threads
+  RunResult           result;    // na  Results of the run being collected
+  vector<std::thread> pool;      // na  Worker threads
+  vector<SimExec*>    workers;   // na  Worker thread executives
+
+  nThreads = threads;
+  if ( nThreads > runs )
+  {
+    nThreads = runs;
+  }
+
+  runResults.assign( runs, RunResult() );
+  runReady.assign( runs, false );
+  nextRunIdx = 0;
+
+  for ( idx = 0; idx < nThreads; ++idx )
+  {
+    workers.push_back( new SimExec() );
+    workers[idx]->Configure( *this );
+  }
+
+  for ( idx = 0; idx < nThreads; ++idx )
+  {
+    pool.push_back( std::thread( WorkerThread, this, workers[idx] ) );
+  }
+
+  for ( idx = 0; idx < runs; ++idx )
+  {
+    {
+      std::unique_lock<std::mutex> lock( runMutex );
+
+      while ( !runReady[idx] )
+      {
+        runCond.wait( lock );
+      }
+
+      result = runResults[idx];
+    }
+
+    CollectRun( result );
+  }
+
+  for ( idx = 0; idx < nThreads; ++idx )
+  {
+    pool[idx].join();
+
+    delete workers[idx];
+  }
+
+}  // end ExecuteThreaded()
+
+//############################################################################//
+//
+// Function: Execute()
+//
+// Purpose:  Run the simulation
+//
+//############################################################################//
+void SimExec::Execute( int argc, char *argv[] )
+{
+  double    dummy;  // na  Throw away variable
+  RunResult result; // na  Results of a single run
+
+  strcpy( fileStub, argv[0] );
+
+  process_command_line(argc, argv);
+
+  if ( threads <= 0 )
+  {
+    threads = std::thread::hardware_concurrency();
+
+    if ( threads <= 0 )
+    {
+      threads = 1;
+    }
+  }
+
+  //
+  // Set up all the sim modules
+  //
+  SetupModels();
+
+  SelectOutput( true );
+
+  //
+  // Open the run set container before any worker copies the executive
+  //
+  if ( outputSet && (outputRate > 0.0) )
+  {
+    sprintf( filename, "%s-%05d-%05d.trs", fileStub, runStart,
+             runStart + runs - 1 );
+
+    if ( trajSet.Open( filename, outFormat ) )
+    {
+      pTrajSet = &trajSet;
+    }
+    else
+    {
+      printf( "Cannot create %s, writing a file per run\n", filename );
+    }
+  }
 
   //
   //
   // 
   nonFlyerCnt  = 0;
   avgMissMag   = 0.0;
-  avgMissX     = 0.0;
-  avgMissY     = 0.0;
   avgXang      = 0.0;
   hitCnt       = 0;
   runIdx       = 0;
+  trajRows     = 0;
+  trajWaits    = 0;
+  trajDropped  = 0;
 
   //
-  // Set size of vector containers.  Hopefully this is faster than push_back()
+  // Small run sets keep every miss for exact percentiles.  Large ones
+  // stream the misses into the quantile sketch.
   //
-  missVec.insert(missVec.end(), runs, 0.0);
-  missNonFlyers.insert(missNonFlyers.end(), runs, 0.0);
-  missXvec.insert(missXvec.end(), runs, 0.0);
-  missYvec.insert(missYvec.end(), runs, 0.0);
+  exactStats = ( runs <= statsExactRuns );
+
+  if ( exactStats )
+  {
+    missVec.insert(missVec.end(), runs, 0.0);
+  }
 
   if ( printAll )  
   {
@@ -407,241 +1347,58 @@ void SimExec::Execute( int argc, char *argv[] )
     fflush( NULL );
   }
 
-  for ( run = runStart; run < runStart + runs; run++ )
+  if ( threads > 1 )
   {
-    //
-    // Initialize random number generator
-    //
-    seed = -abs(2 * run - 1) * 13579;
-    runSeed = seed;
-
-    //
-    // "Warm up" random number seed
-    //
-    for ( idx = 0; idx < 500; ++idx )
-    {
-      uniform( 0.0, 1.0, &seed );
-    }
-
-    //
-    // Run simulation
-    //
-
-    //
-    // Initialize the modules
-    //
-    Initialize();
-
-    sprintf( filename, "%s", fileStub );
-
-    sprintf( filename, "%s-%05d.dat", filename, run );
-
-    if ( outputRate > 0.0 )
-    {
-      pOutFile = fopen( filename, "w" );
-    }
-
-    //
-    // Print the output file header if necessary
-    //
-    if ( pOutFile != NULL )
-    {
-      Output( true, pOutFile );
-    }
-
-    deltaTime = timeStep;
-
-    //
-    // Main simulation loop
-    //
-    done = false;
-    while ( !done )
-    {
-      //
-      // Update variables in preparation for derivative calculations.
-      //
-      Update();
-    
-      Integrate();
-
-      //
-      // Update variables with the resultes of integration.
-      //
-      Update();
-
-      //
-      // Frame updates can run asynchrously with respect to eash other and the
-      // base simulation run rate.  Dynamics integration will be current at the
-      // time of any frame update.
-      //
-      FrameUpdate();
-
-      relPxf = tgt.pxf - msl.pxf;
-      relPyf = tgt.pyf - msl.pyf;
-
-      range = sqrt( SQ(relPxf) + SQ(relPyf) );
-
-      relVxf = tgt.vxf - msl.vxf;
-      relVyf = tgt.vyf - msl.vyf;
-
-      relVmag = sqrt( SQ(relVxf) + SQ(relVyf) );
-
-      rDot = ( relVxf * relPxf + relVyf * relPyf ) / range;
-
-      if ( rDot >= 0.0 )
-      {
-        done = true;
-     
-        //
-        // Calculate the miss distance
-        //
-
-        //
-        // Use dot product to calculate the angle between relative position and
-        // velocity vectors.
-        //
-        if ( range == 0.0 )
-        {
-          angA = 0.0;
-          miss = 0.0;
-          overShoot = 0.0;
-          missX = 0.0;
-          missY = 0.0;
-        }
-        else
-        {
-          angA = acos( (relPxf * relVxf + relPyf * relVyf) / (range * relVmag) );
-          miss = range * sin( angA );
-
-          overShoot = range * cos(angA);
-
-          missX = relPxf - overShoot * relVxf / relVmag;
-          missY = relPyf - overShoot * relVyf / relVmag;
-        }
-      }  // end if ( rDot >= 0.0 )
-      else if ( simTime >= maxTime )
-      {
-        done = true;
-        
-        miss = missX = missY = LARGE;
-      }
-
-      if ( !done )
-      {
-        simTime += deltaTime;
-      }
-    
-    }  // end while ( !done )
-    
-    //
-    // Do final dump of data
-    //
-    if ( pOutFile != NULL ) 
+    ExecuteThreaded();
+  }
+  else
+  {
+    for ( run = runStart; run < runStart + runs; run++ )
     {
-      Output( false, pOutFile );
+      RunSingle( run, result );
 
-      fclose( pOutFile );
+      CollectRun( result );
     }
+  }
 
-    //
-    // Collect miss data
-    //
-    missVec[runIdx] = miss;
-    if ( miss < flyerThld )
-    {
-      ++nonFlyerCnt;
-      missNonFlyers[nonFlyerCnt-1] = miss;
-      missXvec[nonFlyerCnt-1] = missX;
-      missYvec[nonFlyerCnt-1] = missY;
-
-      avgMissMag = ( avgMissMag * static_cast<double>(nonFlyerCnt - 1) +
-                                                  fabs(miss) ) /  nonFlyerCnt;
-      avgMissX = ( avgMissX * static_cast<double>(nonFlyerCnt - 1) + missX ) /
-                                                                  nonFlyerCnt;
-      avgMissY = ( avgMissY * static_cast<double>(nonFlyerCnt - 1) + missY ) /
-                                                                  nonFlyerCnt;
-
-      //
-      // Crossing angle. Supplement of angle between tgt & msl velocity vectors.
-      //
-      Xang = acos( (msl.vxf * tgt.vxf + msl.vyf * tgt.vyf) /
-              sqrt((msl.vxf*msl.vxf + msl.vyf*msl.vyf) *
-                   (tgt.vxf*tgt.vxf + tgt.vyf*tgt.vyf)) );
-
-      Xang = PI - Xang;
-
-      avgXang = ( avgXang * static_cast<double>(nonFlyerCnt - 1) + Xang ) /
-                                                                  nonFlyerCnt;
-
-    }
+  trajSet.Close();
 
-    //
-    // Count hits for pHit calculation
-    //
-    if ( miss < pHitThld )
-    {
-      ++hitCnt;
-    }
+  pHit = static_cast<double>( hitCnt ) / static_cast<double>( runs );
 
-    if ( printAll )  
+  if ( exactStats )
+  {
+    sort( missVec.begin(), missVec.end() );
+    if ( modf(static_cast<double>(runs) / 2.0, &dummy) < SMALL )
     {
-      if ( miss < flyerThld )
-      {
-        printf( "%5d",    run );
-        printf( "%10.3f", miss );
-        printf( "%10.3f", simTime );
-        printf( "%10d",   runSeed );
-        printf( "\n" );
-        fflush( NULL );
-      }
-      else
-      {
-        printf( "%5d",    run );
-        printf( "%10.3e", miss );
-        printf( "%10.3f", simTime );
-        printf( "%10d",   runSeed );
-        printf( "\n" );
-        fflush( NULL );
-      }
+      medMiss = ( missVec[runs/2-1] + missVec[runs/2] ) / 2.0;
     }
-    
-    if ( runIdx < runs - 1 )
+    else
     {
-      ++runIdx;
+      medMiss = missVec[(int)((runs-1)/2)];
     }
 
-  }  // end for ( run = runStart; run < runStart + runs; run++ )
-
-  pHit = static_cast<double>( hitCnt ) / static_cast<double>( runs );
+    miss70 = SortedQuantile( missVec, 0.7 );
+    miss20 = SortedQuantile( missVec, 0.2 );
+    miss35 = SortedQuantile( missVec, 0.35 );
 
-  sort( missVec.begin(), missVec.end() );
-  if ( modf(static_cast<double>(runs) / 2.0, &dummy) < SMALL )
-  {
-    medMiss = ( missVec[runs/2] + missVec[runs/2+1] ) / 2.0;
+    minMiss = missVec[0];
+    maxMiss = missVec[runs-1];
   }
   else
   {
-    medMiss = missVec[(int)((runs-1)/2)];
-  }
+    medMiss = missSketch.Quantile( 0.5 );
+    miss70  = missSketch.Quantile( 0.7 );
+    miss20  = missSketch.Quantile( 0.2 );
+    miss35  = missSketch.Quantile( 0.35 );
 
-  if ( runs > 1 )
-  {
-    miss70 = missVec[(int)(runs*0.7)-1];
-    miss20 = missVec[(int)(runs*0.2)-1];
-    miss35 = missVec[(int)(runs*0.35)-1];
+    minMiss = missSketch.Min();
+    maxMiss = missSketch.Max();
   }
-  else
-  {
-    miss70 = missVec[0];
-    miss20 = missVec[0];
-    miss35 = missVec[0];
-  }
-
-  minMiss = missVec[0];
-  maxMiss = missVec[runs-1];
 
-  stdMissX = CalcStdDev( missXvec );
-  stdMissY = CalcStdDev( missYvec );
+  avgMissX = missXstats.Mean();
+  avgMissY = missYstats.Mean();
+  stdMissX = missXstats.StdDev();
+  stdMissY = missYstats.StdDev();
 
   qtyFly = runs - nonFlyerCnt;
 
@@ -681,38 +1438,181 @@ void SimExec::Execute( int argc, char *argv[] )
   printf( "%10d ",   qtyFly );
   printf( "\n " );
 
+  if ( !exactStats )
+  {
+    PrintSketchBounds();
+  }
+
+  if ( (outputRate > 0.0) && (outputQueue > 0) )
+  {
+    printf( "\n" );
+    printf( "trajectory writer: %ld rows, %ld waits for a full queue, "
+            "%ld rows dropped\n", trajRows, trajWaits, trajDropped );
+  }
+
 }  // end Execute()
+
+//############################################################################//
+//
+// Function: PrintSketchBounds()
+//
+// Purpose:  Print the rank error bound of the miss quantile sketch and the
+//           range of misses each percentile estimate may stand for.
+//
+//############################################################################//
+void SimExec::PrintSketchBounds()
+{
+  int    idx;
+  double err;
+
+  const char  *name[4]  = { "miss70", "medMiss", "miss35", "miss20" };
+  const double quant[4] = { 0.7, 0.5, 0.35, 0.2 };
+  const double value[4] = { miss70, medMiss, miss35, miss20 };
+
+  err = missSketch.RankError();
+
+  printf( "\n" );
+  printf( "miss percentiles from a quantile sketch of %d of %d misses, "
+          "rank error within %.4f%%\n",
+          missSketch.Retained(), runs, 100.0 * err );
+
+  printf( "%10s %10s %10s %10s\n", "", "estimate", "lower", "upper" );
+
+  for ( idx = 0; idx < 4; ++idx )
+  {
+    printf( "%10s %10.3f %10.3f %10.3f\n", name[idx], value[idx],
+            missSketch.Quantile( quant[idx] - err ),
+            missSketch.Quantile( quant[idx] + err ) );
+  }
+
+}  // end PrintSketchBounds()
       
 //############################################################################//
 //
-// Function: Output()
+// Function: SelectOutput()
 //
-// Purpose:  Run the simulation
+// Purpose:  Select the model output channels named by ex.channels
 //
 //############################################################################//
-void SimExec::Output( bool  printHeader,
-                      FILE *pOutFile )
+void SimExec::SelectOutput( bool warn )
 {
-  int idx;
+  int            idx;      // na  Loop variable
+  int            jdx;      // na  Loop variable
+  int            qty;      // na  Quantity of channels a pattern selects
+  size_t         start;    // na  Start of a pattern in channelSel
+  size_t         end;      // na  End of a pattern in channelSel
+  vector<string> patterns; // na  Channel glob patterns
+
+  for ( start = 0; start <= channelSel.size(); start = end + 1 )
+  {
+    end = channelSel.find( ',', start );
+
+    if ( end == string::npos )
+    {
+      end = channelSel.size();
+    }
+
+    if ( end > start )
+    {
+      patterns.push_back( channelSel.substr( start, end - start ) );
+    }
+  }
+
+  for ( idx = 0; idx < mdlVec.size(); ++idx )
+  {
+    mdlVec[idx]->SelectChannels( patterns );
+  }
 
-  if ( printHeader )
+  if ( !warn )
   {
-    fprintf( pOutFile, "%20s", "simTime");
-    fprintf( pOutFile, "%20s", "seed");
+    return;
   }
-  else
+
+  for ( idx = 0; idx < patterns.size(); ++idx )
+  {
+    qty = 0;
+
+    for ( jdx = 0; jdx < mdlVec.size(); ++jdx )
+    {
+      const vector<OutChannel> &chans = mdlVec[jdx]->GetChannels();
+
+      for ( start = 0; start < chans.size(); ++start )
+      {
+        qty += TrajFile::GlobMatch( patterns[idx].c_str(), chans[start].name.c_str() );
+      }
+    }
+
+    if ( qty == 0 )
+    {
+      printf( "ex.channels pattern %s matches no output channel\n",
+              patterns[idx].c_str() );
+    }
+  }
+
+}  // end SelectOutput()
+
+//############################################################################//
+//
+// Function: ListChannels()
+//
+// Purpose:  List the output channels and their units, then exit
+//
+//############################################################################//
+void SimExec::ListChannels()
+{
+  int idx;
+  int jdx;
+
+  MdlBase *pMdls[] = { this, &tgt, &fcRdr, &fcTseO, &fcTse6, &msl, &skr,
+                       &mslTse6, &gdn, &ap };
+
+  printf("-----------------+--------------------------------------\n");
+  printf("   channel       |   units \n");
+  printf("-----------------+--------------------------------------\n");
+
+  for ( idx = 0; idx < sizeof(pMdls) / sizeof(pMdls[0]); ++idx )
   {
-    fprintf( pOutFile, "%20.6e", simTime ); 
-    fprintf( pOutFile, "%20d", runSeed ); 
+    const vector<OutChannel> &chans = pMdls[idx]->GetChannels();
+
+    for ( jdx = 0; jdx < chans.size(); ++jdx )
+    {
+      printf("%-17s| %s%s\n", chans[jdx].name.c_str(),
+             chans[jdx].units.c_str(),
+             ( chans[jdx].type == REAL_CHAN ) ? "" : ", integer");
+    }
   }
 
+  printf("-----------------+--------------------------------------\n");
+  printf("\n");
+  printf("Select channels with ex.channels=pattern,pattern,... where a\n");
+  printf("pattern '*' matches any characters and '?' any one character.\n");
+  printf("\n");
+  exit(0);
+
+}  // end ListChannels()
+
+//############################################################################//
+//
+// Function: Output()
+//
+// Purpose:  Run the simulation
+//
+//############################################################################//
+void SimExec::Output( bool      printHeader,
+                      TrajFile &traj )
+{
+  int idx;
+
+  MdlBase::Output( printHeader,
+                   traj );
+
   for ( idx = 0; idx < mdlVec.size(); ++idx )
   {
     mdlVec[idx]->Output( printHeader,
-                         pOutFile );
+                         traj );
   }
 
-  fprintf( pOutFile, "\n" );
+  traj.EndRow();
 
 }  // end Output()
 
@@ -817,16 +1717,30 @@ void SimExec::parse_symbols( char *name, char *val )
   // SimExec inputs
   //
   if (strcmp(name, "ex.file")==0)                 read_file(val);
+  else if (strcmp(name, "ex.cpa")==0)             cpaEn                        = get_boolean(val);
   else if (strcmp(name, "ex.dt")==0)              timeStep                     = atof(val);
   else if (strcmp(name, "ex.fileStub")==0)        sprintf(fileStub, "%s", val);
   else if (strcmp(name, "ex.flyerThld")==0)       flyerThld                    = atof(val);
+  else if (strcmp(name, "ex.gaussMode")==0)       gaussMode                    = static_cast<Random::GaussMode>( get_list_index(val, GAUSS_MODE_STR, 2) );
   else if (strcmp(name, "help")==0)               Help();
+  else if (strcmp(name, "channels")==0)           ListChannels();
+  else if (strcmp(name, "ex.channels")==0)        channelSel                   = get_string(val);
+  else if (strcmp(name, "ex.integrator")==0)      integMode                    = static_cast<StateArena::IntegMode>( get_list_index(val, INTEG_MODE_STR, 3) );
+  else if (strcmp(name, "ex.atol")==0)            intAtol                      = atof(val);
   else if (strcmp(name, "ex.maxTime")==0)         maxTime                      = atof(val);
+  else if (strcmp(name, "ex.outputFormat")==0)    outFormat                    = static_cast<TrajFile::OutFormat>( get_list_index(val, OUT_FORMAT_STR, 3) );
+  else if (strcmp(name, "ex.outputDrop")==0)      outputDrop                   = get_boolean(val);
+  else if (strcmp(name, "ex.outputQueue")==0)     outputQueue                  = atoi(val);
   else if (strcmp(name, "ex.outputRate")==0)      outputRate                   = atof(val);
+  else if (strcmp(name, "ex.outputSet")==0)       outputSet                    = get_boolean(val);
   else if (strcmp(name, "ex.pHitThld")==0)        pHitThld                     = atof(val);
   else if (strcmp(name, "ex.printAll")==0)        printAll                     = get_boolean(val);
   else if (strcmp(name, "ex.runs")==0)            runs                         = atoi(val);
+  else if (strcmp(name, "ex.rngMode")==0)         rngMode                      = static_cast<Random::RngMode>( get_list_index(val, RNG_MODE_STR, 2) );
+  else if (strcmp(name, "ex.statsExactRuns")==0) statsExactRuns               = atoi(val);
+  else if (strcmp(name, "ex.rtol")==0)            intRtol                      = atof(val);
   else if (strcmp(name, "ex.runStart")==0)        runStart                     = atoi(val);
+  else if (strcmp(name, "ex.threads")==0)         threads                      = atoi(val);
   else if (strcmp(name, "ex.tgo")==0)             tFinal                       = atof(val);
   else if (strcmp(name, "ex.xa")==0)              xa                           = atof(val)*d2r;
 
@@ -855,6 +1769,7 @@ void SimExec::parse_symbols( char *name, char *val )
   //
   // Fire Control TSE inputs
   //
+  else if (strcmp(name, "fcTseO.covForm")==0)     fcTseO.covFormInt           = get_int_range(val, UD_FACTOR::cfJOSEPH, UD_FACTOR::cfUD);
   else if (strcmp(name, "fcTseO.frameTimeStep")==0) fcTseO.frameTimeStep       = atof(val);
   else if (strcmp(name, "fcTseO.initFrameTime")==0) fcTseO.initFrameTime       = atof(val);
   else if (strcmp(name, "fcTseO.initPosY")==0)    fcTseO.initPosY              = atof(val);
@@ -868,6 +1783,7 @@ void SimExec::parse_symbols( char *name, char *val )
   //
   // Fire Control TSE6 inputs
   //
+  else if (strcmp(name, "fcTse6.covForm")==0)     fcTse6.covFormInt           = get_int_range(val, UD_FACTOR::cfJOSEPH, UD_FACTOR::cfUD);
   else if (strcmp(name, "fcTse6.frameTimeStep")==0) fcTse6.frameTimeStep       = atof(val);
   else if (strcmp(name, "fcTse6.initFrameTime")==0) fcTse6.initFrameTime       = atof(val);
   else if (strcmp(name, "fcTse6.singerTau")==0)   fcTse6.singerTau             = atof(val);
@@ -893,6 +1809,7 @@ void SimExec::parse_symbols( char *name, char *val )
   //
   // Projectile MSC TSE inputs
   //
+  else if (strcmp(name, "mslTse6.covForm")==0)    mslTse6.covFormInt          = get_int_range(val, UD_FACTOR::cfJOSEPH, UD_FACTOR::cfUD);
   else if (strcmp(name, "mslTse6.frameTimeStep")==0) mslTse6.frameTimeStep     = atof(val);
   else if (strcmp(name, "mslTse6.initFrameTime")==0) mslTse6.initFrameTime     = atof(val);
   else if (strcmp(name, "mslTse6.datalinkStep")==0) mslTse6.datalinkStep       = atof(val);
@@ -921,6 +1838,16 @@ void SimExec::parse_symbols( char *name, char *val )
   else
   {
     fprintf(stderr, "Unrecognized symbol %s, skipping...\n", name);
+
+    return;
+  }
+
+  //
+  // Keep the inputs so Monte Carlo worker threads can replay them.
+  //
+  if ( (strcmp(name, "ex.file") != 0) && (strcmp(name, "help") != 0) )
+  {
+    inputLog.push_back( InputPair(name, val) );
   }
 
   if ( strcmp(name, "fileStub") == 0 )
@@ -955,18 +1882,32 @@ void SimExec::Help()
   printf("-----------------+--------------------------------------+-----------+-------------\n");
   printf(">Simulation Executive Parameters\n");
   printf("-----------------+--------------------------------------+-----------+-------------\n");
+  printf("ex.atol          | dp5 absolute error tolerance         |    na     | %g \n", intAtol );
+  printf("ex.channels      | Output channel globs, comma separated|    na     | %s \n", channelSel.c_str() );
+  printf("channels         | Print output channels and units      |    na     | \n");
+  printf("ex.cpa           | Solve for closest point of approach  |  boolean  | %s \n", boolean_string(cpaEn) );
   printf("ex.dt            | simulation time step                 |    sec    | %g \n", timeStep );
   printf("ex.file          | Take inputs from file                |  boolean  | \n");
   printf("ex.fileWtub      | Output filename header               |   string  | %s \n", fileStub );
   printf("ex.flyerThld     | Flyer miss distance threshold        |     m     | %g \n", flyerThld );
+  printf("ex.gaussMode     | Normal generator: sum12 or boxMuller |    na     | %s \n", GAUSS_MODE_STR[gaussMode] );
   printf("help             | Print input variables, units, default|    na     | \n");
+  printf("ex.integrator    | Integrator: rk4, rk4Fused or dp5     |    na     | %s \n", INTEG_MODE_STR[integMode] );
   printf("ex.maxTtime      | Maximum simulation time              |    sec    | %g \n", maxTime );
+  printf("ex.outputFormat  | Trajectory file: text, bin or bin32  |    na     | %s \n", OUT_FORMAT_STR[outFormat] );
+  printf("ex.outputDrop    | Drop trajectory rows on a full queue |  boolean  | %s \n", boolean_string(outputDrop) );
+  printf("ex.outputQueue   | Trajectory writer queue, 0 = inline  |   blocks  | %d \n", outputQueue );
   printf("ex.outputRate    | Simulation variable output rate      |     Hz    | %g \n", outputRate );
+  printf("ex.outputSet     | One indexed .trs file for the run set|  boolean  | %s \n", boolean_string(outputSet) );
   printf("ex.pHitThld      | Miss threshold for pHit calculation  |     m     | %g \n", pHitThld );
   printf("ex.printAll      | Print all Monte Carlo misses         |  boolean  | %s \n", boolean_string(printAll) );
   printf("ex.runs          | runs per Monte Carlo set             |     1     | %d \n", runs );
+  printf("ex.rtol          | dp5 relative error tolerance         |    na     | %g \n", intRtol );
+  printf("ex.rngMode       | Random generator: ran1 or philox     |    na     | %s \n", RNG_MODE_STR[rngMode] );
   printf("ex.runStart      | First Monte Carlo run (1st run = 1)  |     1     | %d \n", runStart );
+  printf("ex.statsExactRuns| Max runs for exact miss percentiles  |    na     | %d \n", statsExactRuns );
   printf("ex.tgo           | Intercept time from sim start        |    sec    | %g \n", tFinal );
+  printf("ex.threads       | Monte Carlo threads (0 = all cores)  |    na     | %d \n", threads );
   printf("ex.xa            | Crossing angle                       |    deg    | %g \n", xa*r2d );
 
   printf("-----------------+--------------------------------------+-----------+-------------\n");
@@ -994,6 +1935,7 @@ void SimExec::Help()
   printf("-----------------+--------------------------------------+-----------+-------------\n");
   printf(">Fire Control TSE Model Parameters\n");
   printf("-----------------+--------------------------------------+-----------+-------------\n");
+  printf("fcTseO.covForm   | Covariance form 1=joseph, 2=ud       |    na     | %d \n", fcTseO.covFormInt );
   printf("fcTseO.frameTimeStep| Fire Control TSE frame time step  |    sec    | %g \n", fcTseO.frameTimeStep );
   printf("fcTseO.initFrameTime| Fire Control TSE frame start time |    sec    | %g \n", fcTseO.initFrameTime );
   printf("fcTseO.procNoise  | Fire Control TSE process noise      |   rad^2   | %g \n", fcTseO.procNoise );
@@ -1001,6 +1943,7 @@ void SimExec::Help()
   printf("-----------------+--------------------------------------+-----------+-------------\n");
   printf(">Fire Control TSE6 Model Parameters\n");
   printf("-----------------+--------------------------------------+-----------+-------------\n");
+  printf("fcTse6.covForm   | Covariance form 1=joseph, 2=ud       |    na     | %d \n", fcTse6.covFormInt );
   printf("fcTse6.frameTimeStep| Fire Control TSE frame time step  |    sec    | %g \n", fcTse6.frameTimeStep );
   printf("fcTse6.initFrameTime| Fire Control TSE frame start time |    sec    | %g \n", fcTse6.initFrameTime );
   printf("fcTse6.singerTau| Fire Control TSE tuning parameter     |    sec    | %g \n", fcTse6.singerTau );
@@ -1026,6 +1969,7 @@ void SimExec::Help()
   printf("-----------------+--------------------------------------+-----------+-------------\n");
   printf(">Projectile TSE6 Model Parameters\n");
   printf("-----------------+--------------------------------------+-----------+-------------\n");
+  printf("mslTse6.covForm  | Covariance form 1=joseph, 2=ud       |    na     | %d \n", mslTse6.covFormInt );
   printf("mslTse6.frameTimeStep| Seeker frame time step           |    sec    | %g \n", mslTse6.frameTimeStep );
   printf("mslTse6.initFrameTime| Seeker frame start time          |    sec    | %g \n", mslTse6.initFrameTime );
   printf("mslTse6.nextUpLinkTime| Datalink uplink interval        |    sec    | %g \n", mslTse6.datalinkStep );
@@ -1054,6 +1998,11 @@ void SimExec::Help()
   printf("\n");
   printf("Output is a single line of run set miss statistics:\n");
   printf("\n");
+  printf("miss70, miss35 and miss20 are the misses of rank ceil(p * runs), taken\n");
+  printf("from the sorted misses or, above ex.statsExactRuns runs, from a quantile\n");
+  printf("sketch.  medMiss of an even run set is the mean of the two middle\n");
+  printf("misses when sorted, the lower of the two from the sketch.\n");
+  printf("\n");
   exit(0);
 
 }  // end help()
@@ -1146,6 +2095,29 @@ int SimExec::get_boolean(char *str)
   exit(0);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// get_string(char *val)
+//
+// Overview:
+//
+//  Retrieves a string from the command line.  The line end of a value
+//  read from an input file is dropped.
+//
+///////////////////////////////////////////////////////////////////////////////
+string SimExec::get_string( char *val )
+{
+  int tmpN;
+
+  tmpN = strlen(val);
+  while ( (tmpN > 0) && ((val[tmpN-1] == '\n') || (val[tmpN-1] == '\r')) )
+  {
+    val[--tmpN] = '\0';
+  }
+
+  return string( val );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // get_list_index(char *val
@@ -1211,58 +2183,65 @@ int SimExec::get_list_index( char *val,
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// get_double( double *var,
-//             char *val,
-//             double scale_factor )
+// get_int_range(char *val,
+//               int  min_val,
+//               int  max_val)
 //
 // Overview:
 //
-//  Retrieves a double from the command line
+//  Retrieves an integer from the command line that must lie in
+//  [min_val, max_val]
 //
 ///////////////////////////////////////////////////////////////////////////////
-double SimExec::get_double( double *var,
-                            char   *val,
-                            double scale_factor )
+int SimExec::get_int_range( char *val,
+                            int  min_val,
+                            int  max_val )
 {
-  *var = atof(val) * scale_factor;
+  char *pEnd;
+  long  value;
 
-  return *var;
+  value = strtol(val, &pEnd, 10);
 
-}  // end get_double()
+  while ( (*pEnd == '\n') || (*pEnd == '\r') )
+  {
+    ++pEnd;
+  }
+
+  if ( (pEnd == val) || (*pEnd != '\0') || (value < min_val) ||
+       (value > max_val) )
+  {
+    printf("Invalid value in get_int_range: %s chosen from %d to %d\n",
+           get_string(val).c_str(), min_val, max_val);
+    printf("... exiting\n");
+
+    exit(0);
+  }
 
+  return static_cast<int>( value );
+
+}  // end get_int_range()
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// ResetAll()
+// get_double( double *var,
+//             char *val,
+//             double scale_factor )
 //
 // Overview:
 //
-//  Clear selected variables
+//  Retrieves a double from the command line
 //
 ///////////////////////////////////////////////////////////////////////////////
-double SimExec::CalcStdDev( vectorDbl dataVec )
+double SimExec::get_double( double *var,
+                            char   *val,
+                            double scale_factor )
 {
-  int    idx;
-  double mean = 0.0;
-  int    qtyElem = dataVec.size();
-  double stdDev = 0.0;
+  *var = atof(val) * scale_factor;
 
-  if ( qtyElem != 1 && qtyElem != 0 )
-  {
-    for ( idx = 0; idx < qtyElem; ++idx )
-    {
-      mean += dataVec[idx];
-    }
-    mean /= qtyElem;
+  return *var;
+
+}  // end get_double()
 
-    for ( idx = 0; idx < qtyElem; ++idx )
-    {
-      stdDev += SQ( dataVec[idx] - mean );
-    }
-    stdDev = sqrt( stdDev / (static_cast<double>(qtyElem) - 1.0) );
-  }
-  return( stdDev );
-}
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -1286,10 +2265,9 @@ void SimExec::ResetAll()
   missX        = 0.0;
   missY        = 0.0;
   nextFrameTime = 0.0;
-  outputTime   = 0.0;
-  outputTimeStep = 0.0;
+  outputTick   = 0;
+  outputTickStep = 0;
   pHit         = 0.0;
-  pOutFile     = NULL;
   qtyFly       = 0;
   range        = 0.0;
   rDot         = 0.0;
@@ -1298,6 +2276,7 @@ void SimExec::ResetAll()
   relVmag      = 0.0;
   relVxf       = 0.0;
   relVyf       = 0.0;
+  simTick      = 0;
   simTime      = 0.0;
   stdMissX     = 0.0;
   stdMissY     = 0.0;
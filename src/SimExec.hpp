@@ -21,7 +21,11 @@
 //
 // C/C++ includes and namespaces
 //
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
+#include <mutex>
+#include <utility>
 #include <vector>
 using std::vector;
 
@@ -35,8 +39,12 @@ using std::vector;
 #include "Guidance.hpp"
 #include "Missile.hpp"
 #include "MslTse6.hpp"
+#include "Random.hpp"
+#include "RunStats.hpp"
+#include "StateArena.hpp"
 #include "Seeker.hpp"
 #include "Target.hpp"
+#include "TrajSet.hpp"
 
 
 class SimExec : public MdlBase
@@ -51,16 +59,36 @@ public:
   //
   // Input parameters
   //
+  string channelSel;        // na      Output channel glob patterns, comma
+                            //         separated
+  bool   cpaEn;             // na      Flag to solve for the closest point
+                            //         of approach between steps
   char   fileStub[80];      // na      Output file name stub
   double flyerThld;         // m       Threshold for flyer miss distance
   double maxTime;           // sec     Maximum amount of simulation time
   double outputRate;        // Hz      Trajectory data output rate
+  TrajFile::OutFormat outFormat; // na   Trajectory data file format
+  bool   outputDrop;        // na      Flag to drop trajectory blocks when
+                            //         the writer queue is full
+  int    outputQueue;       // na      Trajectory blocks queued to the writer
+                            //         thread, 0 = write on the sim thread
+  bool   outputSet;         // na      Flag to write the run set to one
+                            //         indexed container file
   double pHitThld;          // m       Miss threshold for pHit calculation
   bool   printAll;          // na      Flag directing to print all Monte
                             //         Carlo run miss data
   int    runs;              // na      Number of runs in the Monte Carlo set
   int    runStart;          // na      First run to be made
+  int    statsExactRuns;    // na      Largest run set with exact miss
+                            //         percentiles, larger sets use the
+                            //         quantile sketch
   double tFinal;            // sec     Initial tgo
+  int    threads;           // na      Quantity of Monte Carlo worker threads
+  Random::RngMode rngMode;  // na      Random number generator selection
+  Random::GaussMode gaussMode; // na   Normal random number generator selection
+  StateArena::IntegMode integMode; // na Integrator selection
+  double intAtol;           // na      Adaptive integrator absolute tolerance
+  double intRtol;           // na      Adaptive integrator relative tolerance
   double timeStep;          // sec     Simulation frame time step
   double xa;                // rad     Crossing angle
 
@@ -81,7 +109,8 @@ public:
   double relVmag;           // m/sec   Magnitude of relative velocity
   double relVxf;            // m/sec   Velocity of target wrt missile
   double relVyf;            // m/sec   Velocity of target wrt missile
-  long   seed;              // na      Simulation random number seed
+  Random rng;               // na      Run random number generator
+  StateArena arena;         // na      Contiguous state of all dynamic models
   double simTime;           // sec     Simulation time
 
 //############################################################################//
@@ -164,8 +193,8 @@ public:
 // Purpose:  Print selected variables
 //
 //############################################################################//
-  void Output( bool printHeader,
-               FILE *pOutFile );
+  void Output( bool      printHeader,
+               TrajFile &traj );
 
 private:
 
@@ -174,10 +203,124 @@ private:
   //
   typedef vector<double> vectorDbl;
 
+  typedef std::pair<string, string> InputPair;
+
+  //
+  // Results of a single Monte Carlo run needed for the run set statistics
+  //
+  typedef struct _run_result_
+  {
+    int    run;             // na      Run number
+    int    seed;            // na      Run seed
+    double miss;            // m       Miss distance
+    double missX;           // m       Miss in X direction
+    double missY;           // m       Miss in Y direction
+    double tof;             // sec     Time of flight
+    double xAng;            // rad     Crossing angle
+    long   trajRows;        // na      Trajectory rows captured
+    long   trajWaits;       // na      Waits for the trajectory writer
+    long   trajDropped;     // na      Trajectory rows dropped
+  } RunResult;
+
+  //
+  // Relative geometry at the end of an integration step
+  //
+  typedef struct _rel_state_
+  {
+    double t;               // sec     Time of the states
+    double px;              // m       Position of target wrt missile
+    double py;              // m       Position of target wrt missile
+    double vx;              // m/sec   Velocity of target wrt missile
+    double vy;              // m/sec   Velocity of target wrt missile
+  } RelState;
+
+  //
+  // Model frame event in the frame queue
+  //
+  typedef struct _frame_event_
+  {
+    int64_t tick;           // na      Next frame tick of the model
+    int     idx;            // na      Model index in mdlVec
+  } FrameEvent;
+
+  //
+  // Frame queue ordering.  Later events sink, ties go to model order so
+  // the queue top is the earliest frame of the first model.
+  //
+  struct FrameLater
+  {
+    bool operator()( const FrameEvent &aa, const FrameEvent &bb ) const
+    {
+      return ( aa.tick > bb.tick ) ||
+             ( (aa.tick == bb.tick) && (aa.idx > bb.idx) );
+    }
+  };
+
   //
   // Class scope functions
   //
 
+//############################################################################//
+//
+// ScheduleFrames()
+//
+// Overview:
+//
+//  Load the frame queue with the next frame time of every model.  Call
+//  after the models are initialized.
+//
+//############################################################################//
+  void ScheduleFrames();
+
+//############################################################################//
+//
+// SetTickRate()
+//
+// Overview:
+//
+//  The executive clock counts integer ticks.  The tick rate is the least
+//  common multiple of the rates of every schedule time: the time step,
+//  maximum time, output interval and each model's first frame time and
+//  frame interval.  All of them are then whole numbers of ticks, so frames
+//  fall exactly on step boundaries with no accumulated drift.
+//
+//############################################################################//
+  void SetTickRate();
+
+  void AddTickRate( double time );
+
+  int64_t TickDenominator( double time );
+
+//############################################################################//
+//
+// ToTick(), TickTime()
+//
+// Overview:
+//
+//  Convert between schedule time and ticks
+//
+//############################################################################//
+  int64_t ToTick( double time );
+
+  double TickTime( int64_t tick );
+
+//############################################################################//
+//
+// SolveCpa()
+//
+// Overview:
+//
+//  Find the closest point of approach inside the step that carried rDot
+//  from negative to non-negative.  The relative motion across the step is
+//  the cubic Hermite interpolant of the end point positions and velocities,
+//  the dense output of the integrator.  The root of the range rate on the
+//  interpolant is found by bisection.  Sets miss, missX and missY and
+//  returns the time of the closest point of approach.
+//
+//############################################################################//
+  double SolveCpa( const RelState &prev,
+                   const RelState &cur );
+
 //############################################################################//
 //
 // Help()
@@ -189,6 +332,98 @@ private:
 //############################################################################//
   void Help();
 
+//############################################################################//
+//
+// ListChannels()
+//
+// Overview:
+//
+//  List the output channels of every model and their units, then exit.
+//
+//############################################################################//
+  void ListChannels();
+
+//############################################################################//
+//
+// SelectOutput()
+//
+// Overview:
+//
+//  Select the output channels of the models named by ex.channels.  The
+//  executive's simTime and seed always lead the row.  With warn set, a
+//  pattern that selects nothing is reported.
+//
+//############################################################################//
+  void SelectOutput( bool warn );
+
+//############################################################################//
+//
+// SetupModels()
+//
+// Overview:
+//
+//  Add the sim modules to the module vector and connect their references.
+//
+//############################################################################//
+  void SetupModels();
+
+//############################################################################//
+//
+// Configure()
+//
+// Overview:
+//
+//  Make this executive an isolated copy of another one by replaying the
+//  other's input symbols and building a private set of sim modules.
+//
+//############################################################################//
+  void Configure( SimExec &master );
+
+//############################################################################//
+//
+// RunSingle()
+//
+// Overview:
+//
+//  Make one Monte Carlo run and return the data needed for statistics.
+//
+//############################################################################//
+  void RunSingle( int runNo, RunResult &result );
+
+//############################################################################//
+//
+// CollectRun()
+//
+// Overview:
+//
+//  Accumulate the results of one run into the run set statistics.  Must be
+//  called in run order.
+//
+//############################################################################//
+  void CollectRun( RunResult &result );
+
+//############################################################################//
+//
+// ExecuteThreaded()
+//
+// Overview:
+//
+//  Make the Monte Carlo runs on a pool of worker threads.  Each worker owns
+//  a private executive and model set.  Results are collected in run order.
+//
+//############################################################################//
+  void ExecuteThreaded();
+
+//############################################################################//
+//
+// WorkerThread()
+//
+// Overview:
+//
+//  Worker thread entry point.  Takes runs from the master until none remain.
+//
+//############################################################################//
+  static void WorkerThread( SimExec *pMaster, SimExec *pWorker );
 
   void ResetAll();
 
@@ -201,10 +436,16 @@ private:
 
   int  get_boolean(char *str);
 
+  string get_string( char *val );
+
   int  get_list_index( char *val, 
                        char **list, 
                        int  max_index );
 
+  int  get_int_range( char *val,
+                      int  min_val,
+                      int  max_val );
+
   double get_double( double *var, 
                      char *val, 
                      double scale_factor );
@@ -217,12 +458,25 @@ private:
 
   void AddModel( MdlBase *pMdl, string mdlName );
 
-  double CalcStdDev( vectorDbl dataVec );
+//############################################################################//
+//
+// PrintSketchBounds()
+//
+// Overview:
+//
+//  Print the error bound of the percentiles estimated by the sketch.
+//
+//############################################################################//
+  void PrintSketchBounds();
 
   //
   // Class scope variables
   //
-  FILE   *pOutFile;  // Output file pointer
+  TrajFile  traj;           // na      Run trajectory output file
+  TrajSet   trajSet;        // na      Run set trajectory container
+  TrajSet  *pTrajSet;       // na      Container the runs are written to,
+                            //         the master's, or NULL for a file
+                            //         per run
 
   vector<MdlBase*> mdlVec;  // na      Vector of pointers to all sim modules
   MdlBase   *pMdl;          // na      Pointer to selected module    
@@ -232,29 +486,51 @@ private:
   double    avgMissY;       // m       Average of miss distance along X
   double    avgXang;        // rad     Average crossing angle
   double    deltaTime;      // sec     The current simulation time step
+  int64_t   deltaTick;      // na      The current time step in ticks
   bool      done;           // na      Run completion flag
   char      filename[160];  // na      Name of the output data file
   int       hitCnt;         // na      Hit counter for pHit calculation
   double    maxMiss;        // m       Max miss distnace
+  int64_t   maxTick;        // na      Maximum simulation time in ticks
   double    medMiss;        // m       Median miss distance
   double    minMiss;        // m       Min miss distance
+  bool      exactStats;     // na      Flag that missVec holds every miss
   vectorDbl missVec;        // m       Collection of run set miss data
-  vectorDbl missNonFlyers;  // m       Collection of run set miss data
-  vectorDbl missXvec;       // m       Collection of run set miss data
-  vectorDbl missYvec;       // m       Collection of run set miss data
+  QuantileSketch missSketch;// m       Run set miss quantile sketch
+  Welford   missXstats;     // m       Mean and deviation of non flyer missX
+  Welford   missYstats;     // m       Mean and deviation of non flyer missY
+  int64_t   nextFrameTick;  // na      Tick of the next executive frame
+  int       nextRunIdx;     // na      Index of next run for a worker thread
   int       nonFlyerCnt;    // na      Quanty of non flyers
-  double    outputTime;     // sec     Time of next run data output event
-  double    outputTimeStep; // sec     Time step of run data output
+  int64_t   outputTick;     // na      Tick of next run data output event
+  int64_t   outputTickStep; // na      Time step of run data output in ticks
   double    pHit;           // na      Probability of hit (m out of n)
   int       qtyFly;         // na      Quantity of miss > flyer threshold
   int       run;            // na      Current run number
   int       runIdx;         // na      Run counter
   int       runSeed;        // na      Run seed
   double    stdMissX;       // m       Standard deviation of miss along X
+  int64_t   simTick;        // na      Simulation time in ticks
   double    stdMissY;       // m       Standard deviation of miss along Y
+  long      trajDropped;    // na      Trajectory rows dropped in the set
+  long      trajRows;       // na      Trajectory rows captured in the set
+  long      trajWaits;      // na      Waits for the trajectory writer in
+                            //         the set
+  int64_t   ticksPerSec;    // 1/sec   Executive clock rate
+  int64_t   timeStepTick;   // na      Simulation time step in ticks
   double    Xang;           // rad     Crossing angle.  Supplement of angle
                             //         between tgt & msl velocity vectors
 
+  vector<FrameEvent> frameQueue; // na  Min heap of model frame events
+  vector<int64_t>   frameTick;   // na  Next frame tick of each model
+  vector<int64_t>   frameTickStep; // na Frame interval of each model in ticks
+  vector<int>       frameDue;    // na  Models due for a frame update
+  vector<InputPair> inputLog;    // na  Input symbols in the order read
+  vector<RunResult> runResults;  // na  Worker thread results by run index
+  vector<bool>      runReady;    // na  Worker thread result available flags
+  std::mutex        runMutex;    // na  Guards the worker thread run data
+  std::condition_variable runCond; // na Signals a new worker thread result
+
   //
   // Simulation modules
   //
@@ -0,0 +1,577 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       StateArena.cpp
+
+    \author     David Bruce
+
+    \brief      Contiguous state vector for all dynamic models.
+
+*/
+//############################################################################//
+
+#include "StateArena.hpp"
+
+//
+// Sim includes
+//
+#include "MdlBase.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <algorithm>
+#include <cmath>
+
+//
+// Dormand-Prince 5(4) coefficients
+//
+const double DP_C2  = 1.0 / 5.0;
+const double DP_C3  = 3.0 / 10.0;
+const double DP_C4  = 4.0 / 5.0;
+const double DP_C5  = 8.0 / 9.0;
+
+const double DP_A21 = 1.0 / 5.0;
+const double DP_A31 = 3.0 / 40.0;
+const double DP_A32 = 9.0 / 40.0;
+const double DP_A41 = 44.0 / 45.0;
+const double DP_A42 = -56.0 / 15.0;
+const double DP_A43 = 32.0 / 9.0;
+const double DP_A51 = 19372.0 / 6561.0;
+const double DP_A52 = -25360.0 / 2187.0;
+const double DP_A53 = 64448.0 / 6561.0;
+const double DP_A54 = -212.0 / 729.0;
+const double DP_A61 = 9017.0 / 3168.0;
+const double DP_A62 = -355.0 / 33.0;
+const double DP_A63 = 46732.0 / 5247.0;
+const double DP_A64 = 49.0 / 176.0;
+const double DP_A65 = -5103.0 / 18656.0;
+
+//
+// Fifth order weights
+//
+const double DP_B1  = 35.0 / 384.0;
+const double DP_B3  = 500.0 / 1113.0;
+const double DP_B4  = 125.0 / 192.0;
+const double DP_B5  = -2187.0 / 6784.0;
+const double DP_B6  = 11.0 / 84.0;
+
+//
+// Difference between fifth and fourth order weights
+//
+const double DP_E1  = 71.0 / 57600.0;
+const double DP_E3  = -71.0 / 16695.0;
+const double DP_E4  = 71.0 / 1920.0;
+const double DP_E5  = -17253.0 / 339200.0;
+const double DP_E6  = 22.0 / 525.0;
+const double DP_E7  = -1.0 / 40.0;
+
+//
+// Step size control
+//
+const double DP_SAFETY    = 0.9;
+const double DP_MIN_SCALE = 0.2;
+const double DP_MAX_SCALE = 5.0;
+const double DP_MIN_STEP  = 1.0e-9;
+
+//############################################################################//
+//
+// Function: StateArena()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+StateArena::StateArena()
+{
+  nStates  = 0;
+  pSimTime = 0;
+
+  atol        = 1.0e-6;
+  rtol        = 1.0e-6;
+  nextStep    = 1.0e-3;
+  nDerivEvals = 0;
+
+}  // end StateArena()
+
+//############################################################################//
+//
+// Function: ~StateArena()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+StateArena::~StateArena()
+{
+
+}  // end ~StateArena()
+
+//############################################################################//
+//
+// Function: Bind()
+//
+// Purpose:  Map the registered model states into the arena
+//
+//############################################################################//
+void StateArena::Bind( vector<MdlBase *> &mdlVec,
+                       double            *pSimTime_ )
+{
+  int              idx;
+  int              jdx;
+  vector<double *> states;
+  vector<double *> derivs;
+
+  pSimTime = pSimTime_;
+
+  allMdls = mdlVec;
+
+  mdls.clear();
+  pState.clear();
+  pDeriv.clear();
+
+  for ( idx = 0; idx < mdlVec.size(); ++idx )
+  {
+    if ( mdlVec[idx]->intEn )
+    {
+      mdls.push_back( mdlVec[idx] );
+
+      mdlVec[idx]->GetStates( states );
+      mdlVec[idx]->GetDerivatives( derivs );
+
+      for ( jdx = 0; jdx < states.size(); ++jdx )
+      {
+        pState.push_back( states[jdx] );
+        pDeriv.push_back( derivs[jdx] );
+      }
+    }
+  }
+
+  nStates = pState.size();
+
+  xn.assign( nStates, 0.0 );
+  xs.assign( nStates, 0.0 );
+  xd.assign( nStates, 0.0 );
+  k1.assign( nStates, 0.0 );
+  k2.assign( nStates, 0.0 );
+  k3.assign( nStates, 0.0 );
+  k4.assign( nStates, 0.0 );
+
+  d1.assign( nStates, 0.0 );
+  d2.assign( nStates, 0.0 );
+  d3.assign( nStates, 0.0 );
+  d4.assign( nStates, 0.0 );
+  d5.assign( nStates, 0.0 );
+  d6.assign( nStates, 0.0 );
+  d7.assign( nStates, 0.0 );
+
+}  // end Bind()
+
+//############################################################################//
+//
+// Function: Reset()
+//
+// Purpose:  Start a new run
+//
+//############################################################################//
+void StateArena::Reset( double initStep,
+                        double rtol_,
+                        double atol_ )
+{
+  nextStep    = initStep;
+  rtol        = rtol_;
+  atol        = atol_;
+  nDerivEvals = 0;
+
+}  // end Reset()
+
+//############################################################################//
+//
+// Function: Gather()
+//
+// Purpose:  Copy model states into the arena
+//
+//############################################################################//
+void StateArena::Gather( double *xx )
+{
+  int idx;
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    xx[idx] = *pState[idx];
+  }
+
+}  // end Gather()
+
+//############################################################################//
+//
+// Function: Scatter()
+//
+// Purpose:  Copy the arena out to the model states
+//
+//############################################################################//
+void StateArena::Scatter( const double *xx )
+{
+  int idx;
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    *pState[idx] = xx[idx];
+  }
+
+}  // end Scatter()
+
+//############################################################################//
+//
+// Function: EvalDerivatives()
+//
+// Purpose:  Evaluate all model derivatives at the current model states
+//
+//############################################################################//
+void StateArena::EvalDerivatives( double *xd )
+{
+  int idx;
+
+  for ( idx = 0; idx < mdls.size(); ++idx )
+  {
+    mdls[idx]->UpdateDerivatives();
+  }
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    xd[idx] = *pDeriv[idx];
+  }
+
+  ++nDerivEvals;
+
+}  // end EvalDerivatives()
+
+//############################################################################//
+//
+// Function: StepRK4()
+//
+// Purpose:  Fused RK4 step.  The stage arithmetic runs over contiguous
+//           arrays, so the compiler can vectorize it.  The states and
+//           derivatives still pass through the model pointers once a stage
+//           in Gather(), Scatter() and EvalDerivatives().
+//
+//############################################################################//
+void StateArena::StepRK4( double timeStep )
+{
+  int     idx;
+  double  hh          = timeStep;
+  double  h_half      = hh / 2.0;
+  double  tempSimTime = *pSimTime;
+
+  double *pXn = &xn[0];
+  double *pXs = &xs[0];
+  double *pXd = &xd[0];
+  double *pK1 = &k1[0];
+  double *pK2 = &k2[0];
+  double *pK3 = &k3[0];
+  double *pK4 = &k4[0];
+
+  if ( nStates == 0 )
+  {
+    return;
+  }
+
+  Gather( pXn );
+
+  //
+  // Stage 1
+  //
+  EvalDerivatives( pXd );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pK1[idx] = pXd[idx] * hh;
+    pXs[idx] = pXn[idx] + pK1[idx] / 2.0;
+  }
+
+  //
+  // Advance clock half step for Stage 2 and Stage 3
+  //
+  *pSimTime += h_half;
+
+  //
+  // Stage 2
+  //
+  Scatter( pXs );
+  EvalDerivatives( pXd );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pK2[idx] = pXd[idx] * hh;
+    pXs[idx] = pXn[idx] + pK2[idx] / 2.0;
+  }
+
+  //
+  // Stage 3
+  //
+  Scatter( pXs );
+  EvalDerivatives( pXd );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pK3[idx] = pXd[idx] * hh;
+    pXs[idx] = pXn[idx] + pK3[idx];
+  }
+
+  //
+  // Advance clock another half step (for a complete step) for Stage 4
+  //
+  *pSimTime += h_half;
+
+  //
+  // Stage 4
+  //
+  Scatter( pXs );
+  EvalDerivatives( pXd );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pK4[idx] = pXd[idx] * hh;
+    pXs[idx] = pXn[idx] + pK1[idx] / 6.0 + pK2[idx] / 3.0 + pK3[idx] / 3.0 +
+                                                               pK4[idx] / 6.0;
+  }
+
+  Scatter( pXs );
+
+  //
+  // Restore the clock, the executive advances time
+  //
+  *pSimTime = tempSimTime;
+
+}  // end StepRK4()
+
+//############################################################################//
+//
+// Function: StepDP5()
+//
+// Purpose:  One Dormand-Prince 5(4) step of size hh from the current model
+//           states.  The fifth order solution is kept, the embedded fourth
+//           order solution gives the error estimate.
+//
+//############################################################################//
+double StateArena::StepDP5( double hh )
+{
+  int     idx;
+  double  tt      = *pSimTime;
+  double  errSum  = 0.0;
+  double  errNorm;
+  double  errIdx;
+  double  scale;
+
+  double *pXn = &xn[0];
+  double *pXs = &xs[0];
+  double *pD1 = &d1[0];
+  double *pD2 = &d2[0];
+  double *pD3 = &d3[0];
+  double *pD4 = &d4[0];
+  double *pD5 = &d5[0];
+  double *pD6 = &d6[0];
+  double *pD7 = &d7[0];
+
+  Gather( pXn );
+
+  //
+  // Stage 1
+  //
+  EvalDerivatives( pD1 );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * DP_A21 * pD1[idx];
+  }
+
+  //
+  // Stage 2
+  //
+  *pSimTime = tt + DP_C2 * hh;
+  Scatter( pXs );
+  EvalDerivatives( pD2 );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * ( DP_A31 * pD1[idx] + DP_A32 * pD2[idx] );
+  }
+
+  //
+  // Stage 3
+  //
+  *pSimTime = tt + DP_C3 * hh;
+  Scatter( pXs );
+  EvalDerivatives( pD3 );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * ( DP_A41 * pD1[idx] + DP_A42 * pD2[idx] +
+                                 DP_A43 * pD3[idx] );
+  }
+
+  //
+  // Stage 4
+  //
+  *pSimTime = tt + DP_C4 * hh;
+  Scatter( pXs );
+  EvalDerivatives( pD4 );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * ( DP_A51 * pD1[idx] + DP_A52 * pD2[idx] +
+                                 DP_A53 * pD3[idx] + DP_A54 * pD4[idx] );
+  }
+
+  //
+  // Stage 5
+  //
+  *pSimTime = tt + DP_C5 * hh;
+  Scatter( pXs );
+  EvalDerivatives( pD5 );
+
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * ( DP_A61 * pD1[idx] + DP_A62 * pD2[idx] +
+                                 DP_A63 * pD3[idx] + DP_A64 * pD4[idx] +
+                                 DP_A65 * pD5[idx] );
+  }
+
+  //
+  // Stage 6
+  //
+  *pSimTime = tt + hh;
+  Scatter( pXs );
+  EvalDerivatives( pD6 );
+
+  //
+  // Fifth order solution
+  //
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    pXs[idx] = pXn[idx] + hh * ( DP_B1 * pD1[idx] + DP_B3 * pD3[idx] +
+                                 DP_B4 * pD4[idx] + DP_B5 * pD5[idx] +
+                                 DP_B6 * pD6[idx] );
+  }
+
+  //
+  // Stage 7, derivative at the solution for the error estimate
+  //
+  Scatter( pXs );
+  EvalDerivatives( pD7 );
+
+  //
+  // Scaled RMS error norm
+  //
+  for ( idx = 0; idx < nStates; ++idx )
+  {
+    errIdx = hh * ( DP_E1 * pD1[idx] + DP_E3 * pD3[idx] + DP_E4 * pD4[idx] +
+                    DP_E5 * pD5[idx] + DP_E6 * pD6[idx] + DP_E7 * pD7[idx] );
+
+    scale = atol + rtol * std::max( fabs(pXn[idx]), fabs(pXs[idx]) );
+
+    errSum += ( errIdx / scale ) * ( errIdx / scale );
+  }
+
+  errNorm = sqrt( errSum / nStates );
+
+  if ( (errNorm > 1.0) && (hh > DP_MIN_STEP) )
+  {
+    //
+    // Reject, restore the step start
+    //
+    Scatter( pXn );
+    *pSimTime = tt;
+  }
+
+  return errNorm;
+
+}  // end StepDP5()
+
+//############################################################################//
+//
+// Function: Advance()
+//
+// Purpose:  Adaptive sub steps across the interval to the next executive
+//           event.  Sub steps are clipped to end exactly on the interval
+//           end, so frame updates see states at the frame time.
+//
+//############################################################################//
+void StateArena::Advance( double interval )
+{
+  int    idx;
+  double tStart = *pSimTime;
+  double tEnd   = tStart + interval;
+  double hh;
+  double errNorm;
+  double factor;
+  bool   clipped;
+  bool   accepted;
+
+  if ( nStates == 0 )
+  {
+    return;
+  }
+
+  while ( tEnd - *pSimTime > DP_MIN_STEP )
+  {
+    hh = nextStep;
+    clipped = false;
+
+    if ( hh >= tEnd - *pSimTime )
+    {
+      hh = tEnd - *pSimTime;
+      clipped = true;
+    }
+
+    errNorm  = StepDP5( hh );
+    accepted = ( errNorm <= 1.0 ) || ( hh <= DP_MIN_STEP );
+
+    //
+    // New step size from the error estimate
+    //
+    if ( errNorm == 0.0 )
+    {
+      factor = DP_MAX_SCALE;
+    }
+    else
+    {
+      factor = DP_SAFETY * pow( errNorm, -0.2 );
+      factor = std::min( DP_MAX_SCALE, std::max( DP_MIN_SCALE, factor ) );
+    }
+
+    if ( accepted && clipped )
+    {
+      //
+      // A step shortened to land on the event says nothing bad about the
+      // step size, keep the larger one.
+      //
+      nextStep = std::max( nextStep, hh * factor );
+    }
+    else
+    {
+      nextStep = hh * factor;
+    }
+
+    if ( accepted && (tEnd - *pSimTime > DP_MIN_STEP) )
+    {
+      //
+      // Update the models between sub steps, the same as the executive
+      // does between its steps.
+      //
+      for ( idx = 0; idx < allMdls.size(); ++idx )
+      {
+        allMdls[idx]->Update();
+      }
+    }
+  }
+
+  //
+  // Restore the clock, the executive advances time
+  //
+  *pSimTime = tStart;
+
+}  // end Advance()
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
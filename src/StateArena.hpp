@@ -0,0 +1,211 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       StateArena.hpp
+
+    \author     David Bruce
+
+    \brief      Contiguous state vector for all dynamic models.
+
+    The states each model registers with RegisterState() are gathered into
+    one contiguous array.  A single RK4 step then advances every model at
+    once.  The models keep their states as their own members, read by name
+    throughout the model code, so the arena does not own them: each stage
+    scatters the stage states out to the models and gathers the
+    derivatives back through the registered pointers.  Only the stage
+    arithmetic between those copies runs over the contiguous arrays.  All models see the stage states of all other models when their
+    derivatives are evaluated, so coupled models (missile and autopilot)
+    are integrated consistently within a step.
+
+    The arena also provides a Dormand-Prince 5(4) integrator with error
+    control.  Advance() covers an interval between executive events with
+    as many adaptive sub steps as the error tolerance needs.  Model Update()
+    is called between sub steps, the same as between executive steps.
+
+*/
+//############################################################################//
+
+#ifndef STATEARENA_HPP
+#define STATEARENA_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <vector>
+using std::vector;
+
+//
+// Forward declarations
+//
+class MdlBase;
+
+class StateArena
+{
+public:
+
+  typedef enum _integ_mode_
+  {
+    RK4_MODEL,      // 0 = RK4 run separately for each model, legacy
+    RK4_FUSED,      // 1 = One RK4 over the arena of all model states
+    DP5_ADAPTIVE    // 2 = Adaptive Dormand-Prince 5(4) over the arena
+  } IntegMode;
+
+//############################################################################//
+//
+// Function: StateArena()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+  StateArena();
+
+//############################################################################//
+//
+// Function: ~StateArena()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+  ~StateArena();
+
+//############################################################################//
+//
+// Function: Bind()
+//
+// Purpose:  Map the registered states of the integrating models into the
+//           arena.  Call once after all models are added.
+//
+//############################################################################//
+  void Bind( vector<MdlBase *> &mdlVec, double *pSimTime_ );
+
+//############################################################################//
+//
+// Function: StepRK4()
+//
+// Purpose:  Advance all model states one fused RK4 step
+//
+//############################################################################//
+  void StepRK4( double timeStep );
+
+//############################################################################//
+//
+// Function: Reset()
+//
+// Purpose:  Start a new run.  Sets the first adaptive step size and the
+//           error tolerances, and clears the derivative evaluation count.
+//
+//############################################################################//
+  void Reset( double initStep, double rtol_, double atol_ );
+
+//############################################################################//
+//
+// Function: Advance()
+//
+// Purpose:  Integrate all model states across interval with adaptive
+//           Dormand-Prince 5(4) sub steps.  Sim time is restored on return,
+//           the executive advances time.
+//
+//############################################################################//
+  void Advance( double interval );
+
+//############################################################################//
+//
+// Function: GetDerivEvals()
+//
+// Purpose:  Quantity of derivative evaluations of all models this run
+//
+//############################################################################//
+  long GetDerivEvals()
+  {
+    return nDerivEvals;
+  }
+
+//############################################################################//
+//
+// Function: Size()
+//
+// Purpose:  Quantity of states in the arena
+//
+//############################################################################//
+  int Size()
+  {
+    return nStates;
+  }
+
+private:
+
+//############################################################################//
+//
+// Function: Gather()
+//
+// Purpose:  Copy model states into the arena state array
+//
+//############################################################################//
+  void Gather( double *xx );
+
+//############################################################################//
+//
+// Function: Scatter()
+//
+// Purpose:  Copy the arena state array out to the model states
+//
+//############################################################################//
+  void Scatter( const double *xx );
+
+//############################################################################//
+//
+// Function: EvalDerivatives()
+//
+// Purpose:  Evaluate the derivatives of all models at the current model
+//           states and copy them into xd
+//
+//############################################################################//
+  void EvalDerivatives( double *xd );
+
+//############################################################################//
+//
+// Function: StepDP5()
+//
+// Purpose:  Attempt one Dormand-Prince 5(4) step.  Returns the scaled error
+//           norm.  The step is kept when the norm is not above one,
+//           otherwise the states and clock are restored.
+//
+//############################################################################//
+  double StepDP5( double hh );
+
+  vector<MdlBase *> allMdls;// na  All models, for Update() between sub steps
+  vector<MdlBase *> mdls;   // na  Integrating models
+  vector<double *> pState;  // na  Model state locations
+  vector<double *> pDeriv;  // na  Model derivative locations
+
+  vector<double> xn;        // na  States at the start of the step
+  vector<double> xs;        // na  Stage states
+  vector<double> xd;        // na  Stage derivatives
+  vector<double> k1;        // na  RK4 stage increments
+  vector<double> k2;        // na  RK4 stage increments
+  vector<double> k3;        // na  RK4 stage increments
+  vector<double> k4;        // na  RK4 stage increments
+
+  vector<double> d1;        // na  Dormand-Prince stage derivatives
+  vector<double> d2;        // na  Dormand-Prince stage derivatives
+  vector<double> d3;        // na  Dormand-Prince stage derivatives
+  vector<double> d4;        // na  Dormand-Prince stage derivatives
+  vector<double> d5;        // na  Dormand-Prince stage derivatives
+  vector<double> d6;        // na  Dormand-Prince stage derivatives
+  vector<double> d7;        // na  Dormand-Prince stage derivatives
+
+  int     nStates;          // na  Quantity of states
+  double *pSimTime;         // sec Simulation time
+
+  double  atol;             // na  Absolute error tolerance
+  double  rtol;             // na  Relative error tolerance
+  double  nextStep;         // sec Adaptive step size for the next sub step
+  long    nDerivEvals;      // na  Derivative evaluations of all models
+};
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -38,6 +38,7 @@
 //
 // Reference objects
 //
+#include "Random.hpp"
 #include "SimExec.hpp"
 
 
@@ -76,6 +77,23 @@ MdlBase()
   RegisterState( vxf, axf);
   RegisterState( vyf, ayf);
 
+  //
+  // Register output channels
+  //
+  RegisterChannel( "tgt.axb", "m/sec^2", axb );
+  RegisterChannel( "tgt.axf", "m/sec^2", axf );
+  RegisterChannel( "tgt.ayb", "m/sec^2", ayb );
+  RegisterChannel( "tgt.ayf", "m/sec^2", ayf );
+  RegisterChannel( "tgt.omega", "rad/sec", omega );
+  RegisterChannel( "tgt.pxf", "m", pxf );
+  RegisterChannel( "tgt.pyf", "m", pyf );
+  RegisterChannel( "tgt.theta", "rad", theta );
+  RegisterChannel( "tgt.vxb", "m/sec", vxb );
+  RegisterChannel( "tgt.vxf", "m/sec", vxf );
+  RegisterChannel( "tgt.vyb", "m/sec", vyb );
+  RegisterChannel( "tgt.vyf", "m/sec", vyf );
+  RegisterChannel( "tgt.weavePhase", "rad", weavePhase );
+
 }  // end Target()
 
 //############################################################################//
@@ -126,7 +144,7 @@ void Target::Initialize()
   pxf = -pExec->tFinal * vxf;
   pyf = -pExec->tFinal * vyf;
 
-  weavePhase = uniform( -PI, PI, &pExec->seed );
+  weavePhase = pRng->Uniform( -PI, PI );
 
 }  // End Initialize()
 
@@ -213,53 +231,6 @@ void Target::Finalize()
   simTime = GetSimTime();
 } 
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-void Target::Output( bool printHeader,
-                     FILE *pOutFile )
-{
-  simTime = GetSimTime();
-
-  if ( printHeader )
-  {
-    fprintf( pOutFile, "%20s", "tgt.axb" );
-    fprintf( pOutFile, "%20s", "tgt.axf" );
-    fprintf( pOutFile, "%20s", "tgt.ayb" );
-    fprintf( pOutFile, "%20s", "tgt.ayf" );
-    fprintf( pOutFile, "%20s", "tgt.omega" );
-    fprintf( pOutFile, "%20s", "tgt.pxf" );
-    fprintf( pOutFile, "%20s", "tgt.pyf" );
-    fprintf( pOutFile, "%20s", "tgt.theta" );
-    fprintf( pOutFile, "%20s", "tgt.vxb" );
-    fprintf( pOutFile, "%20s", "tgt.vxf" );
-    fprintf( pOutFile, "%20s", "tgt.vyb" );
-    fprintf( pOutFile, "%20s", "tgt.vyf" );
-    fprintf( pOutFile, "%20s", "tgt.weavePhase" );
-  }
-  else
-  {
-    fprintf(pOutFile, "%20.6e", axb);
-    fprintf(pOutFile, "%20.6e", axf);
-    fprintf(pOutFile, "%20.6e", ayb);
-    fprintf(pOutFile, "%20.6e", ayf);
-    fprintf(pOutFile, "%20.6e", omega);
-    fprintf(pOutFile, "%20.6e", pxf);
-    fprintf(pOutFile, "%20.6e", pyf);
-    fprintf(pOutFile, "%20.6e", theta);
-    fprintf(pOutFile, "%20.6e", vxb);
-    fprintf(pOutFile, "%20.6e", vxf);
-    fprintf(pOutFile, "%20.6e", vyb);
-    fprintf(pOutFile, "%20.6e", vyf);
-    fprintf(pOutFile, "%20.6e", weavePhase );
-
-  } // end if ( printHeader ) else
-}  // end Output()
-
 //############################################################################//
 //
 // Function: ResetAll()
@@ -273,6 +244,8 @@ void Target::ResetAll()
   axf       = 0.0;
   ayb       = 0.0;
   ayf       = 0.0;
+  jxf       = 0.0;
+  jyf       = 0.0;
   omega     = 0.0;
   pxf       = 0.0;
   pyf       = 0.0;
@@ -132,16 +132,6 @@ public:
 //############################################################################//
   virtual void Finalize();
 
-//############################################################################//
-//
-// Function: Output()
-//
-// Purpose:  Print selected variables
-//
-//############################################################################//
-  void Output( bool printHeader,
-             FILE *outfile );
-
 //############################################################################//
 //
 // Function: SetSimExec()
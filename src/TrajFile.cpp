@@ -0,0 +1,679 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajFile.cpp
+
+    \author     David Bruce
+
+    \brief      Run trajectory output file, fixed width text or binary
+                columns.
+
+*/
+//############################################################################//
+
+#include "TrajFile.hpp"
+#include "TrajSet.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//
+// File name extensions by TrajFile::OutFormat
+//
+static const char *FILE_EXT[] = { ".dat", ".trj", ".trj" };
+
+//############################################################################//
+//
+// Function: TrajFile()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+TrajFile::TrajFile()
+{
+  format       = TEXT_FMT;
+  pFile        = NULL;
+  pSet         = NULL;
+  setRun       = 0;
+  inHeader     = false;
+  col          = 0;
+  qtyRows      = 0;
+  slotSize     = 0;
+  qtySlots     = 1;
+  head         = 0;
+  tail         = 0;
+  qtyFull      = 0;
+  async        = false;
+  dropFull     = false;
+  stop         = false;
+  pBlock       = NULL;
+  qtyRowsTotal = 0;
+  qtyRowsOut   = 0;
+  qtyWaits     = 0;
+  qtyDropped   = 0;
+
+}  // end TrajFile()
+
+//############################################################################//
+//
+// Function: ~TrajFile()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+TrajFile::~TrajFile()
+{
+  Close();
+
+}  // end ~TrajFile()
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Create the file and start the header row
+//
+//############################################################################//
+bool TrajFile::Open( const char *filename,
+                     OutFormat   format_,
+                     int         queueBlocks,
+                     bool        dropFull_ )
+{
+  Close();
+
+  format = format_;
+
+  pFile = fopen( filename, ( format == TEXT_FMT ) ? "w" : "wb" );
+
+  Start( queueBlocks, dropFull_ );
+
+  return pFile != NULL;
+
+}  // end Open()
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Start a run of a run set container and its header row
+//
+//############################################################################//
+bool TrajFile::Open( TrajSet &set,
+                     int      run,
+                     int      queueBlocks,
+                     bool     dropFull_ )
+{
+  Close();
+
+  format = set.Format();
+  pSet   = &set;
+  setRun = run;
+
+  Start( queueBlocks, dropFull_ );
+
+  return true;
+
+}  // end Open()
+
+//############################################################################//
+//
+// Function: Start()
+//
+// Purpose:  Reset the row capture and the writer statistics of a new file
+//
+//############################################################################//
+void TrajFile::Start( int  queueBlocks,
+                      bool dropFull_ )
+{
+  inHeader     = true;
+  col          = 0;
+  qtyRows      = 0;
+  qtyRowsTotal = 0;
+  qtyRowsOut   = 0;
+  qtyWaits     = 0;
+  qtyDropped   = 0;
+
+  //
+  // The writer needs a block to write while the sim fills another
+  //
+  async    = ( queueBlocks > 0 );
+  qtySlots = async ? std::max( queueBlocks, 2 ) : 1;
+  dropFull = dropFull_;
+
+  channels.clear();
+
+}  // end Start()
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Write the last block, stop the writer thread and close the file
+//
+//############################################################################//
+void TrajFile::Close()
+{
+  if ( !IsOpen() )
+  {
+    return;
+  }
+
+  if ( inHeader )
+  {
+    //
+    // Nothing was captured
+    //
+  }
+  else if ( async )
+  {
+    if ( qtyRows > 0 )
+    {
+      PassBlock( true );
+    }
+
+    {
+      std::lock_guard<std::mutex> lock( ringMutex );
+
+      stop = true;
+    }
+
+    fullCond.notify_one();
+
+    writer.join();
+  }
+  else if ( qtyRows > 0 )
+  {
+    WriteBlock( pBlock, qtyRows );
+  }
+
+  if ( pSet != NULL )
+  {
+    pSet->AddRun( setRun, qtyRowsOut, channels, colBytes );
+
+    pSet = NULL;
+  }
+  else
+  {
+    fclose( pFile );
+
+    pFile = NULL;
+  }
+
+}  // end Close()
+
+//############################################################################//
+//
+// Function: Header()
+//
+// Purpose:  Name the next channel of the header row
+//
+//############################################################################//
+void TrajFile::Header( const char *name,
+                       const char *units,
+                       uint8_t     flags )
+{
+  Channel chan;
+
+  chan.name  = name;
+  chan.units = units;
+  chan.flags = flags;
+
+  channels.push_back( chan );
+
+}  // end Header()
+
+//############################################################################//
+//
+// Function: Value()
+//
+// Purpose:  Give the value of the next channel of a data row
+//
+//############################################################################//
+void TrajFile::Value( double value )
+{
+  pBlock[col * TRAJ_BLOCK_ROWS + qtyRows] = value;
+
+  ++col;
+
+}  // end Value()
+
+void TrajFile::Value( int value )
+{
+  pBlock[col * TRAJ_BLOCK_ROWS + qtyRows] = value;
+
+  ++col;
+
+}  // end Value()
+
+//############################################################################//
+//
+// Function: EndRow()
+//
+// Purpose:  Close the header row or a data row
+//
+//############################################################################//
+void TrajFile::EndRow()
+{
+  if ( inHeader )
+  {
+    if ( pSet == NULL )
+    {
+      WriteHeader();
+    }
+    else
+    {
+      colBytes.assign( channels.size(), vector<unsigned char>() );
+    }
+
+    slotSize = channels.size() * TRAJ_BLOCK_ROWS;
+
+    ring.assign( qtySlots * slotSize, 0.0 );
+    slotRows.assign( qtySlots, 0 );
+    block32.assign( TRAJ_BLOCK_ROWS, 0.0f );
+    blockInt.assign( TRAJ_BLOCK_ROWS, 0 );
+
+    head    = 0;
+    tail    = 0;
+    qtyFull = 0;
+    stop    = false;
+    pBlock  = &ring[0];
+
+    if ( async )
+    {
+      writer = std::thread( &TrajFile::WriterThread, this );
+    }
+  }
+  else
+  {
+    ++qtyRows;
+    ++qtyRowsTotal;
+
+    if ( qtyRows == TRAJ_BLOCK_ROWS )
+    {
+      if ( async )
+      {
+        PassBlock( false );
+      }
+      else
+      {
+        WriteBlock( pBlock, qtyRows );
+
+        qtyRows = 0;
+      }
+    }
+  }
+
+  inHeader = false;
+  col      = 0;
+
+}  // end EndRow()
+
+//############################################################################//
+//
+// Function: PassBlock()
+//
+// Purpose:  Pass the filled block to the writer and take the next free one.
+//           A full ring drops the block when allowed, otherwise waits.
+//
+//############################################################################//
+void TrajFile::PassBlock( bool mustWrite )
+{
+  {
+    std::unique_lock<std::mutex> lock( ringMutex );
+
+    if ( (qtyFull == qtySlots - 1) && dropFull && !mustWrite )
+    {
+      qtyDropped += qtyRows;
+      qtyRows     = 0;
+
+      return;
+    }
+
+    slotRows[head] = qtyRows;
+    ++qtyFull;
+
+    fullCond.notify_one();
+
+    if ( qtyFull == qtySlots )
+    {
+      ++qtyWaits;
+
+      while ( qtyFull == qtySlots )
+      {
+        freeCond.wait( lock );
+      }
+    }
+
+    head = ( head + 1 ) % qtySlots;
+  }
+
+  pBlock  = &ring[head * slotSize];
+  qtyRows = 0;
+
+}  // end PassBlock()
+
+//############################################################################//
+//
+// Function: WriterThread()
+//
+// Purpose:  Write the filled blocks of the ring until stopped
+//
+//############################################################################//
+void TrajFile::WriterThread()
+{
+  int rows;
+
+  while ( true )
+  {
+    {
+      std::unique_lock<std::mutex> lock( ringMutex );
+
+      while ( (qtyFull == 0) && !stop )
+      {
+        fullCond.wait( lock );
+      }
+
+      if ( qtyFull == 0 )
+      {
+        return;
+      }
+
+      rows = slotRows[tail];
+    }
+
+    WriteBlock( &ring[tail * slotSize], rows );
+
+    {
+      std::lock_guard<std::mutex> lock( ringMutex );
+
+      tail = ( tail + 1 ) % qtySlots;
+      --qtyFull;
+    }
+
+    freeCond.notify_one();
+  }
+
+}  // end WriterThread()
+
+//############################################################################//
+//
+// Function: WriteHeader()
+//
+// Purpose:  Write the header line of the text table, or the binary file
+//           header and channel table
+//
+//############################################################################//
+void TrajFile::WriteHeader()
+{
+  int idx;
+
+  if ( format == TEXT_FMT )
+  {
+    for ( idx = 0; idx < channels.size(); ++idx )
+    {
+      fprintf( pFile, "%20s", channels[idx].name.c_str() );
+    }
+    fprintf( pFile, "\n" );
+
+    return;
+  }
+
+  fwrite( TRAJ_MAGIC, 1, sizeof(TRAJ_MAGIC), pFile );
+
+  PutU32( TRAJ_VERSION );
+  PutU32( channels.size() );
+  PutU32( ( format == BIN32_FMT ) ? 4 : 8 );
+  PutU32( TRAJ_BLOCK_ROWS );
+
+  for ( idx = 0; idx < channels.size(); ++idx )
+  {
+    PutU8( channels[idx].flags );
+    PutU8( channels[idx].name.size() );
+    fwrite( channels[idx].name.data(), 1, channels[idx].name.size(), pFile );
+    PutU8( channels[idx].units.size() );
+    fwrite( channels[idx].units.data(), 1, channels[idx].units.size(), pFile );
+  }
+
+}  // end WriteHeader()
+
+//############################################################################//
+//
+// Function: WriteBlock()
+//
+// Purpose:  Write the rows of a column block, as text rows or channel by
+//           channel
+//
+//############################################################################//
+void TrajFile::WriteBlock( const double *pBlock_,
+                           int           rows )
+{
+  int           chan;
+  int           row;
+  const double *pCol;
+
+  qtyRowsOut += rows;
+
+  if ( format == TEXT_FMT )
+  {
+    for ( row = 0; row < rows; ++row )
+    {
+      for ( chan = 0; chan < channels.size(); ++chan )
+      {
+        if ( channels[chan].flags & TRAJ_INTEGER )
+        {
+          fprintf( pFile, "%20d", static_cast<int>(
+                   pBlock_[chan * TRAJ_BLOCK_ROWS + row] ) );
+        }
+        else
+        {
+          fprintf( pFile, "%20.6e", pBlock_[chan * TRAJ_BLOCK_ROWS + row] );
+        }
+      }
+      fprintf( pFile, "\n" );
+    }
+
+    return;
+  }
+
+  if ( pSet == NULL )
+  {
+    PutU32( rows );
+  }
+
+  for ( chan = 0; chan < channels.size(); ++chan )
+  {
+    pCol = &pBlock_[chan * TRAJ_BLOCK_ROWS];
+
+    if ( channels[chan].flags & TRAJ_INTEGER )
+    {
+      for ( row = 0; row < rows; ++row )
+      {
+        blockInt[row] = static_cast<int32_t>( lround( pCol[row] ) );
+      }
+
+      PutColumn( chan, &blockInt[0], rows * 4, 4 );
+    }
+    else if ( format == BIN32_FMT )
+    {
+      for ( row = 0; row < rows; ++row )
+      {
+        block32[row] = static_cast<float>( pCol[row] );
+      }
+
+      PutColumn( chan, &block32[0], rows * 4, 4 );
+    }
+    else
+    {
+      PutColumn( chan, pCol, rows * 8, 8 );
+    }
+  }
+
+}  // end WriteBlock()
+
+//############################################################################//
+//
+// Function: PutU8(), PutU32(), PutBytes()
+//
+// Purpose:  Little endian writes
+//
+//############################################################################//
+void TrajFile::PutU8( uint8_t value )
+{
+  fwrite( &value, 1, 1, pFile );
+}
+
+void TrajFile::PutU32( uint32_t value )
+{
+  PutBytes( &value, 4, 4 );
+}
+
+void TrajFile::PutBytes( const void *pData,
+                         size_t      qtyBytes,
+                         size_t      elemBytes )
+{
+  size_t               idx;
+  size_t               jdx;
+  const unsigned char *pSrc = static_cast<const unsigned char *>( pData );
+  unsigned char        swap[8];
+
+  if ( HostLittleEndian() )
+  {
+    fwrite( pData, 1, qtyBytes, pFile );
+
+    return;
+  }
+
+  for ( idx = 0; idx < qtyBytes; idx += elemBytes )
+  {
+    for ( jdx = 0; jdx < elemBytes; ++jdx )
+    {
+      swap[jdx] = pSrc[idx + elemBytes - 1 - jdx];
+    }
+
+    fwrite( swap, 1, elemBytes, pFile );
+  }
+
+}  // end PutBytes()
+
+//############################################################################//
+//
+// Function: PutColumn()
+//
+// Purpose:  Write a column of a block to the file, or add it to the
+//           channel's column of a run set run
+//
+//############################################################################//
+void TrajFile::PutColumn( int         chan,
+                          const void *pData,
+                          size_t      qtyBytes,
+                          size_t      elemBytes )
+{
+  size_t                       idx;
+  size_t                       start;
+  const unsigned char         *pSrc = static_cast<const unsigned char *>( pData );
+  vector<unsigned char>       &dst  = colBytes[chan];
+
+  if ( pSet == NULL )
+  {
+    PutBytes( pData, qtyBytes, elemBytes );
+
+    return;
+  }
+
+  start = dst.size();
+
+  dst.insert( dst.end(), pSrc, pSrc + qtyBytes );
+
+  if ( !HostLittleEndian() )
+  {
+    for ( idx = start; idx < dst.size(); idx += elemBytes )
+    {
+      std::reverse( dst.begin() + idx, dst.begin() + idx + elemBytes );
+    }
+  }
+
+}  // end PutColumn()
+
+//############################################################################//
+//
+// Function: FileExt()
+//
+// Purpose:  File name extension of a format
+//
+//############################################################################//
+const char *TrajFile::FileExt( OutFormat format_ )
+{
+  return FILE_EXT[format_];
+
+}  // end FileExt()
+
+//############################################################################//
+//
+// Function: HostLittleEndian()
+//
+// Purpose:  Byte order of the host
+//
+//############################################################################//
+bool TrajFile::HostLittleEndian()
+{
+  const uint16_t one = 1;
+
+  return *reinterpret_cast<const unsigned char *>( &one ) == 1;
+
+}  // end HostLittleEndian()
+
+//############################################################################//
+//
+// Function: GlobMatch()
+//
+// Purpose:  Match a name to a '*' and '?' glob pattern.  A '*' backtracks
+//           to the last star only, which is enough for a match anywhere in
+//           the rest of the name.
+//
+//############################################################################//
+bool TrajFile::GlobMatch( const char *pattern,
+                          const char *name )
+{
+  const char *pStar = NULL;
+  const char *pMark = NULL;
+
+  while ( *name != '\0' )
+  {
+    if ( (*pattern == '?') || (*pattern == *name) )
+    {
+      ++pattern;
+      ++name;
+    }
+    else if ( *pattern == '*' )
+    {
+      pStar = pattern++;
+      pMark = name;
+    }
+    else if ( pStar != NULL )
+    {
+      pattern = pStar + 1;
+      name    = ++pMark;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  while ( *pattern == '*' )
+  {
+    ++pattern;
+  }
+
+  return *pattern == '\0';
+
+}  // end GlobMatch()
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,333 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajFile.hpp
+
+    \author     David Bruce
+
+    \brief      Run trajectory output file, fixed width text or binary
+                columns.
+
+    The executive and the models write one row per output event.  The
+    first row is the header: each channel is named with Header() along with
+    its units.  Every following row gives the channel values with Value(),
+    in the same order.  EndRow() closes a row.
+
+    The text format is the legacy table, one %20.6e column per channel
+    under a %20s header line.  The binary format is self-describing and
+    column major, 8 or 4 bytes a value against 20 characters, and formats
+    nothing in the sim:
+
+      File header
+        char     magic[8]     "P3DTRAJ" and a nul
+        uint32   version      TRAJ_VERSION
+        uint32   qtyChannels  Quantity of channels
+        uint32   elemBytes    8 for float64 values, 4 for float32
+        uint32   blockRows    Rows in a full column block
+      Channel table, one entry per channel in column order
+        uint8    flags        TRAJ_INTEGER set for integer valued channels
+        uint8    nameLen      Length of the name
+        char     name[nameLen]
+        uint8    unitLen      Length of the units
+        char     units[unitLen]
+      Column blocks, to the end of the file
+        uint32   rows         Rows in the block, 1 to blockRows
+        column   values       Each channel's rows in turn, int32 for an
+                              integer channel, otherwise float64 or float32
+                              as elemBytes gives
+
+    Everything is little endian.  The trajTool converter turns a binary
+    file back into the text table.
+
+    Rows of either format are captured into column blocks of blockRows
+    rows, and a block is written when it fills, the last, partial block
+    when the file is closed.  With a queue of blocks given to Open(), the
+    blocks form a preallocated ring drained to disk by a writer thread, so
+    the sim only copies values.  When the ring is full the sim waits for
+    the writer, or with dropFull set discards the block, and the waits and
+    dropped rows are counted.  With no queue the blocks are written on the
+    calling thread.
+
+    A run of a run set container, see TrajSet.hpp, keeps its binary
+    columns in memory instead and adds them to the container at Close().
+
+*/
+//############################################################################//
+
+#ifndef TRAJFILE_HPP
+#define TRAJFILE_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using std::string;
+using std::vector;
+
+class TrajSet;
+
+//
+// Binary format identification
+//
+const char     TRAJ_MAGIC[8]   = { 'P', '3', 'D', 'T', 'R', 'A', 'J', '\0' };
+const uint32_t TRAJ_VERSION    = 1;
+const uint32_t TRAJ_BLOCK_ROWS = 256;
+
+//
+// Channel flags
+//
+const uint8_t  TRAJ_INTEGER    = 0x01;
+
+class TrajFile
+{
+public:
+
+  //
+  // File format selection
+  //
+  typedef enum _out_format_
+  {
+    TEXT_FMT,       // 0 = Fixed width text table, legacy
+    BIN64_FMT,      // 1 = Binary float64 columns
+    BIN32_FMT       // 2 = Binary float32 columns
+  } OutFormat;
+
+  //
+  // Description of one channel
+  //
+  typedef struct _channel_
+  {
+    string  name;           // na  Channel name, model prefix included
+    string  units;          // na  Channel units
+    uint8_t flags;          // na  TRAJ_ flags
+  } Channel;
+
+//############################################################################//
+//
+// Function: TrajFile()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+  TrajFile();
+
+//############################################################################//
+//
+// Function: ~TrajFile()
+//
+// Purpose:  Destructor.  Closes the file if open.
+//
+//############################################################################//
+  ~TrajFile();
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Create the file.  Returns false if it cannot be created.
+//           queueBlocks above zero gives the depth of the block ring of
+//           the writer thread, and dropFull discards blocks rather than
+//           waiting when the ring is full.
+//
+//############################################################################//
+  bool Open( const char *filename,
+             OutFormat   format_,
+             int         queueBlocks = 0,
+             bool        dropFull = false );
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Start a run of a run set container.  The run's columns are
+//           kept until Close() adds them to the container.
+//
+//############################################################################//
+  bool Open( TrajSet &set,
+             int      run,
+             int      queueBlocks = 0,
+             bool     dropFull = false );
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Write the last block, stop the writer thread and close the
+//           file
+//
+//############################################################################//
+  void Close();
+
+  bool IsOpen() const { return (pFile != NULL) || (pSet != NULL); }
+
+  //
+  // Writer statistics of the last file opened
+  //
+  long Rows()    const { return qtyRowsTotal; }
+  long Waits()   const { return qtyWaits; }
+  long Dropped() const { return qtyDropped; }
+
+//############################################################################//
+//
+// Function: Header()
+//
+// Purpose:  Name the next channel of the header row
+//
+//############################################################################//
+  void Header( const char *name,
+               const char *units,
+               uint8_t     flags = 0 );
+
+//############################################################################//
+//
+// Function: Value()
+//
+// Purpose:  Give the value of the next channel of a data row.  Integer
+//           values are for channels flagged TRAJ_INTEGER.
+//
+//############################################################################//
+  void Value( double value );
+
+  void Value( int value );
+
+//############################################################################//
+//
+// Function: EndRow()
+//
+// Purpose:  Close the header row or a data row
+//
+//############################################################################//
+  void EndRow();
+
+//############################################################################//
+//
+// Function: FileExt()
+//
+// Purpose:  File name extension of a format
+//
+//############################################################################//
+  static const char *FileExt( OutFormat format_ );
+
+//############################################################################//
+//
+// Function: HostLittleEndian()
+//
+// Purpose:  True on little endian hosts, where the binary format needs no
+//           byte swapping.
+//
+//############################################################################//
+  static bool HostLittleEndian();
+
+//############################################################################//
+//
+// Function: GlobMatch()
+//
+// Purpose:  Match a channel name to a pattern where '*' matches any run of
+//           characters and '?' any one character
+//
+//############################################################################//
+  static bool GlobMatch( const char *pattern, const char *name );
+
+private:
+
+//############################################################################//
+//
+// Function: Start()
+//
+// Purpose:  Reset the row capture and the writer statistics of a new file
+//
+//############################################################################//
+  void Start( int queueBlocks, bool dropFull_ );
+
+//############################################################################//
+//
+// Function: WriteHeader()
+//
+// Purpose:  Write the binary file header and channel table
+//
+//############################################################################//
+  void WriteHeader();
+
+//############################################################################//
+//
+// Function: WriteBlock()
+//
+// Purpose:  Write the rows of a column block
+//
+//############################################################################//
+  void WriteBlock( const double *pBlock_, int rows );
+
+//############################################################################//
+//
+// Function: PassBlock()
+//
+// Purpose:  Pass the filled block to the writer and take the next free one
+//
+//############################################################################//
+  void PassBlock( bool mustWrite );
+
+//############################################################################//
+//
+// Function: WriterThread()
+//
+// Purpose:  Write the filled blocks of the ring until stopped
+//
+//############################################################################//
+  void WriterThread();
+
+  void PutU8( uint8_t value );
+
+  void PutU32( uint32_t value );
+
+  void PutBytes( const void *pData, size_t qtyBytes, size_t elemBytes );
+
+  void PutColumn( int chan, const void *pData, size_t qtyBytes,
+                  size_t elemBytes );
+
+  OutFormat        format;      // na  File format
+  FILE            *pFile;       // na  Output file
+  TrajSet         *pSet;        // na  Run set container, or NULL
+  int              setRun;      // na  Run number in the run set container
+  bool             inHeader;    // na  Flag that the header row is open
+  int              col;         // na  Next channel of the open row
+  int              qtyRows;     // na  Rows in the block being filled
+  int              slotSize;    // na  Values in a block of the ring
+  int              qtySlots;    // na  Blocks in the ring
+  int              head;        // na  Ring block being filled
+  int              tail;        // na  Next ring block to write
+  int              qtyFull;     // na  Ring blocks passed to the writer
+  bool             async;       // na  Flag that a writer thread is used
+  bool             dropFull;    // na  Flag to drop blocks on a full ring
+  bool             stop;        // na  Flag directing the writer to stop
+  double          *pBlock;      // na  Block being filled
+  long             qtyRowsTotal;// na  Rows captured into the file
+  long             qtyRowsOut;  // na  Rows written, less those dropped
+  long             qtyWaits;    // na  Waits for a free ring block
+  long             qtyDropped;  // na  Rows dropped on a full ring
+
+  vector<Channel>  channels;    // na  Channel table
+  vector<double>   ring;        // na  Ring of column blocks, channel major
+  vector<int>      slotRows;    // na  Rows of each passed ring block
+  vector<float>    block32;     // na  float32 staging of a column
+  vector<int32_t>  blockInt;    // na  int32 staging of a column
+
+  vector< vector<unsigned char> > colBytes; // na  Run set run columns
+
+  std::thread             writer;    // na  Writer thread
+  std::mutex              ringMutex; // na  Guards the ring indexes
+  std::condition_variable fullCond;  // na  Signals a block to write
+  std::condition_variable freeCond;  // na  Signals a written block
+};
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,254 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajSet.cpp
+
+    \author     David Bruce
+
+    \brief      Run set trajectory container, every run of a Monte Carlo set
+                in one indexed binary file.
+
+*/
+//############################################################################//
+
+#include "TrajSet.hpp"
+
+//
+// C/C++ includes and namespaces
+//
+#include <algorithm>
+
+//
+// Index order
+//
+static bool RunLess( const TrajSet::RunEntry &aa,
+                     const TrajSet::RunEntry &bb )
+{
+  return aa.run < bb.run;
+}
+
+//############################################################################//
+//
+// Function: TrajSet()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+TrajSet::TrajSet()
+{
+  format = TrajFile::BIN64_FMT;
+  pFile  = NULL;
+  offset = 0;
+
+}  // end TrajSet()
+
+//############################################################################//
+//
+// Function: ~TrajSet()
+//
+// Purpose:  Destructor
+//
+//############################################################################//
+TrajSet::~TrajSet()
+{
+  Close();
+
+}  // end ~TrajSet()
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Create the container and write a header with no index
+//
+//############################################################################//
+bool TrajSet::Open( const char          *filename,
+                    TrajFile::OutFormat  format_ )
+{
+  Close();
+
+  format = ( format_ == TrajFile::BIN32_FMT ) ? TrajFile::BIN32_FMT :
+                                                TrajFile::BIN64_FMT;
+
+  pFile = fopen( filename, "wb" );
+
+  if ( pFile == NULL )
+  {
+    return false;
+  }
+
+  channels.clear();
+  index.clear();
+
+  fwrite( TRAJ_SET_MAGIC, 1, sizeof(TRAJ_SET_MAGIC), pFile );
+
+  PutU32( TRAJ_VERSION );
+  PutU32( ( format == TrajFile::BIN32_FMT ) ? 4 : 8 );
+  PutU32( 0 );
+  PutU32( 0 );
+  PutU64( 0 );
+
+  offset = TRAJ_SET_HEADER_BYTES;
+
+  return true;
+
+}  // end Open()
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Write the channel table and the run index, then point the
+//           header at them
+//
+//############################################################################//
+void TrajSet::Close()
+{
+  int      idx;
+  uint64_t indexOffset;
+
+  if ( pFile == NULL )
+  {
+    return;
+  }
+
+  std::sort( index.begin(), index.end(), RunLess );
+
+  indexOffset = offset;
+
+  for ( idx = 0; idx < channels.size(); ++idx )
+  {
+    fputc( channels[idx].flags, pFile );
+    fputc( channels[idx].name.size(), pFile );
+    fwrite( channels[idx].name.data(), 1, channels[idx].name.size(), pFile );
+    fputc( channels[idx].units.size(), pFile );
+    fwrite( channels[idx].units.data(), 1, channels[idx].units.size(), pFile );
+  }
+
+  for ( idx = 0; idx < index.size(); ++idx )
+  {
+    PutU32( static_cast<uint32_t>( index[idx].run ) );
+    PutU32( index[idx].rows );
+    PutU64( index[idx].offset );
+    PutU64( index[idx].bytes );
+  }
+
+  //
+  // Run and channel counts, then the index offset
+  //
+  fseek( pFile, 16, SEEK_SET );
+
+  PutU32( index.size() );
+  PutU32( channels.size() );
+  PutU64( indexOffset );
+
+  fclose( pFile );
+
+  pFile = NULL;
+
+}  // end Close()
+
+//############################################################################//
+//
+// Function: AddRun()
+//
+// Purpose:  Append the columns of a run and index it
+//
+//############################################################################//
+void TrajSet::AddRun( int                                    run,
+                      long                                   rows,
+                      const vector<TrajFile::Channel>       &chans,
+                      const vector< vector<unsigned char> > &colBytes )
+{
+  int           chan;
+  uint32_t      elemBytes;
+  uint64_t      padded;
+  RunEntry      entry;
+  unsigned char zeros[8] = { 0 };
+
+  std::lock_guard<std::mutex> lock( setMutex );
+
+  if ( pFile == NULL )
+  {
+    return;
+  }
+
+  if ( channels.empty() )
+  {
+    channels = chans;
+  }
+
+  elemBytes = ( format == TrajFile::BIN32_FMT ) ? 4 : 8;
+
+  entry.run    = run;
+  entry.rows   = static_cast<uint32_t>( rows );
+  entry.offset = offset;
+  entry.bytes  = 0;
+
+  for ( chan = 0; chan < colBytes.size(); ++chan )
+  {
+    padded = ColumnBytes( chans[chan], entry.rows, elemBytes );
+
+    fwrite( colBytes[chan].data(), 1, colBytes[chan].size(), pFile );
+    fwrite( zeros, 1, padded - colBytes[chan].size(), pFile );
+
+    entry.bytes += padded;
+  }
+
+  offset += entry.bytes;
+
+  index.push_back( entry );
+
+}  // end AddRun()
+
+//############################################################################//
+//
+// Function: ColumnBytes()
+//
+// Purpose:  Size of a channel column of a run, padded to 8 bytes
+//
+//############################################################################//
+uint64_t TrajSet::ColumnBytes( const TrajFile::Channel &chan,
+                               uint32_t                 rows,
+                               uint32_t                 elemBytes )
+{
+  uint64_t bytes;
+
+  bytes = static_cast<uint64_t>( rows ) *
+          ( ( chan.flags & TRAJ_INTEGER ) ? 4 : elemBytes );
+
+  return ( bytes + 7 ) & ~static_cast<uint64_t>( 7 );
+
+}  // end ColumnBytes()
+
+//############################################################################//
+//
+// Function: PutU32(), PutU64()
+//
+// Purpose:  Little endian writes
+//
+//############################################################################//
+void TrajSet::PutU32( uint32_t value )
+{
+  int idx;
+
+  for ( idx = 0; idx < 4; ++idx )
+  {
+    fputc( ( value >> ( 8 * idx ) ) & 0xff, pFile );
+  }
+}
+
+void TrajSet::PutU64( uint64_t value )
+{
+  int idx;
+
+  for ( idx = 0; idx < 8; ++idx )
+  {
+    fputc( ( value >> ( 8 * idx ) ) & 0xff, pFile );
+  }
+}
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
@@ -0,0 +1,170 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       TrajSet.hpp
+
+    \author     David Bruce
+
+    \brief      Run set trajectory container, every run of a Monte Carlo set
+                in one indexed binary file.
+
+    The runs of a set are written to one file instead of a file per run.
+    A run's rows are kept by its TrajFile and added whole when the run
+    ends, so runs made concurrently do not interleave.  Each run is stored
+    channel by channel, each channel's column of the run contiguous, so a
+    reader can map any column of any run straight from the file.  The run
+    index at the end of the file gives every run's place:
+
+      File header
+        char     magic[8]     "P3DTSET" and a nul
+        uint32   version      TRAJ_VERSION
+        uint32   elemBytes    8 for float64 values, 4 for float32
+        uint32   qtyRuns      Quantity of runs in the index
+        uint32   qtyChannels  Quantity of channels
+        uint64   indexOffset  Offset of the index, 0 until the set closes
+      Run data, in the order the runs ended
+        column   values       Each channel's rows in turn, int32 for an
+                              integer channel, otherwise float64 or float32
+                              as elemBytes gives, each column padded with
+                              zeros to a multiple of 8 bytes
+      Index at indexOffset
+        Channel table, as in a .trj file
+        Run table, qtyRuns entries in run order
+          int32  run          Run number
+          uint32 rows         Rows of the run
+          uint64 offset       Offset of the run data
+          uint64 bytes        Size of the run data
+
+    Everything is little endian and every run starts on an 8 byte
+    boundary.
+
+*/
+//############################################################################//
+
+#ifndef TRAJSET_HPP
+#define TRAJSET_HPP
+
+//
+// C/C++ includes and namespaces
+//
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+using std::vector;
+
+//
+// Sim includes
+//
+#include "TrajFile.hpp"
+
+//
+// Container identification
+//
+const char TRAJ_SET_MAGIC[8] = { 'P', '3', 'D', 'T', 'S', 'E', 'T', '\0' };
+
+//
+// Size of the file header
+//
+const uint32_t TRAJ_SET_HEADER_BYTES = 32;
+
+class TrajSet
+{
+public:
+
+  //
+  // Run index entry
+  //
+  typedef struct _run_entry_
+  {
+    int32_t  run;           // na  Run number
+    uint32_t rows;          // na  Rows of the run
+    uint64_t offset;        // na  Offset of the run data in the file
+    uint64_t bytes;         // na  Size of the run data
+  } RunEntry;
+
+//############################################################################//
+//
+// Function: TrajSet()
+//
+// Purpose:  Constructor
+//
+//############################################################################//
+  TrajSet();
+
+//############################################################################//
+//
+// Function: ~TrajSet()
+//
+// Purpose:  Destructor.  Closes the file if open.
+//
+//############################################################################//
+  ~TrajSet();
+
+//############################################################################//
+//
+// Function: Open()
+//
+// Purpose:  Create the container.  A text format is kept as float64.
+//           Returns false if the file cannot be created.
+//
+//############################################################################//
+  bool Open( const char *filename, TrajFile::OutFormat format_ );
+
+//############################################################################//
+//
+// Function: Close()
+//
+// Purpose:  Write the index and close the file
+//
+//############################################################################//
+  void Close();
+
+  bool IsOpen() const { return pFile != NULL; }
+
+  TrajFile::OutFormat Format() const { return format; }
+
+//############################################################################//
+//
+// Function: AddRun()
+//
+// Purpose:  Append the columns of a run.  Called by TrajFile::Close() from
+//           any thread.
+//
+//############################################################################//
+  void AddRun( int                                    run,
+               long                                   rows,
+               const vector<TrajFile::Channel>       &chans,
+               const vector< vector<unsigned char> > &colBytes );
+
+//############################################################################//
+//
+// Function: ColumnBytes()
+//
+// Purpose:  Size of a channel column of a run in the file, padding included
+//
+//############################################################################//
+  static uint64_t ColumnBytes( const TrajFile::Channel &chan,
+                               uint32_t                 rows,
+                               uint32_t                 elemBytes );
+
+private:
+
+  void PutU32( uint32_t value );
+
+  void PutU64( uint64_t value );
+
+  TrajFile::OutFormat       format;    // na  Value format
+  FILE                     *pFile;     // na  Container file
+  uint64_t                  offset;    // na  Size of the file written
+  vector<TrajFile::Channel> channels;  // na  Channel table of the runs
+  vector<RunEntry>          index;     // na  Run index
+  std::mutex                setMutex;  // na  Guards the file and index
+};
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
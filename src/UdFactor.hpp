@@ -0,0 +1,290 @@
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
+/**
+    \file       UdFactor.hpp
+
+    \author     David Bruce
+
+    \brief      UD factorized covariance propagation and update
+
+    The estimation covariance is carried as P = U * D * U', U unit upper
+    triangular and D diagonal, instead of as P itself.  The time update is
+    Thornton's modified weighted Gram-Schmidt orthogonalization of
+    [ phi * U | G ] weighted by diag( D, q ), and the measurement update is
+    Bierman's, one scalar measurement at a time.  Neither forms P, so D stays
+    nonnegative and P symmetric positive semidefinite by construction, which
+    is what lets the filters run in single precision when the inverse range
+    state is small.  Correlated measurements are decorrelated by the caller
+    with the Cholesky factor of R.
+
+    The filters select the form with CovForm.  All functions are templates
+    on the dimensions and the element type of the matrices.
+
+*/
+//############################################################################//
+
+#ifndef UDFACTOR_HPP
+#define UDFACTOR_HPP
+
+#include "Mat.hpp"
+
+namespace UD_FACTOR
+{
+
+//
+// Covariance form selection
+//
+typedef enum COVFORM
+{
+  cfNULL = 0,
+  cfJOSEPH,
+  cfUD
+}CovForm;
+
+//############################################################################//
+//
+// Function: Factor()
+//
+// Purpose:  Factor a symmetric positive semidefinite PP = UU * DD * UU',
+//           reading the upper triangle.  Returns false if PP is not
+//           positive semidefinite, with the negative pivots zeroed.
+//
+//############################################################################//
+template <int N, class T>
+inline bool Factor( const Mat<N,N,T> &PP,
+                    Mat<N,N,T>       &UU,
+                    Mat<N,1,T>       &DD )
+{
+  Mat<N,N,T> work( PP );
+  bool       psd(true);
+
+  UU = 0.0;
+
+  for ( int col = N - 1; col >= 0; --col )
+  {
+    T dd = work[col][col];
+
+    UU[col][col] = 1.0;
+
+    if ( dd > 0.0 )
+    {
+      DD(col) = dd;
+
+      for ( int row = 0; row < col; ++row )
+      {
+        UU[row][col] = work[row][col] / dd;
+      }
+
+      for ( int row = 0; row < col; ++row )
+      {
+        T scale = UU[row][col] * dd;
+
+        for ( int kk = 0; kk <= row; ++kk )
+        {
+          work[kk][row] -= UU[kk][col] * scale;
+        }
+      }
+    }
+    else
+    {
+      psd = psd && ( dd == 0.0 );
+      DD(col) = 0.0;
+    }
+  }
+
+  return psd;
+}
+
+//############################################################################//
+//
+// Function: Compose()
+//
+// Purpose:  PP = UU * DD * UU'
+//
+//############################################################################//
+template <int N, class T>
+inline void Compose( const Mat<N,N,T> &UU,
+                     const Mat<N,1,T> &DD,
+                     Mat<N,N,T>       &PP )
+{
+  for ( int col = 0; col < N; ++col )
+  {
+    for ( int row = 0; row <= col; ++row )
+    {
+      T sum( UU[row][col] * DD(col) );
+
+      for ( int kk = col + 1; kk < N; ++kk )
+      {
+        sum += UU[row][kk] * DD(kk) * UU[col][kk];
+      }
+
+      PP[row][col] = sum;
+      PP[col][row] = sum;
+    }
+  }
+}
+
+//############################################################################//
+//
+// Function: TimeUpdate()
+//
+// Purpose:  Propagate the factors through P = W * diag(DW) * W', with
+//           W = [ phi * U | G ] and DW = [ D; q ], G * diag(q) * G' the
+//           process noise.  The rows of WW are orthogonalized in place.
+//
+//############################################################################//
+template <int N, int L, class T>
+inline void TimeUpdate( Mat<N,L,T>       &WW,
+                        const Mat<L,1,T> &DW,
+                        Mat<N,N,T>       &UU,
+                        Mat<N,1,T>       &DD )
+{
+  Mat<L,1,T> dw;
+
+  UU = 0.0;
+
+  for ( int row = N - 1; row >= 0; --row )
+  {
+    T sum(0.0);
+
+    for ( int kk = 0; kk < L; ++kk )
+    {
+      dw(kk) = DW(kk) * WW[row][kk];
+      sum += WW[row][kk] * dw(kk);
+    }
+
+    DD(row) = sum;
+    UU[row][row] = 1.0;
+
+    if ( sum > 0.0 )
+    {
+      T invSum = 1.0 / sum;
+
+      for ( int above = 0; above < row; ++above )
+      {
+        T uu(0.0);
+
+        for ( int kk = 0; kk < L; ++kk )
+        {
+          uu += WW[above][kk] * dw(kk);
+        }
+        uu *= invSum;
+
+        UU[above][row] = uu;
+
+        for ( int kk = 0; kk < L; ++kk )
+        {
+          WW[above][kk] -= uu * WW[row][kk];
+        }
+      }
+    }
+    else
+    {
+      DD(row) = 0.0;
+    }
+  }
+}
+
+//############################################################################//
+//
+// Function: MeasUpdate()
+//
+// Purpose:  Update the factors with one scalar measurement z = hh' * x + v,
+//           var(v) = rr, returning the Kalman gain.  The caller updates the
+//           state, x += gain * ( z - hh' * x ).  Returns false, leaving the
+//           factors unchanged, if the innovation variance is not positive.
+//
+//############################################################################//
+template <int N, class T>
+inline bool MeasUpdate( const Mat<N,1,T> &hh,
+                        T                 rr,
+                        Mat<N,N,T>       &UU,
+                        Mat<N,1,T>       &DD,
+                        Mat<N,1,T>       &gain )
+{
+  Mat<N,1,T> ff;
+  Mat<N,1,T> vv;
+  T          alpha(rr);
+
+  //
+  // ff = U' * h, vv = D * ff
+  //
+  for ( int col = 0; col < N; ++col )
+  {
+    T sum( hh(col) );
+
+    for ( int kk = 0; kk < col; ++kk )
+    {
+      sum += UU[kk][col] * hh(kk);
+    }
+
+    ff(col) = sum;
+    vv(col) = DD(col) * sum;
+    alpha += sum * vv(col);
+  }
+
+  if ( !(alpha > 0.0) )
+  {
+    return false;
+  }
+
+  alpha = rr;
+
+  for ( int col = 0; col < N; ++col )
+  {
+    T alphaPrior = alpha;
+    T lambda     = -ff(col) / alphaPrior;
+
+    alpha += ff(col) * vv(col);
+
+    DD(col) *= alphaPrior / alpha;
+
+    gain(col) = vv(col);
+
+    for ( int row = 0; row < col; ++row )
+    {
+      T uu = UU[row][col];
+
+      UU[row][col] = uu + gain(row) * lambda;
+      gain(row) += uu * vv(col);
+    }
+  }
+
+  for ( int row = 0; row < N; ++row )
+  {
+    gain(row) /= alpha;
+  }
+
+  return true;
+}
+
+//############################################################################//
+//
+// Function: TimeUpdateFlops(), MeasUpdateFlops(), ComposeFlops()
+//
+// Purpose:  Multiplies plus adds of the functions above.
+//
+//############################################################################//
+inline int TimeUpdateFlops( int nn, int ll )
+{
+  return 3 * ll * nn + ( 4 * ll + 1 ) * nn * ( nn - 1 ) / 2 + nn;
+}
+
+inline int MeasUpdateFlops( int nn )
+{
+  return nn * ( nn - 1 ) + 3 * nn + 5 * nn + 2 * nn * ( nn - 1 ) + nn;
+}
+
+inline int ComposeFlops( int nn )
+{
+  return nn * ( nn + 1 ) * ( nn + 2 ) / 2 - nn * ( nn + 1 ) / 2;
+}
+
+} // end namespace UD_FACTOR
+
+#endif
+
+//############################################################################//
+//                                UNCLASSIFIED                                //
+//############################################################################//
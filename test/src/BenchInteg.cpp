@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// BenchInteg.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BenchInteg.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//
+// Heap allocation counter.  Every operator new in the program is counted so
+// the allocations made inside the timed loops can be reported.
+//
+static long allocCnt = 0;
+
+void *operator new( std::size_t size )
+{
+  void *ptr;
+
+  ++allocCnt;
+
+  ptr = malloc( size == 0 ? 1 : size );
+  if ( ptr == NULL )
+  {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void operator delete( void *ptr ) noexcept
+{
+  free( ptr );
+}
+
+void operator delete( void *ptr, std::size_t ) noexcept
+{
+  free( ptr );
+}
+
+BenchMdl::BenchMdl() :
+MdlBase()
+{
+  int idx;
+
+  for ( idx = 0; idx < QTY_STATES; ++idx )
+  {
+    RegisterState( xx[idx], xd[idx] );
+  }
+
+  Reset();
+}
+
+void BenchMdl::Reset()
+{
+  int idx;
+
+  for ( idx = 0; idx < QTY_STATES; ++idx )
+  {
+    xx[idx] = 0.0;
+    xd[idx] = 0.0;
+  }
+
+  input = 1.0;
+  tau   = 0.2;
+}
+
+void BenchMdl::UpdateDerivatives()
+{
+  int idx;
+
+  xd[0] = ( input - xx[0] ) / tau;
+
+  for ( idx = 1; idx < QTY_STATES; ++idx )
+  {
+    xd[idx] = ( xx[idx-1] - xx[idx] ) / tau;
+  }
+}
+
+LegacyInteg::LegacyInteg( MdlBase *pMdl_ )
+{
+  pMdl = pMdl_;
+
+  pMdl->GetStates( m_state );
+  pMdl->GetDerivatives( m_deriv );
+
+  initComp = false;
+}
+
+void LegacyInteg::SetStates( std::vector<double *> &states )
+{
+  for (unsigned int i = 0; i < states.size();  ++i)
+  {
+    *m_state[i] = *states[i];
+  }
+}
+
+void LegacyInteg::Integrate( double &timeStep )
+{
+  double hh = timeStep;
+  double h_half = hh / 2.0;
+  double tempSimTime = *pMdl->pSimTime;
+
+  std::vector<double *> pDeriv;
+  std::vector<double *> pState;
+
+  GetStates( pState );
+
+  if ( !initComp )
+  {
+    initComp = true;
+
+    xn.insert( xn.end(), pState.size(), 0.0 );
+    k1.insert( k1.end(), pState.size(), 0.0 );
+    k2.insert( k2.end(), pState.size(), 0.0 );
+    k3.insert( k3.end(), pState.size(), 0.0 );
+    k4.insert( k4.end(), pState.size(), 0.0 );
+  }
+
+  for( unsigned int idx = 0; idx < pState.size(); ++idx )
+  {
+     xn[idx] = *pState[idx];
+  }
+
+  pMdl->UpdateDerivatives();
+  GetDerivatives( pDeriv );
+
+  for( unsigned int idx = 0; idx < pDeriv.size(); ++idx )
+  {
+    k1[idx] = *pDeriv[idx] * hh;
+    *pState[idx] = xn[idx] + k1[idx] / 2.0;
+  }
+
+  *pMdl->pSimTime += h_half;
+
+  SetStates(pState);
+  pMdl->UpdateDerivatives();
+  GetDerivatives(pDeriv);
+
+  for( unsigned int idx = 0; idx < pDeriv.size(); ++idx )
+  {
+    k2[idx] = *pDeriv[idx] * hh;
+    *pState[idx] = xn[idx] + k2[idx]/2.0;
+  }
+
+  SetStates(pState);
+  pMdl->UpdateDerivatives();
+  GetDerivatives(pDeriv);
+
+  for(unsigned int idx = 0; idx < pDeriv.size(); ++idx)
+  {
+    k3[idx] = *pDeriv[idx]*hh;
+    *pState[idx] = xn[idx] + k3[idx];
+  }
+
+  *pMdl->pSimTime += h_half;
+
+  SetStates(pState);
+  pMdl->UpdateDerivatives();
+  GetDerivatives(pDeriv);
+
+  for(unsigned int idx = 0; idx < pDeriv.size(); ++idx)
+  {
+    k4[idx] = *pDeriv[idx]*hh;
+    *pState[idx] = xn[idx] + k1[idx]/6.0 + k2[idx]/3.0 + k3[idx]/3.0 +
+                                                               k4[idx]/6.0;
+  }
+  SetStates(pState);
+
+  *pMdl->pSimTime = tempSimTime;
+}
+
+void BenchInteg::Execute(int argc, char *argv[])
+{
+  int    qtySteps(200000);
+  int    idx;
+  int    jdx;
+  long   allocStart;
+  long   allocLegacy;
+  long   allocNew;
+  double dt(1.0e-3);
+  double secLegacy;
+  double secNew;
+  double xxLegacy[BenchMdl::QTY_STATES];
+  bool   match(true);
+
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point finish;
+
+  if ( argc == 2 )
+  {
+    if ( strcmp("-h", argv[1]) == 0 )
+    {
+      Help();
+      return;
+    }
+
+    qtySteps = atoi( argv[1] );
+  }
+  else if ( argc > 2 )
+  {
+    Help();
+    return;
+  }
+
+  simTime = 0.0;
+  mdl.SetSimTime( &simTime );
+
+  //
+  // Original algorithm
+  //
+  LegacyInteg legacy( &mdl );
+
+  mdl.Reset();
+  legacy.Integrate( dt );
+  mdl.Reset();
+
+  allocStart = allocCnt;
+  start = std::chrono::steady_clock::now();
+
+  for ( idx = 0; idx < qtySteps; ++idx )
+  {
+    legacy.Integrate( dt );
+  }
+
+  finish = std::chrono::steady_clock::now();
+  allocLegacy = allocCnt - allocStart;
+  secLegacy = std::chrono::duration<double>( finish - start ).count();
+
+  for ( jdx = 0; jdx < BenchMdl::QTY_STATES; ++jdx )
+  {
+    xxLegacy[jdx] = mdl.xx[jdx];
+  }
+
+  //
+  // MdlBase::Integrate()
+  //
+  mdl.Reset();
+
+  allocStart = allocCnt;
+  start = std::chrono::steady_clock::now();
+
+  for ( idx = 0; idx < qtySteps; ++idx )
+  {
+    mdl.Integrate( dt );
+  }
+
+  finish = std::chrono::steady_clock::now();
+  allocNew = allocCnt - allocStart;
+  secNew = std::chrono::duration<double>( finish - start ).count();
+
+  for ( jdx = 0; jdx < BenchMdl::QTY_STATES; ++jdx )
+  {
+    if ( xxLegacy[jdx] != mdl.xx[jdx] )
+    {
+      match = false;
+    }
+  }
+
+  printf("\n");
+  printf("RK4 integrator benchmark, %d states, %d steps\n\n",
+         BenchMdl::QTY_STATES, qtySteps);
+  printf("%-24s %14s %14s\n", "integrator", "steps/sec", "allocs/step");
+  printf("%-24s %14.0f %14.3f\n", "legacy (copying)",
+         qtySteps / secLegacy, static_cast<double>(allocLegacy) / qtySteps);
+  printf("%-24s %14.0f %14.3f\n", "MdlBase::Integrate",
+         qtySteps / secNew, static_cast<double>(allocNew) / qtySteps);
+  printf("\n");
+  printf("speedup            %8.2f\n", secLegacy / secNew);
+  printf("states bit exact   %8s\n", match ? "yes" : "no");
+  printf("\n");
+
+  if ( !match || (allocNew != 0) )
+  {
+    exit(1);
+  }
+}
+
+void BenchInteg::Help()
+{
+  printf("Usage: \n");
+  printf("'benchInteg -h'         Returns this usage help. \n");
+  printf("'benchInteg'            Runs the benchmark, 200000 steps. \n");
+  printf("'benchInteg steps'      Runs the benchmark with the given steps. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
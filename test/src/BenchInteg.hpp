@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// BenchInteg.hpp
+//
+// Overview:
+//  Benchmark of the MdlBase RK4 integrator against the original
+//  implementation, which copied the state and derivative pointer vectors
+//  into local containers on every step.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHINTEG_HPP
+#define BENCHINTEG_HPP
+
+#include "MdlBase.hpp"
+
+#include <vector>
+
+//
+// Chain of first order lags, the same shape as the sim's dynamic models.
+//
+class BenchMdl : public MdlBase
+{
+public:
+
+  static const int QTY_STATES = 11;
+
+  BenchMdl();
+
+  ~BenchMdl()
+  {}
+
+  void Reset();
+
+  virtual void UpdateDerivatives();
+
+  double xx[QTY_STATES];
+  double xd[QTY_STATES];
+  double input;
+  double tau;
+};
+
+//
+// Replica of the original MdlBase::Integrate() algorithm
+//
+class LegacyInteg
+{
+public:
+
+  LegacyInteg( MdlBase *pMdl_ );
+
+  void Integrate( double &timeStep );
+
+private:
+
+  void GetStates( std::vector<double *> &states )
+  { states = m_state; }
+
+  void GetDerivatives( std::vector<double *> &derivs )
+  { derivs = m_deriv; }
+
+  void SetStates( std::vector<double *> &states );
+
+  MdlBase *pMdl;
+
+  std::vector<double *> m_state;
+  std::vector<double *> m_deriv;
+
+  std::vector<double> xn;
+  std::vector<double> k1;
+  std::vector<double> k2;
+  std::vector<double> k3;
+  std::vector<double> k4;
+
+  bool initComp;
+};
+
+class BenchInteg
+{
+public:
+
+  BenchInteg()
+  {}
+
+  ~BenchInteg()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  BenchMdl mdl;
+
+  double simTime;
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressCov.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressCov.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "MathUtils.hpp"
+
+using namespace MATRIX;
+
+//
+// Multiplies plus adds of the UD form, see MscEkf::PropagateUd() and
+// UpdateUd().  As for MSC_COV::UpdateFlops(), the factoring of the
+// measurement covariance, which stands in for the gain solve, is left out.
+//
+static int UdPropFlops()
+{
+  int flops(0);
+
+  for ( int row = 0; row < 6; ++row )
+  {
+    for ( int nz = 0; nz < MSC_COV::PHI_NNZ[row]; ++nz )
+    {
+      flops += 2 * ( 6 - MSC_COV::PHI_COLS[row][nz] );
+    }
+  }
+
+  return flops + UD_FACTOR::TimeUpdateFlops( 6, 8 );
+}
+
+static int UdUpdateFlops()
+{
+  int flops(0);
+
+  for ( int meas = 0; meas < 3; ++meas )
+  {
+    flops += 3 + 2 * ( meas + 1 );              // decorrelated residual
+    flops += UD_FACTOR::MeasUpdateFlops( 6 );
+    flops += 2 * 6;                             // state
+  }
+
+  return flops + UD_FACTOR::ComposeFlops( 6 );
+}
+
+//
+// Measurements of a target closing from 20 km at 600 m/s and weaving across
+// the LOS, with deterministic noise at the filter's sigmas.
+//
+void RegressCov::Measure( int frame, double deltaTime, Mat<3,1> &measVec )
+{
+  double rng;
+  double time(frame * deltaTime);
+
+  rng = 20000.0 - 600.0 * time;
+
+  measVec(0) = 0.1 + 0.002 * time + 0.01 * sin( 0.5 * time ) +
+               1.0e-3 * sin( 12.9898 * frame );
+  measVec(1) = 1.0 / ( rng + 10.0 * sin( 78.233 * frame ) );
+  measVec(2) = ( -600.0 + sin( 37.719 * frame ) ) * measVec(1);
+}
+
+//
+// Accumulate the largest covariance and state differences from the
+// reference, normalized by the reference standard deviations.
+//
+template <class Filter>
+void RegressCov::Compare( const RefFilter &ref, const Filter &filter,
+                          double &errP, double &errX )
+{
+  int    col;
+  int    row;
+  double scale;
+
+  for ( row = 0; row < 6; ++row )
+  {
+    for ( col = 0; col < 6; ++col )
+    {
+      scale = sqrt( ref.ekf.PP[row][row] * ref.ekf.PP[col][col] );
+      errP = fmax( errP,
+                   fabs( filter.ekf.PP[row][col] - ref.ekf.PP[row][col] ) /
+                   scale );
+    }
+
+    scale = sqrt( ref.ekf.PP[row][row] );
+    errX = fmax( errX, fabs( filter.ekf.mscState(row) -
+                             ref.ekf.mscState(row) ) / scale );
+  }
+}
+
+//
+// Filter the engagement, returning the run time in seconds.
+//
+template <class Filter>
+double RegressCov::Run( Filter &filter, int qtyFrames, double deltaTime )
+{
+  Mat<3,1> measVec;
+  int      frame;
+
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point finish;
+
+  start = std::chrono::steady_clock::now();
+
+  Measure( 0, deltaTime, measVec );
+  filter.Reset( measVec );
+
+  for ( frame = 1; frame < qtyFrames; ++frame )
+  {
+    Measure( frame, deltaTime, measVec );
+    filter.Frame( measVec, deltaTime );
+  }
+
+  finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double>( finish - start ).count();
+}
+
+void RegressCov::Execute(int argc, char *argv[])
+{
+  int       qtyFrames(1500);
+  int       qtyRuns(200);
+  int       col;
+  int       frame;
+  int       idx;
+  int       row;
+  double    deltaTime(1.0 / 64.0);
+  double    errK(0.0);
+  double    errP(0.0);
+  double    errPjf(0.0);
+  double    errPud(0.0);
+  double    errPudf(0.0);
+  double    errX(0.0);
+  double    errXjf(0.0);
+  double    errXud(0.0);
+  double    errXudf(0.0);
+  double    scale;
+  double    secDense(0.0);
+  double    secSparse(0.0);
+  double    secUd(0.0);
+  double    tol(1.0e-9);
+  double    tolFloat(1.0e-3);
+  double    tolFloatX(0.25);
+  bool      posDef(true);
+  bool      posDefJf(true);
+  bool      posDefUdf(true);
+  Mat<3,1>  measVec;
+
+  RefFilter                                  dense;
+  CovFilter<double, MSC_COV::SymmetricSparse> sparse;
+  CovFilter<double, MSC_COV::SymmetricSparse> ud( UD_FACTOR::cfUD );
+  CovFilter<float, MSC_COV::SymmetricSparse>  josephFloat;
+  CovFilter<float, MSC_COV::SymmetricSparse>  udFloat( UD_FACTOR::cfUD );
+
+  if ( argc == 2 )
+  {
+    if ( strcmp("-h", argv[1]) == 0 )
+    {
+      Help();
+      return;
+    }
+
+    qtyRuns = atoi( argv[1] );
+  }
+  else if ( argc > 2 )
+  {
+    Help();
+    return;
+  }
+
+  //
+  // Filter every way in lock step, comparing every frame with the dense
+  // reference.  Covariance differences are normalized by the standard
+  // deviations, gain differences by the largest gain for the measurement and
+  // state differences by the state standard deviations.
+  //
+  Measure( 0, deltaTime, measVec );
+  dense.Reset( measVec );
+  sparse.Reset( measVec );
+  ud.Reset( measVec );
+  josephFloat.Reset( measVec );
+  udFloat.Reset( measVec );
+
+  for ( frame = 1; frame < qtyFrames; ++frame )
+  {
+    Measure( frame, deltaTime, measVec );
+
+    posDef = posDef && dense.Frame( measVec, deltaTime );
+    posDef = posDef && sparse.Frame( measVec, deltaTime );
+    posDef = posDef && ud.Frame( measVec, deltaTime );
+    posDefJf = josephFloat.Frame( measVec, deltaTime ) && posDefJf;
+    posDefUdf = udFloat.Frame( measVec, deltaTime ) && posDefUdf;
+
+    Compare( dense, sparse, errP, errX );
+    Compare( dense, ud, errPud, errXud );
+    Compare( dense, josephFloat, errPjf, errXjf );
+    Compare( dense, udFloat, errPudf, errXudf );
+
+    for ( col = 0; col < 3; ++col )
+    {
+      scale = 1.0e-300;
+      for ( row = 0; row < 6; ++row )
+      {
+        scale = fmax( scale, fabs( dense.ekf.KK[row][col] ) );
+      }
+
+      for ( row = 0; row < 6; ++row )
+      {
+        errK = fmax( errK,
+                     fabs( sparse.ekf.KK[row][col] - dense.ekf.KK[row][col] ) / scale );
+      }
+    }
+
+    for ( row = 0; row < 6; ++row )
+    {
+      posDefJf = posDefJf && ( josephFloat.ekf.PP[row][row] > 0.0f );
+      posDefUdf = posDefUdf && ( udFloat.ekf.DD(row) > 0.0f );
+    }
+  }
+
+  //
+  // Timing
+  //
+  for ( idx = 0; idx < qtyRuns; ++idx )
+  {
+    secDense += Run( dense, qtyFrames, deltaTime );
+    secSparse += Run( sparse, qtyFrames, deltaTime );
+    secUd += Run( ud, qtyFrames, deltaTime );
+  }
+
+  printf("\n");
+  printf("MSC covariance regression, %d frames, %d timed runs\n\n",
+         qtyFrames, qtyRuns);
+  printf("%-10s %14s %14s %14s\n", "path", "prop flops", "update flops",
+         "frames/sec");
+  printf("%-10s %14d %14d %14.0f\n", "dense",
+         MSC_COV::PropFlops( false ), MSC_COV::UpdateFlops( false ),
+         static_cast<double>(qtyRuns) * qtyFrames / secDense);
+  printf("%-10s %14d %14d %14.0f\n", "sparse",
+         MSC_COV::PropFlops( true ), MSC_COV::UpdateFlops( true ),
+         static_cast<double>(qtyRuns) * qtyFrames / secSparse);
+  printf("%-10s %14d %14d %14.0f\n", "ud",
+         UdPropFlops(), UdUpdateFlops(),
+         static_cast<double>(qtyRuns) * qtyFrames / secUd);
+  printf("\n");
+  printf("flop reduction      %8.2f\n",
+         static_cast<double>( MSC_COV::PropFlops( false ) +
+                              MSC_COV::UpdateFlops( false ) ) /
+                            ( MSC_COV::PropFlops( true ) +
+                              MSC_COV::UpdateFlops( true ) ));
+  printf("speedup             %8.2f\n", secDense / secSparse);
+  printf("max P diff / sigma  %8.1e\n", errP);
+  printf("max K diff / max K  %8.1e\n", errK);
+  printf("max x diff / sigma  %8.1e\n", errX);
+  printf("\n");
+  printf("%-18s %12s %12s %8s\n", "vs dense double", "P / sigma",
+         "x / sigma", "pos def");
+  printf("%-18s %12.1e %12.1e %8s\n", "ud double", errPud, errXud,
+         posDef ? "yes" : "no");
+  printf("%-18s %12.1e %12.1e %8s\n", "joseph float", errPjf, errXjf,
+         posDefJf ? "yes" : "no");
+  printf("%-18s %12.1e %12.1e %8s\n", "ud float", errPudf, errXudf,
+         posDefUdf ? "yes" : "no");
+  printf("\n");
+
+  if ( !posDef || (errP > tol) || (errK > tol) || (errX > tol) ||
+       (errPud > tol) || (errXud > tol) )
+  {
+    printf("FAIL  tolerance %.1e\n\n", tol);
+    exit(1);
+  }
+
+  //
+  // In single precision the states round at the 1e-7 relative level in the
+  // cartesian integration, so the estimate is only required to stay well
+  // inside its standard deviation.
+  //
+  if ( !posDefUdf || (errPudf > tolFloat) || (errXudf > tolFloatX) )
+  {
+    printf("FAIL  single precision UD tolerance %.1e, x %.2f\n\n",
+           tolFloat, tolFloatX);
+    exit(1);
+  }
+}
+
+void RegressCov::Help()
+{
+  printf("Usage: \n");
+  printf("'regressCov -h'         Returns this usage help. \n");
+  printf("'regressCov'            Runs the regression, 200 timed runs. \n");
+  printf("'regressCov runs'       Runs the regression with the given timed runs. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressCov.hpp
+//
+// Overview:
+//  Regression of the structure exploiting MSC covariance propagation and
+//  update, MSC_COV::SymmetricSparse, against the dense matrix forms,
+//  MSC_COV::Dense, in the MscEkf core.  A closing engagement is filtered
+//  both ways and the covariance, gains and estimates are compared.  The UD
+//  factorized form, UD_FACTOR::cfUD, is checked against the same reference
+//  in double precision, and both forms are run in single precision.
+//  Reports the flops per frame of each path and the measured speedup.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REGRESSCOV_HPP
+#define REGRESSCOV_HPP
+
+#include "MscEkf.hpp"
+
+//
+// The MSC filter core with the measurement sigmas of the regression
+//
+template <class Scalar, class CovPolicy>
+class CovFilter
+{
+public:
+
+  CovFilter( UD_FACTOR::CovForm covForm = UD_FACTOR::cfJOSEPH ) :
+  angSig(1.0e-3),
+  rDotSig(1.0),
+  rngSig(10.0)
+  {
+    ekf.covForm = covForm;
+  }
+
+  //
+  // Initialize the filter from the first measurement.
+  //
+  void Reset( const Mat<3,1> &measVec )
+  {
+    ekf.Reset();
+    SetMeas( measVec );
+    ekf.Initialize( measVec(2) / measVec(1), angSig, rngSig, rDotSig );
+  }
+
+  //
+  // Propagate to the measurement and update, the FcTse6 filter cycle.
+  //
+  bool Frame( const Mat<3,1> &measVec, double deltaTime )
+  {
+    SetMeas( measVec );
+    ekf.Propagate( deltaTime );
+    return ekf.Update( angSig, rngSig, rDotSig );
+  }
+
+  void SetMeas( const Mat<3,1> &measVec )
+  {
+    for ( int idx = 0; idx < 3; ++idx )
+    {
+      ekf.measVec(idx) = measVec(idx);
+    }
+  }
+
+  Scalar   angSig;
+  Scalar   rDotSig;
+  Scalar   rngSig;
+
+  MscEkf<Scalar, CovPolicy> ekf;
+};
+
+typedef CovFilter<double, MSC_COV::Dense> RefFilter;
+
+class RegressCov
+{
+public:
+
+  RegressCov()
+  {}
+
+  ~RegressCov()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  template <class Filter>
+  void Compare( const RefFilter &ref, const Filter &filter,
+                double &errP, double &errX );
+
+  void Measure( int frame, double deltaTime, Mat<3,1> &measVec );
+
+  template <class Filter>
+  double Run( Filter &filter, int qtyFrames, double deltaTime );
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
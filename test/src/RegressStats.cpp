@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressStats.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "MathUtils.hpp"
+#include "Random.hpp"
+
+//
+// Largest rank error of the percentile estimates of the sketch as a
+// fraction of the sample size.  The true rank of an estimate is the span
+// of ranks its value has in the sorted sample.
+//
+double RegressStats::CheckRanks( const QuantileSketch &sketch,
+                                 const vector<double> &sorted )
+{
+  int    idx;
+  double nn( static_cast<double>( sorted.size() ) );
+  double est;
+  double hiRank;
+  double loRank;
+  double qq;
+  double target;
+  double worst(0.0);
+
+  for ( idx = 1; idx < 1000; ++idx )
+  {
+    qq     = idx / 1000.0;
+    target = ceil( qq * nn );
+    est    = sketch.Quantile( qq );
+
+    loRank = std::lower_bound( sorted.begin(), sorted.end(), est ) -
+             sorted.begin() + 1;
+    hiRank = std::upper_bound( sorted.begin(), sorted.end(), est ) -
+             sorted.begin();
+
+    if ( target < loRank )
+    {
+      worst = fmax( worst, ( loRank - target ) / nn );
+    }
+    else if ( target > hiRank )
+    {
+      worst = fmax( worst, ( target - hiRank ) / nn );
+    }
+  }
+
+  return worst;
+}
+
+//
+// Quantity of percentiles of small sets where the exact value of the
+// sorted set differs from the sketch.  The sets are smaller than a
+// compactor, so the sketch holds every value and must give the same rank.
+// The set sizes make p * n fractional for the miss percentiles.
+//
+int RegressStats::CheckSmallSets()
+{
+  int    idx;
+  int    jdx;
+  int    kdx;
+  int    mismatch(0);
+  int    sizes[4] = { 2, 6, 21, 999 };
+  double pct[4]   = { 0.2, 0.35, 0.5, 0.7 };
+  Random rng;
+
+  rng.Seed( -24680 );
+
+  for ( idx = 0; idx < 4; ++idx )
+  {
+    QuantileSketch sketch;
+    vector<double> sorted( sizes[idx] );
+
+    for ( jdx = 0; jdx < sizes[idx]; ++jdx )
+    {
+      sorted[jdx] = rng.Uniform( 0.0, 1.0 );
+      sketch.Add( sorted[jdx] );
+    }
+
+    std::sort( sorted.begin(), sorted.end() );
+
+    for ( kdx = 0; kdx < 4; ++kdx )
+    {
+      if ( SortedQuantile( sorted, pct[kdx] ) != sketch.Quantile( pct[kdx] ) )
+      {
+        ++mismatch;
+      }
+    }
+  }
+
+  return mismatch;
+}
+
+void RegressStats::Execute(int argc, char *argv[])
+{
+  int    idx;
+  int    mismatch(0);
+  int    part;
+  int    qtyParts(8);
+  int    qtySamples(1000000);
+  double errMerged;
+  double errSingle;
+  double errMean;
+  double errStd;
+  double mean(0.0);
+  double miss;
+  double nn;
+  double secSketch(0.0);
+  double secSort(0.0);
+  double stdDev(0.0);
+  double tol(1.0e-9);
+  Random rng;
+
+  std::chrono::steady_clock::time_point start;
+
+  if ( argc == 2 )
+  {
+    if ( strcmp("-h", argv[1]) == 0 )
+    {
+      Help();
+      return;
+    }
+
+    qtySamples = atoi( argv[1] );
+  }
+  else if ( argc > 2 )
+  {
+    Help();
+    return;
+  }
+
+  //
+  // Rayleigh misses with a one percent flyer tail
+  //
+  vector<double> sample( qtySamples );
+
+  rng.Seed( -13579 );
+
+  for ( idx = 0; idx < qtySamples; ++idx )
+  {
+    miss = 0.05 * sqrt( SQ( rng.Gaussian( 0.0, 1.0 ) ) +
+                        SQ( rng.Gaussian( 0.0, 1.0 ) ) );
+
+    if ( rng.Uniform( 0.0, 1.0 ) < 0.01 )
+    {
+      miss = rng.Uniform( 10.0, 1000.0 );
+    }
+
+    sample[idx] = miss;
+  }
+
+  nn = static_cast<double>( qtySamples );
+
+  //
+  // Streamed into one sketch, and in parts into separate sketches and
+  // accumulators that are then merged
+  //
+  QuantileSketch         single;
+  QuantileSketch         merged;
+  vector<QuantileSketch> parts( qtyParts );
+  Welford                stream;
+  Welford                mergedStats;
+  vector<Welford>        partStats( qtyParts );
+
+  start = std::chrono::steady_clock::now();
+
+  for ( idx = 0; idx < qtySamples; ++idx )
+  {
+    single.Add( sample[idx] );
+  }
+
+  secSketch = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start ).count();
+
+  for ( idx = 0; idx < qtySamples; ++idx )
+  {
+    stream.Add( sample[idx] );
+
+    part = static_cast<long long>( idx ) * qtyParts / qtySamples;
+
+    parts[part].Add( sample[idx] );
+    partStats[part].Add( sample[idx] );
+  }
+
+  for ( part = 0; part < qtyParts; ++part )
+  {
+    merged.Merge( parts[part] );
+    mergedStats.Merge( partStats[part] );
+  }
+
+  //
+  // Exact statistics
+  //
+  for ( idx = 0; idx < qtySamples; ++idx )
+  {
+    mean += sample[idx];
+  }
+  mean /= nn;
+
+  for ( idx = 0; idx < qtySamples; ++idx )
+  {
+    stdDev += SQ( sample[idx] - mean );
+  }
+  stdDev = sqrt( stdDev / ( nn - 1.0 ) );
+
+  start = std::chrono::steady_clock::now();
+
+  std::sort( sample.begin(), sample.end() );
+
+  secSort = std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - start ).count();
+
+  errSingle = CheckRanks( single, sample );
+  errMerged = CheckRanks( merged, sample );
+
+  errMean = fmax( fabs( stream.Mean() - mean ),
+                  fabs( mergedStats.Mean() - mean ) ) / stdDev;
+  errStd  = fmax( fabs( stream.StdDev() - stdDev ),
+                  fabs( mergedStats.StdDev() - stdDev ) ) / stdDev;
+
+  printf("\n");
+  printf("Run set statistics regression, %d samples, %d merged parts\n\n",
+         qtySamples, qtyParts);
+  printf("%-10s %10s %12s %12s\n", "sketch", "retained", "rank bound",
+         "rank error");
+  printf("%-10s %10d %12.2e %12.2e\n", "single", single.Retained(),
+         single.RankError(), errSingle);
+  printf("%-10s %10d %12.2e %12.2e\n", "merged", merged.Retained(),
+         merged.RankError(), errMerged);
+  printf("\n");
+  printf("%-10s %10s %10s %10s\n", "", "exact", "single", "merged");
+  printf("%-10s %10.4f %10.4f %10.4f\n", "miss20",
+         sample[(int)(nn*0.2)-1], single.Quantile( 0.2 ),
+         merged.Quantile( 0.2 ));
+  printf("%-10s %10.4f %10.4f %10.4f\n", "median",
+         sample[(int)(nn*0.5)-1], single.Quantile( 0.5 ),
+         merged.Quantile( 0.5 ));
+  printf("%-10s %10.4f %10.4f %10.4f\n", "miss70",
+         sample[(int)(nn*0.7)-1], single.Quantile( 0.7 ),
+         merged.Quantile( 0.7 ));
+  printf("%-10s %10.4f %10.4f %10.4f\n", "miss90",
+         sample[(int)(nn*0.9)-1], single.Quantile( 0.9 ),
+         merged.Quantile( 0.9 ));
+  printf("\n");
+  mismatch = CheckSmallSets();
+
+  printf("sketch adds/sec     %10.3e\n", nn / secSketch);
+  printf("sort samples/sec    %10.3e\n", nn / secSort);
+  printf("mean diff / std     %10.1e\n", errMean);
+  printf("std diff / std      %10.1e\n", errStd);
+  printf("small set mismatch  %10d\n", mismatch);
+  printf("\n");
+
+  //
+  // The estimates must be inside the bound the sketch reports, allowing
+  // one rank for the rounding of the target rank.
+  //
+  if ( (errSingle > single.RankError() + 1.0 / nn) ||
+       (errMerged > merged.RankError() + 1.0 / nn) ||
+       (single.Count() != qtySamples) || (merged.Count() != qtySamples) ||
+       (single.Min() != sample[0]) || (single.Max() != sample[qtySamples-1]) ||
+       (merged.Min() != sample[0]) || (merged.Max() != sample[qtySamples-1]) )
+  {
+    printf("FAIL  sketch rank error outside its bound\n\n");
+    exit(1);
+  }
+
+  if ( (errMean > tol) || (errStd > tol) )
+  {
+    printf("FAIL  Welford tolerance %.1e\n\n", tol);
+    exit(1);
+  }
+
+  if ( mismatch > 0 )
+  {
+    printf("FAIL  exact and sketch percentiles of small sets differ\n\n");
+    exit(1);
+  }
+}
+
+void RegressStats::Help()
+{
+  printf("Usage: \n");
+  printf("'regressStats -h'         Returns this usage help. \n");
+  printf("'regressStats'            Runs the regression, 1000000 samples. \n");
+  printf("'regressStats samples'    Runs the regression with the given samples. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressStats.hpp
+//
+// Overview:
+//  Regression of the streaming run set statistics, QuantileSketch and
+//  Welford, against exact statistics of a stored and sorted sample.  A
+//  miss like sample with a flyer tail is streamed into one sketch and, in
+//  parts, into separate sketches that are then merged.  Every percentile
+//  estimate must fall within the sketch's own rank error bound, and the
+//  Welford mean and deviation must match the two pass values.  Small sets
+//  held whole by the sketch must give the exact sorted percentiles.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REGRESSSTATS_HPP
+#define REGRESSSTATS_HPP
+
+#include "RunStats.hpp"
+
+class RegressStats
+{
+public:
+
+  RegressStats()
+  {}
+
+  ~RegressStats()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  double CheckRanks( const QuantileSketch &sketch,
+                     const vector<double> &sorted );
+
+  int CheckSmallSets();
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
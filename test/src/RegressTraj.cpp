@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressTraj.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressTraj.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "MathUtils.hpp"
+#include "TrajSet.hpp"
+
+//
+// Runs are 200 to 299 rows long, so the late output times have fewer runs
+//
+int RegressTraj::RunRows( int run )
+{
+  return 200 + ( run * 37 ) % 100;
+}
+
+double RegressTraj::Value( int run, int row )
+{
+  return 100.0 * sin( 0.7 * run + 0.05 * row ) + run;
+}
+
+//
+// Write the runs in reverse order, each ending on an off grid row the way
+// the sim's final output does
+//
+bool RegressTraj::WriteSet( const char *filename, TrajFile::OutFormat format )
+{
+  int      row;
+  int      run;
+  int      rows;
+  TrajSet  set;
+  TrajFile traj;
+
+  if ( !set.Open( filename, format ) )
+  {
+    return false;
+  }
+
+  for ( run = qtyRuns; run > 0; --run )
+  {
+    rows = RunRows( run );
+
+    traj.Open( set, run );
+
+    traj.Header( "simTime", "sec" );
+    traj.Header( "seed", "na", TRAJ_INTEGER );
+    traj.Header( "val", "m" );
+    traj.EndRow();
+
+    for ( row = 0; row < rows; ++row )
+    {
+      if ( row == rows - 1 )
+      {
+        traj.Value( 0.01 * ( row - 1 ) + 0.0037 );
+      }
+      else
+      {
+        traj.Value( 0.01 * row );
+      }
+
+      traj.Value( run );
+      traj.Value( Value( run, row ) );
+      traj.EndRow();
+    }
+
+    traj.Close();
+  }
+
+  set.Close();
+
+  return true;
+}
+
+void RegressTraj::Execute(int argc, char *argv[])
+{
+  bool                         fail(false);
+  int                          bin;
+  int                          fmt;
+  int                          qtyBins;
+  int                          qtyThreads;
+  int                          row;
+  int                          run;
+  int                          runIdx;
+  long                         count;
+  double                       errSpan;
+  double                       errMean;
+  double                       errStd;
+  double                       errThreads;
+  double                       mean;
+  double                       secOne;
+  double                       secMany;
+  double                       stdDev;
+  double                       time0;
+  double                       timeStep;
+  double                       tol;
+  const char                  *filename = "regressTraj.trs";
+  TrajReader                   reader;
+  vector<int>                  chans( 1, 2 );
+  vector<TrajReader::Envelope> envOne;
+  vector<TrajReader::Envelope> envMany;
+
+  TrajFile::OutFormat formats[2] = { TrajFile::BIN64_FMT, TrajFile::BIN32_FMT };
+  const char         *names[2]   = { "float64", "float32" };
+
+  std::chrono::steady_clock::time_point start;
+
+  qtyRuns    = 64;
+  qtyThreads = std::max( 4u, std::thread::hardware_concurrency() );
+
+  if ( argc == 2 )
+  {
+    if ( strcmp("-h", argv[1]) == 0 )
+    {
+      Help();
+      return;
+    }
+
+    qtyRuns = atoi( argv[1] );
+  }
+  else if ( argc > 2 )
+  {
+    Help();
+    return;
+  }
+
+  printf("\n");
+  printf("Run set reader regression, %d runs, %d threads\n\n", qtyRuns,
+         qtyThreads);
+  printf("%-8s %10s %10s %10s %10s %10s %10s\n", "format", "span err",
+         "mean err", "std err", "thread err", "1 thr sec", "n thr sec");
+
+  for ( fmt = 0; fmt < 2; ++fmt )
+  {
+    if ( !WriteSet( filename, formats[fmt] ) || !reader.Open( filename ) )
+    {
+      printf("FAIL  cannot write and map %s\n\n", filename);
+      exit(1);
+    }
+
+    tol = ( formats[fmt] == TrajFile::BIN32_FMT ) ? 1.0e-5 : 1.0e-12;
+
+    //
+    // Spans give back the values written, found by run number
+    //
+    errSpan = 0.0;
+
+    if ( (reader.QtyRuns() != qtyRuns) || (reader.FindRun( 0 ) != -1) ||
+         (reader.FindChannel( "val" ) != 2) )
+    {
+      fail = true;
+    }
+
+    for ( run = 1; run <= qtyRuns; ++run )
+    {
+      runIdx = reader.FindRun( run );
+
+      if ( (runIdx < 0) || (reader.GetRun( runIdx ).rows != RunRows( run )) )
+      {
+        fail = true;
+        continue;
+      }
+
+      TrajReader::ColumnSpan seed = reader.Column( runIdx, 1 );
+      TrajReader::ColumnSpan val  = reader.Column( runIdx, 2 );
+
+      for ( row = 0; row < val.rows; ++row )
+      {
+        errSpan = fmax( errSpan, fabs( val[row] - Value( run, row ) ) / 100.0 );
+
+        if ( seed[row] != run )
+        {
+          fail = true;
+        }
+      }
+    }
+
+    //
+    // Envelopes of one thread and of several against the known values
+    //
+    timeStep = 0.0;
+    start    = std::chrono::steady_clock::now();
+
+    if ( !reader.Envelopes( chans, 0, timeStep, time0, 1, envOne ) )
+    {
+      fail = true;
+    }
+
+    secOne  = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start ).count();
+    start   = std::chrono::steady_clock::now();
+
+    if ( !reader.Envelopes( chans, 0, timeStep, time0, qtyThreads, envMany ) )
+    {
+      fail = true;
+    }
+
+    secMany = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start ).count();
+
+    if ( fail )
+    {
+      break;
+    }
+
+    qtyBins    = 0;
+    errMean    = 0.0;
+    errStd     = 0.0;
+    errThreads = 0.0;
+
+    for ( run = 1; run <= qtyRuns; ++run )
+    {
+      qtyBins = std::max( qtyBins, RunRows( run ) - 1 );
+    }
+
+    if ( (envOne[0].mean.size() != qtyBins) ||
+         (envMany[0].mean.size() != qtyBins) || (time0 != 0.0) ||
+         (fabs( timeStep - 0.01 ) > tol) )
+    {
+      fail = true;
+      break;
+    }
+
+    for ( bin = 0; bin < qtyBins; ++bin )
+    {
+      count  = 0;
+      mean   = 0.0;
+      stdDev = 0.0;
+
+      for ( run = 1; run <= qtyRuns; ++run )
+      {
+        if ( bin < RunRows( run ) - 1 )
+        {
+          mean += Value( run, bin );
+          ++count;
+        }
+      }
+      mean /= count;
+
+      for ( run = 1; run <= qtyRuns; ++run )
+      {
+        if ( bin < RunRows( run ) - 1 )
+        {
+          stdDev += SQ( Value( run, bin ) - mean );
+        }
+      }
+      stdDev = ( count > 1 ) ? sqrt( stdDev / ( count - 1 ) ) : 0.0;
+
+      if ( (envOne[0].count[bin] != count) ||
+           (envMany[0].count[bin] != count) )
+      {
+        fail = true;
+      }
+
+      errMean    = fmax( errMean, fabs( envOne[0].mean[bin] - mean ) / 100.0 );
+      errStd     = fmax( errStd, fabs( envOne[0].stdDev[bin] - stdDev ) /
+                                 100.0 );
+      errThreads = fmax( errThreads,
+                         fmax( fabs( envMany[0].mean[bin] -
+                                     envOne[0].mean[bin] ),
+                               fabs( envMany[0].stdDev[bin] -
+                                     envOne[0].stdDev[bin] ) ) / 100.0 );
+    }
+
+    printf("%-8s %10.1e %10.1e %10.1e %10.1e %10.4f %10.4f\n",
+           names[fmt], errSpan, errMean, errStd,
+           errThreads, secOne, secMany);
+
+    if ( (errSpan > tol) || (errMean > tol) || (errStd > tol) ||
+         (errThreads > 1.0e-12) )
+    {
+      fail = true;
+      break;
+    }
+
+    reader.Close();
+  }
+
+  reader.Close();
+  remove( filename );
+
+  printf("\n");
+
+  if ( fail )
+  {
+    printf("FAIL  run set reader\n\n");
+    exit(1);
+  }
+}
+
+void RegressTraj::Help()
+{
+  printf("Usage: \n");
+  printf("'regressTraj -h'          Returns this usage help. \n");
+  printf("'regressTraj'             Runs the regression, 64 runs. \n");
+  printf("'regressTraj runs'        Runs the regression with the given runs. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// RegressTraj.hpp
+//
+// Overview:
+//  Regression of the memory mapped run set reader, TrajReader.  A run set
+//  of known trajectories of uneven lengths is written through TrajFile
+//  into a TrajSet container, float64 and float32, then mapped.  Every
+//  column span must give back the values written, and the envelopes of
+//  one thread and of several must match the mean and deviation taken
+//  directly from the known values.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REGRESSTRAJ_HPP
+#define REGRESSTRAJ_HPP
+
+#include "TrajFile.hpp"
+#include "TrajReader.hpp"
+
+class RegressTraj
+{
+public:
+
+  RegressTraj()
+  {}
+
+  ~RegressTraj()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  bool WriteSet( const char *filename, TrajFile::OutFormat format );
+
+  int RunRows( int run );
+
+  double Value( int run, int row );
+
+  int qtyRuns;
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
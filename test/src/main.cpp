@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// main.cpp
+//
+// Overview:
+//  Entry point for the integrator benchmark.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BenchInteg.hpp"
+
+int main(int argc, char *argv[])
+{
+  BenchInteg bench;
+
+  bench.Execute(argc, argv);
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
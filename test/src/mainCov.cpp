@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// mainCov.cpp
+//
+// Overview:
+//  Entry point for the MSC covariance regression.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressCov.hpp"
+
+int main(int argc, char *argv[])
+{
+  RegressCov regress;
+
+  regress.Execute(argc, argv);
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
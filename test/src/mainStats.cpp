@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// mainStats.cpp
+//
+// Overview:
+//  Entry point for the run set statistics regression.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressStats.hpp"
+
+int main(int argc, char *argv[])
+{
+  RegressStats regress;
+
+  regress.Execute(argc, argv);
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
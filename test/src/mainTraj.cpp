@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// mainTraj.cpp
+//
+// Overview:
+//  Entry point for the run set reader regression.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "RegressTraj.hpp"
+
+int main(int argc, char *argv[])
+{
+  RegressTraj regress;
+
+  regress.Execute(argc, argv);
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
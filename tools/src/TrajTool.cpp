@@ -0,0 +1,551 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// TrajTool.cpp
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TrajTool.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <thread>
+
+//
+// Read little endian values, swapping on big endian hosts
+//
+bool TrajTool::GetBytes( void *pData, size_t qtyBytes, size_t elemBytes_ )
+{
+  size_t         idx;
+  unsigned char *pByte = static_cast<unsigned char *>( pData );
+
+  if ( fread( pData, 1, qtyBytes, pIn ) != qtyBytes )
+  {
+    return false;
+  }
+
+  if ( !TrajFile::HostLittleEndian() )
+  {
+    for ( idx = 0; idx < qtyBytes; idx += elemBytes_ )
+    {
+      for ( size_t lo = idx, hi = idx + elemBytes_ - 1; lo < hi; ++lo, --hi )
+      {
+        unsigned char temp = pByte[lo];
+        pByte[lo] = pByte[hi];
+        pByte[hi] = temp;
+      }
+    }
+  }
+
+  return true;
+}
+
+//
+// Read the file header and channel table
+//
+bool TrajTool::ReadHeader()
+{
+  char     magic[8];
+  uint32_t qtyChannels;
+  uint32_t version;
+
+  if ( (fread( magic, 1, sizeof(magic), pIn ) != sizeof(magic)) ||
+       (memcmp( magic, TRAJ_MAGIC, sizeof(magic) ) != 0) )
+  {
+    return false;
+  }
+
+  if ( !GetBytes( &version, 4, 4 ) || (version != TRAJ_VERSION) ||
+       !GetBytes( &qtyChannels, 4, 4 ) ||
+       !GetBytes( &elemBytes, 4, 4 ) ||
+       !GetBytes( &blockRows, 4, 4 ) )
+  {
+    return false;
+  }
+
+  if ( (elemBytes != 4) && (elemBytes != 8) )
+  {
+    return false;
+  }
+
+  return ReadChannels( qtyChannels );
+}
+
+//
+// Read a channel table
+//
+bool TrajTool::ReadChannels( uint32_t qtyChannels )
+{
+  char     text[256];
+  uint8_t  len;
+  TrajFile::Channel chan;
+
+  channels.clear();
+
+  for ( uint32_t idx = 0; idx < qtyChannels; ++idx )
+  {
+    if ( !GetBytes( &chan.flags, 1, 1 ) || !GetBytes( &len, 1, 1 ) ||
+         (fread( text, 1, len, pIn ) != len) )
+    {
+      return false;
+    }
+    chan.name.assign( text, len );
+
+    if ( !GetBytes( &len, 1, 1 ) || (fread( text, 1, len, pIn ) != len) )
+    {
+      return false;
+    }
+    chan.units.assign( text, len );
+
+    channels.push_back( chan );
+  }
+
+  return true;
+}
+
+//
+// Read the next column block into block, channel major with blockRows rows
+// per channel.  Returns the rows read, 0 at the end of the file.
+//
+int TrajTool::ReadBlock( vector<double> &block )
+{
+  uint32_t        rows;
+  uint32_t        row;
+  vector<float>   col32;
+  vector<int32_t> colInt;
+
+  if ( !GetBytes( &rows, 4, 4 ) || (rows == 0) || (rows > blockRows) )
+  {
+    return 0;
+  }
+
+  block.resize( channels.size() * blockRows );
+  col32.resize( rows );
+  colInt.resize( rows );
+
+  for ( size_t chan = 0; chan < channels.size(); ++chan )
+  {
+    double *pCol = &block[chan * blockRows];
+
+    if ( channels[chan].flags & TRAJ_INTEGER )
+    {
+      if ( !GetBytes( &colInt[0], rows * 4, 4 ) )
+      {
+        return 0;
+      }
+
+      for ( row = 0; row < rows; ++row )
+      {
+        pCol[row] = colInt[row];
+      }
+    }
+    else if ( elemBytes == 4 )
+    {
+      if ( !GetBytes( &col32[0], rows * 4, 4 ) )
+      {
+        return 0;
+      }
+
+      for ( row = 0; row < rows; ++row )
+      {
+        pCol[row] = col32[row];
+      }
+    }
+    else if ( !GetBytes( pCol, rows * 8, 8 ) )
+    {
+      return 0;
+    }
+  }
+
+  return rows;
+}
+
+//
+// Print the channel table
+//
+void TrajTool::List( const char *filename )
+{
+  int            rows;
+  long           qtyRows(0);
+  vector<double> block;
+
+  while ( (rows = ReadBlock( block )) > 0 )
+  {
+    qtyRows += rows;
+  }
+
+  printf("%s: %d channels, %ld rows, float%d\n\n", filename,
+         static_cast<int>( channels.size() ), qtyRows, elemBytes * 8);
+  printf("%-24s %-14s %s\n", "channel", "units", "type");
+
+  for ( size_t chan = 0; chan < channels.size(); ++chan )
+  {
+    printf("%-24s %-14s %s\n", channels[chan].name.c_str(),
+           channels[chan].units.c_str(),
+           (channels[chan].flags & TRAJ_INTEGER) ? "int32" : "real");
+  }
+}
+
+//
+// Print the channel table and the run index of a run set
+//
+void TrajTool::ListSet( const char *filename )
+{
+  printf("%s: run set, %d runs, %d channels, float%d\n\n", filename,
+         set.QtyRuns(), set.QtyChannels(), set.ElemBytes() * 8);
+  printf("%-24s %-14s %s\n", "channel", "units", "type");
+
+  for ( int chan = 0; chan < set.QtyChannels(); ++chan )
+  {
+    const TrajFile::Channel &info = set.GetChannel( chan );
+
+    printf("%-24s %-14s %s\n", info.name.c_str(), info.units.c_str(),
+           (info.flags & TRAJ_INTEGER) ? "int32" : "real");
+  }
+
+  printf("\n%10s %10s %14s %14s\n", "run", "rows", "offset", "bytes");
+
+  for ( int idx = 0; idx < set.QtyRuns(); ++idx )
+  {
+    const TrajSet::RunEntry &entry = set.GetRun( idx );
+
+    printf("%10d %10u %14llu %14llu\n", entry.run, entry.rows,
+           static_cast<unsigned long long>( entry.offset ),
+           static_cast<unsigned long long>( entry.bytes ));
+  }
+}
+
+//
+// Write the header line of the text table
+//
+void TrajTool::PrintTitles( FILE *pOut )
+{
+  for ( size_t chan = 0; chan < channels.size(); ++chan )
+  {
+    fprintf( pOut, "%20s", channels[chan].name.c_str() );
+  }
+  fprintf( pOut, "\n" );
+}
+
+//
+// Write the legacy text table, the same as ex.outputFormat=text writes
+//
+void TrajTool::ToText( FILE *pOut )
+{
+  int            rows;
+  vector<double> block;
+
+  PrintTitles( pOut );
+
+  while ( (rows = ReadBlock( block )) > 0 )
+  {
+    for ( int row = 0; row < rows; ++row )
+    {
+      for ( size_t chan = 0; chan < channels.size(); ++chan )
+      {
+        if ( channels[chan].flags & TRAJ_INTEGER )
+        {
+          fprintf( pOut, "%20d",
+                   static_cast<int>( block[chan * blockRows + row] ) );
+        }
+        else
+        {
+          fprintf( pOut, "%20.6e", block[chan * blockRows + row] );
+        }
+      }
+      fprintf( pOut, "\n" );
+    }
+  }
+}
+
+//
+// Write the legacy text table of one run of a run set, read in place
+//
+bool TrajTool::RunToText( int run, FILE *pOut )
+{
+  int                            chan;
+  int                            runIdx;
+  uint32_t                       row;
+  vector<TrajReader::ColumnSpan> cols;
+
+  runIdx = set.FindRun( run );
+
+  if ( runIdx < 0 )
+  {
+    return false;
+  }
+
+  for ( chan = 0; chan < set.QtyChannels(); ++chan )
+  {
+    cols.push_back( set.Column( runIdx, chan ) );
+
+    fprintf( pOut, "%20s", set.GetChannel( chan ).name.c_str() );
+  }
+  fprintf( pOut, "\n" );
+
+  for ( row = 0; row < set.GetRun( runIdx ).rows; ++row )
+  {
+    for ( chan = 0; chan < cols.size(); ++chan )
+    {
+      if ( cols[chan].type == TrajReader::I32_COL )
+      {
+        fprintf( pOut, "%20d", static_cast<int>( cols[chan][row] ) );
+      }
+      else
+      {
+        fprintf( pOut, "%20.6e", cols[chan][row] );
+      }
+    }
+    fprintf( pOut, "\n" );
+  }
+
+  return true;
+}
+
+//
+// Write the mean and standard deviation across the runs of the channels
+// matching the comma separated patterns, at each output time
+//
+bool TrajTool::EnvelopeToText( const char *patterns, FILE *pOut )
+{
+  int                          bin;
+  int                          chan;
+  int                          qtyThreads;
+  int                          timeChan;
+  double                       time0;
+  double                       timeStep(0.0);
+  string                       list( patterns );
+  string                       pattern;
+  size_t                       start;
+  size_t                       end;
+  vector<int>                  chans;
+  vector<TrajReader::Envelope> envs;
+
+  for ( start = 0; start <= list.size(); start = end + 1 )
+  {
+    end = list.find( ',', start );
+
+    if ( end == string::npos )
+    {
+      end = list.size();
+    }
+
+    pattern = list.substr( start, end - start );
+
+    for ( chan = 0; chan < set.QtyChannels(); ++chan )
+    {
+      if ( TrajFile::GlobMatch( pattern.c_str(),
+                                set.GetChannel( chan ).name.c_str() ) &&
+           (std::find( chans.begin(), chans.end(), chan ) == chans.end()) )
+      {
+        chans.push_back( chan );
+      }
+    }
+  }
+
+  timeChan   = set.FindChannel( "simTime" );
+  qtyThreads = std::thread::hardware_concurrency();
+
+  if ( chans.empty() ||
+       !set.Envelopes( chans, timeChan, timeStep, time0, qtyThreads, envs ) )
+  {
+    return false;
+  }
+
+  fprintf( pOut, "%20s%20s", "simTime", "count" );
+
+  for ( chan = 0; chan < chans.size(); ++chan )
+  {
+    const string &name = set.GetChannel( chans[chan] ).name;
+
+    fprintf( pOut, "%20s%20s", ( name + ".mean" ).c_str(),
+             ( name + ".std" ).c_str() );
+  }
+  fprintf( pOut, "\n" );
+
+  for ( bin = 0; bin < envs[0].mean.size(); ++bin )
+  {
+    fprintf( pOut, "%20.6e%20ld", time0 + bin * timeStep, envs[0].count[bin] );
+
+    for ( chan = 0; chan < envs.size(); ++chan )
+    {
+      fprintf( pOut, "%20.6e%20.6e", envs[chan].mean[bin],
+               envs[chan].stdDev[bin] );
+    }
+    fprintf( pOut, "\n" );
+  }
+
+  return true;
+}
+
+void TrajTool::Execute(int argc, char *argv[])
+{
+  bool        envelope(false);
+  bool        list(false);
+  const char *inName;
+  const char *outName(NULL);
+  FILE       *pOut(stdout);
+  int         arg(1);
+  int         qtyRest;
+  int         run(0);
+
+  if ( (argc > 1) && (strcmp("-h", argv[1]) == 0) )
+  {
+    Help();
+    return;
+  }
+
+  if ( (argc > 1) && (strcmp("-l", argv[1]) == 0) )
+  {
+    list = true;
+    ++arg;
+  }
+  else if ( (argc > 1) && (strcmp("-e", argv[1]) == 0) )
+  {
+    envelope = true;
+    ++arg;
+  }
+
+  qtyRest = argc - arg - 1;
+
+  if ( (qtyRest < 0) || (qtyRest > 2) || (list && (qtyRest > 0)) ||
+       (envelope && (qtyRest < 1)) )
+  {
+    Help();
+    exit(1);
+  }
+
+  inName = argv[arg];
+
+  //
+  // A run set is mapped.  Anything else must be a trajectory file.
+  //
+  isSet = set.Open( inName );
+
+  if ( !isSet )
+  {
+    pIn = fopen( inName, "rb" );
+
+    if ( (pIn == NULL) || !ReadHeader() )
+    {
+      fprintf( stderr, "trajTool: %s is not a trajectory file or run set\n",
+               inName );
+      exit(1);
+    }
+
+    if ( envelope )
+    {
+      fprintf( stderr, "trajTool: envelopes need a run set\n" );
+      exit(1);
+    }
+  }
+
+  //
+  // A run set takes the run number or channel patterns ahead of the output
+  // file name
+  //
+  if ( !list && isSet )
+  {
+    if ( qtyRest < 1 )
+    {
+      Help();
+      exit(1);
+    }
+
+    run = atoi( argv[arg + 1] );
+
+    if ( qtyRest == 2 )
+    {
+      outName = argv[arg + 2];
+    }
+  }
+  else if ( !list )
+  {
+    if ( qtyRest == 2 )
+    {
+      Help();
+      exit(1);
+    }
+
+    if ( qtyRest == 1 )
+    {
+      outName = argv[arg + 1];
+    }
+  }
+
+  if ( list && isSet )
+  {
+    ListSet( inName );
+  }
+  else if ( list )
+  {
+    List( inName );
+  }
+  else
+  {
+    if ( outName != NULL )
+    {
+      pOut = fopen( outName, "w" );
+      if ( pOut == NULL )
+      {
+        fprintf( stderr, "trajTool: cannot create %s\n", outName );
+        exit(1);
+      }
+    }
+
+    if ( !isSet )
+    {
+      ToText( pOut );
+    }
+    else if ( envelope )
+    {
+      if ( !EnvelopeToText( argv[arg + 1], pOut ) )
+      {
+        fprintf( stderr, "trajTool: no envelope of %s in %s\n",
+                 argv[arg + 1], inName );
+        exit(1);
+      }
+    }
+    else if ( !RunToText( run, pOut ) )
+    {
+      fprintf( stderr, "trajTool: run %d is not in %s\n", run, inName );
+      exit(1);
+    }
+
+    if ( outName != NULL )
+    {
+      fclose( pOut );
+    }
+  }
+
+  if ( pIn != NULL )
+  {
+    fclose( pIn );
+  }
+}
+
+void TrajTool::Help()
+{
+  printf("Usage: \n");
+  printf("'trajTool -h'                   Returns this usage help. \n");
+  printf("'trajTool file.trj'             Writes the text table to stdout. \n");
+  printf("'trajTool file.trj out.dat'     Writes the text table to out.dat. \n");
+  printf("'trajTool -l file.trj'          Lists the channels, units and rows. \n");
+  printf("'trajTool set.trs run'          Writes the text table of a run of a \n");
+  printf("                                run set to stdout. \n");
+  printf("'trajTool set.trs run out.dat'  Writes the text table of a run of a \n");
+  printf("                                run set to out.dat. \n");
+  printf("'trajTool -l set.trs'           Lists the channels and runs. \n");
+  printf("'trajTool -e set.trs pat,pat'   Writes the mean and standard \n");
+  printf("                                deviation across the runs of the \n");
+  printf("                                channels matching the patterns at \n");
+  printf("                                each output time to stdout. \n");
+  printf("'trajTool -e set.trs pat out'   The same written to out. \n\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
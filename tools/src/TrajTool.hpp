@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// TrajTool.hpp
+//
+// Overview:
+//  Converter for binary trajectory files written with
+//  ex.outputFormat=bin or bin32, and extractor for the runs of a run set
+//  container written with ex.outputSet=true.  Writes the legacy fixed
+//  width text table that loadDataFile.m and loadMultDat.m read, lists
+//  the channels and runs, or reduces a run set to mean and standard
+//  deviation envelopes with the TrajReader library.
+//
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAJTOOL_HPP
+#define TRAJTOOL_HPP
+
+#include "TrajFile.hpp"
+#include "TrajReader.hpp"
+
+class TrajTool
+{
+public:
+
+  TrajTool() :
+  blockRows(0),
+  elemBytes(0),
+  isSet(false),
+  pIn(NULL)
+  {}
+
+  ~TrajTool()
+  {}
+
+  void Execute(int argc, char *argv[]);
+
+  void Help();
+
+private:
+
+  bool ReadHeader();
+
+  bool ReadChannels( uint32_t qtyChannels );
+
+  int  ReadBlock( vector<double> &block );
+
+  bool GetBytes( void *pData, size_t qtyBytes, size_t elemBytes_ );
+
+  void List( const char *filename );
+
+  void ListSet( const char *filename );
+
+  void PrintTitles( FILE *pOut );
+
+  void ToText( FILE *pOut );
+
+  bool RunToText( int run, FILE *pOut );
+
+  bool EnvelopeToText( const char *patterns, FILE *pOut );
+
+  uint32_t                   blockRows;  // na  Rows in a full block
+  uint32_t                   elemBytes;  // na  Bytes per real value
+  bool                       isSet;      // na  Flag that pIn is a run set
+  FILE                      *pIn;        // na  Binary trajectory file
+  vector<TrajFile::Channel>  channels;   // na  Channel table
+  TrajReader                 set;        // na  Mapped run set
+};
+
+
+#endif
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////